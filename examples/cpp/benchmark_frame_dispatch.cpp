@@ -0,0 +1,60 @@
+#include <pandamodel/model.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <math.h>
+
+namespace {
+
+constexpr int kIterations = 1000000;
+
+// Runs the given call repeatedly and returns the average time per call in nanoseconds.
+template <typename F>
+double benchmark(F&& call) {
+  Eigen::Matrix<double, 7, 1> q = {0, -M_PI_4, 0, -3 * M_PI_4, 0, M_PI_2, M_PI_4};
+  double sink = 0;
+  for (int i = 0; i < kIterations / 10; i++) {
+    sink += call(q)(0, 3);
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    q[0] = 1e-6 * i;
+    sink += call(q)(0, 3);
+  }
+  auto end = std::chrono::steady_clock::now();
+  if (sink == 42.0) {
+    std::cout << sink << std::endl;
+  }
+  return std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+}
+
+void report(const char* name, double runtime, double compile_time) {
+  std::cout << name << ": runtime frame " << runtime << " ns, compile-time frame "
+            << compile_time << " ns, saved " << runtime - compile_time << " ns per call"
+            << std::endl;
+}
+
+}  // anonymous namespace
+
+int main() {
+  const char* path = std::getenv("PANDA_MODEL_PATH");
+  if (path == NULL) {
+    std::cerr << "PANDA_MODEL_PATH not set." << std::endl;
+    return -1;
+  }
+  panda_model::Model model(path);
+  using panda_model::Frame;
+  using Vector7d = Eigen::Matrix<double, 7, 1>;
+
+  report("pose",
+         benchmark([&](const Vector7d& q) { return model.pose(Frame::kEndEffector, q); }),
+         benchmark([&](const Vector7d& q) { return model.pose<Frame::kEndEffector>(q); }));
+  report("bodyJacobian",
+         benchmark([&](const Vector7d& q) { return model.bodyJacobian(Frame::kEndEffector, q); }),
+         benchmark([&](const Vector7d& q) { return model.bodyJacobian<Frame::kEndEffector>(q); }));
+  report("zeroJacobian",
+         benchmark([&](const Vector7d& q) { return model.zeroJacobian(Frame::kEndEffector, q); }),
+         benchmark([&](const Vector7d& q) { return model.zeroJacobian<Frame::kEndEffector>(q); }));
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include <pandamodel/kinematics_batch.h>
+#include <pandamodel/model.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSamples = 1000000;
+
+// Runs the given call once and returns the time per sample in nanoseconds.
+template <typename F>
+double benchmark(F&& call) {
+  auto start = std::chrono::steady_clock::now();
+  call();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / kSamples;
+}
+
+const char* name(panda_model::kinematics::InstructionSet instruction_set) {
+  switch (instruction_set) {
+    case panda_model::kinematics::InstructionSet::kAVX2:
+      return "AVX2";
+    case panda_model::kinematics::InstructionSet::kAVX512:
+      return "AVX-512";
+    default:
+      return "scalar";
+  }
+}
+
+}  // anonymous namespace
+
+int main() {
+  using panda_model::Frame;
+  using panda_model::kinematics::InstructionSet;
+
+  // Compares against the model library if available, the native model otherwise.
+  const char* path = std::getenv("PANDA_MODEL_PATH");
+  panda_model::Model model = path != NULL ? panda_model::Model(path) : panda_model::Model::native();
+
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(-2.8, 2.8);
+  std::vector<double> q(7 * kSamples);
+  for (double& value : q) {
+    value = distribution(generator);
+  }
+  std::vector<double> output(16 * kSamples);
+
+  const double loop = benchmark([&] {
+    for (std::size_t i = 0; i < kSamples; i++) {
+      model.pose(Frame::kEndEffector, q.data() + 7 * i, Defaults::F_T_EE.data(),
+                 Defaults::EE_T_K.data(), output.data() + 16 * i);
+    }
+  });
+  std::cout << (path != NULL ? "library" : "native") << " Model::pose loop: " << loop
+            << " ns per sample" << std::endl;
+
+  for (InstructionSet instruction_set :
+       {InstructionSet::kScalar, InstructionSet::kAVX2, InstructionSet::kAVX512}) {
+    if (!panda_model::kinematics::isSupported(instruction_set)) {
+      std::cout << name(instruction_set) << " kernel: not supported" << std::endl;
+      continue;
+    }
+    const double kernel = benchmark([&] {
+      panda_model::kinematics::poseBatch(Frame::kEndEffector, q.data(), kSamples,
+                                         Defaults::F_T_EE.data(), Defaults::EE_T_K.data(),
+                                         output.data(), instruction_set);
+    });
+    std::cout << name(instruction_set) << " kernel: " << kernel << " ns per sample, "
+              << loop / kernel << "x speedup" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,127 @@
+#include <pandamodel/defaults.h>
+#include <pandamodel/dynamics.h>
+#include <pandamodel/kinematics.h>
+
+#include <unsupported/Eigen/AutoDiff>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSamples = 200000;
+
+// Runs the given call once and returns the time per sample in nanoseconds.
+template <typename F>
+double benchmark(F&& call) {
+  auto start = std::chrono::steady_clock::now();
+  call();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / kSamples;
+}
+
+// Times end effector poses, Jacobians and forward dynamics in the given scalar type and
+// returns the outputs for comparison.
+template <typename Scalar>
+std::vector<Scalar> run(const std::vector<double>& samples, const char* name) {
+  using panda_model::Frame;
+  namespace dynamics = panda_model::dynamics;
+  namespace kinematics = panda_model::kinematics;
+
+  const std::vector<Scalar> q(samples.begin(), samples.end());
+  std::vector<Scalar> F_T_EE(16), EE_T_K(16), I_total(9), F_x_Ctotal(3), gravity_earth(3);
+  Eigen::Map<Eigen::Matrix<Scalar, 4, 4>>(F_T_EE.data()) = Defaults::F_T_EE.cast<Scalar>();
+  Eigen::Map<Eigen::Matrix<Scalar, 4, 4>>(EE_T_K.data()) = Defaults::EE_T_K.cast<Scalar>();
+  Eigen::Map<Eigen::Matrix<Scalar, 3, 3>>(I_total.data()) = Defaults::I_total.cast<Scalar>();
+  Eigen::Map<Eigen::Matrix<Scalar, 3, 1>>(F_x_Ctotal.data()) =
+      Defaults::F_x_Ctotal.cast<Scalar>();
+  gravity_earth[2] = Scalar(-9.81);
+  const Scalar m_total(Defaults::m_total);
+
+  std::vector<Scalar> pose(16 * kSamples), jacobian(42 * kSamples), ddq(7 * kSamples);
+  const double pose_time = benchmark([&] {
+    for (std::size_t i = 0; i < kSamples; i++) {
+      kinematics::pose(Frame::kEndEffector, q.data() + 7 * i, F_T_EE.data(), EE_T_K.data(),
+                       pose.data() + 16 * i);
+    }
+  });
+  const double jacobian_time = benchmark([&] {
+    for (std::size_t i = 0; i < kSamples; i++) {
+      kinematics::zeroJacobian(Frame::kEndEffector, q.data() + 7 * i, F_T_EE.data(),
+                               EE_T_K.data(), jacobian.data() + 42 * i);
+    }
+  });
+  // Joint positions double as velocities and torques, only the throughput matters here.
+  const double dynamics_time = benchmark([&] {
+    for (std::size_t i = 0; i < kSamples; i++) {
+      const Scalar* state = q.data() + 7 * i;
+      dynamics::forwardDynamics(state, state, state, I_total.data(), m_total, F_x_Ctotal.data(),
+                                gravity_earth.data(), ddq.data() + 7 * i);
+    }
+  });
+  std::cout << name << ": pose " << pose_time << " ns, zero Jacobian " << jacobian_time
+            << " ns, forward dynamics " << dynamics_time << " ns per sample" << std::endl;
+
+  std::vector<Scalar> outputs(pose);
+  outputs.insert(outputs.end(), jacobian.begin(), jacobian.end());
+  outputs.insert(outputs.end(), ddq.begin(), ddq.end());
+  return outputs;
+}
+
+}  // anonymous namespace
+
+int main() {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(-2.8, 2.8);
+  std::vector<double> samples(7 * kSamples);
+  for (double& value : samples) {
+    value = distribution(generator);
+  }
+
+  const std::vector<double> reference = run<double>(samples, "double");
+  const std::vector<float> outputs = run<float>(samples, "float");
+  double error = 0.;
+  for (std::size_t i = 0; i < reference.size(); i++) {
+    error = std::max(error, std::abs(reference[i] - outputs[i]) / (1. + std::abs(reference[i])));
+  }
+  std::cout << "float: largest relative deviation from double " << error << std::endl;
+
+  // Exact derivatives of the gravity vector with respect to the joint position.
+  using Dual = Eigen::AutoDiffScalar<Eigen::Matrix<double, 7, 1>>;
+  Dual q[7], gravity_earth[3] = {Dual(0.), Dual(0.), Dual(-9.81)}, F_x_Ctotal[3], gravity[7];
+  for (std::size_t joint = 0; joint < 7; joint++) {
+    q[joint] = Dual(samples[joint], 7, joint);
+  }
+  for (std::size_t axis = 0; axis < 3; axis++) {
+    F_x_Ctotal[axis] = Dual(Defaults::F_x_Ctotal[axis]);
+  }
+  panda_model::dynamics::gravity(q, gravity_earth, Dual(Defaults::m_total), F_x_Ctotal, gravity);
+
+  // Compares against central differences.
+  constexpr double kStep = 1e-6;
+  const double earth[3] = {0., 0., -9.81};
+  double derivative_error = 0.;
+  for (std::size_t joint = 0; joint < 7; joint++) {
+    double q_plus[7], q_minus[7], plus[7], minus[7];
+    std::copy(samples.begin(), samples.begin() + 7, q_plus);
+    std::copy(samples.begin(), samples.begin() + 7, q_minus);
+    q_plus[joint] += kStep;
+    q_minus[joint] -= kStep;
+    panda_model::dynamics::gravity(q_plus, earth, Defaults::m_total, Defaults::F_x_Ctotal.data(),
+                                   plus);
+    panda_model::dynamics::gravity(q_minus, earth, Defaults::m_total,
+                                   Defaults::F_x_Ctotal.data(), minus);
+    for (std::size_t row = 0; row < 7; row++) {
+      const double difference = (plus[row] - minus[row]) / (2. * kStep);
+      derivative_error =
+          std::max(derivative_error, std::abs(difference - gravity[row].derivatives()[joint]));
+    }
+  }
+  std::cout << "AutoDiffScalar: largest deviation of dg/dq from central differences "
+            << derivative_error << std::endl;
+  return 0;
+}
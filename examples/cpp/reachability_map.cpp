@@ -0,0 +1,62 @@
+#include <pandamodel/model.h>
+#include <pandamodel/reachability_map.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+// Generates a reachability and manipulability map of the end effector and writes it to a file.
+//
+// Usage: reachability_map <output> [samples] [resolution] [seed]
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 5) {
+    std::cerr << "Usage: " << argv[0] << " <output> [samples] [resolution] [seed]" << std::endl;
+    return -1;
+  }
+  panda_model::ReachabilityOptions options;
+  try {
+    if (argc > 2) {
+      options.samples = std::stoull(argv[2]);
+    }
+    if (argc > 3) {
+      options.resolution = std::stod(argv[3]);
+    }
+    if (argc > 4) {
+      options.seed = std::stoull(argv[4]);
+    }
+  } catch (const std::exception&) {
+    std::cerr << "Invalid argument." << std::endl;
+    return -1;
+  }
+
+  try {
+    // Uses the model library if available, the native model otherwise.
+    const char* path = std::getenv("PANDA_MODEL_PATH");
+    panda_model::Model model =
+        path != nullptr ? panda_model::Model(path) : panda_model::Model::native();
+
+    auto start = std::chrono::steady_clock::now();
+    panda_model::ReachabilityMap map = panda_model::ReachabilityMap::generate(model, options);
+    auto end = std::chrono::steady_clock::now();
+    map.save(argv[1]);
+
+    std::uint64_t binned = 0;
+    std::size_t reachable = 0;
+    for (std::uint32_t count : map.counts()) {
+      binned += count;
+      reachable += count > 0;
+    }
+    std::cout << "Sampled " << map.samples() << " joint positions in "
+              << std::chrono::duration<double>(end - start).count() << " s, " << binned
+              << " inside the grid" << std::endl;
+    std::cout << reachable << " of " << map.size() << " voxels of " << map.resolution()
+              << " m reachable, written to " << argv[1] << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+  return 0;
+}
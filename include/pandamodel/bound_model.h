@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/model.h"
+
+/**
+ * @file bound_model.h
+ * Contains a Model bound to a fixed end effector and load.
+ */
+
+namespace panda_model {
+
+/**
+ * Model with a bound end effector, stiffness frame and load.
+ *
+ * The parameters are captured once and the composed transformations are precomputed, so
+ * the queries only take the joint state. The end effector and the load can be replaced at
+ * any time, e.g. when the gripper picks up an object. Replacement is atomic: every query
+ * sees either the complete old or the complete new parameters, also when queries run
+ * concurrently on other threads. Queries never wait for a replacement or take a lock, they
+ * only copy the parameters again if a replacement completed while they were copied. The Model
+ * must outlive the BoundModel.
+ */
+class BoundModel {
+ public:
+  /**
+   * Binds the given Model to an end effector and load.
+   *
+   * @param[in] model Model to evaluate.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  explicit BoundModel(const Model& model,
+                      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K,
+                      const Eigen::Matrix3d& I_total = Defaults::I_total,
+                      double m_total = Defaults::m_total,
+                      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+                      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81});
+
+  /**
+   * Atomically replaces the bound end effector and stiffness frame. Concurrent calls of
+   * setPayload() are not lost.
+   *
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   */
+  void setTool(const Eigen::Matrix4d& F_T_EE, const Eigen::Matrix4d& EE_T_K);
+
+  /**
+   * Atomically replaces the bound load. Concurrent calls of setTool() are not lost.
+   *
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void setPayload(const Eigen::Matrix3d& I_total,
+                  double m_total,
+                  const Eigen::Vector3d& F_x_Ctotal);
+
+  /**
+   * Gets the 4x4 pose matrix for the given frame in base frame.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   *
+   * @return 4x4 pose matrix.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix4d pose(Frame frame, const Eigen::Matrix<double, 7, 1>& q) const;
+
+  /**
+   * Gets the 6x7 Jacobian for the given frame, relative to that frame.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   *
+   * @return 6x7 Jacobian.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix<double, 6, 7> bodyJacobian(Frame frame,
+                                           const Eigen::Matrix<double, 7, 1>& q) const;
+
+  /**
+   * Gets the 6x7 Jacobian for the given frame relative to the base frame.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   *
+   * @return 6x7 Jacobian.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix<double, 6, 7> zeroJacobian(Frame frame,
+                                           const Eigen::Matrix<double, 7, 1>& q) const;
+
+  /**
+   * Calculates the 7x7 mass matrix with the bound load. Unit: \f$[kg \times m^2]\f$.
+   *
+   * @param[in] q Joint position.
+   *
+   * @return 7x7 mass matrix.
+   */
+  Eigen::Matrix<double, 7, 7> mass(const Eigen::Matrix<double, 7, 1>& q) const noexcept;
+
+  /**
+   * Calculates the Coriolis force vector with the bound load. Unit: \f$[Nm]\f$.
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   *
+   * @return Coriolis force vector.
+   */
+  Eigen::Matrix<double, 7, 1> coriolis(const Eigen::Matrix<double, 7, 1>& q,
+                                       const Eigen::Matrix<double, 7, 1>& dq) const noexcept;
+
+  /**
+   * Calculates the gravity vector with the bound load. Unit: \f$[Nm]\f$.
+   *
+   * @param[in] q Joint position.
+   *
+   * @return Gravity vector.
+   */
+  Eigen::Matrix<double, 7, 1> gravity(const Eigen::Matrix<double, 7, 1>& q) const noexcept;
+
+  /**
+   * Calculates all quantities of a DynamicsState with the bound parameters,
+   * see Model::computeState.
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[out] state Receives the calculated quantities.
+   */
+  void computeState(const Eigen::Matrix<double, 7, 1>& q,
+                    const Eigen::Matrix<double, 7, 1>& dq,
+                    DynamicsState& state) const noexcept;
+
+ private:
+  struct Parameters;
+
+  // Number of values of the parameters, see Parameters::forEach().
+  static constexpr std::size_t kParameterCount = 64;
+
+  Parameters parameters() const noexcept;
+  void publish(const Parameters& parameters) noexcept;
+
+  const Model& model_;
+  // Serializes setTool() and setPayload().
+  std::mutex update_mutex_;
+  // Incremented twice per replacement, readers copy the parameters selected by its lowest bit
+  // while the other copy is written.
+  std::atomic<std::uint64_t> sequence_{0};
+  std::atomic<double> values_[2][kParameterCount];
+};
+
+}  // namespace panda_model
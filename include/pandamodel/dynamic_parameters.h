@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file dynamic_parameters.h
+ * Contains the inertial parameters of the robot.
+ */
+
+namespace panda_model {
+namespace dynamics {
+
+/**
+ * Inertial parameters of one link, given in the link's frame.
+ */
+struct LinkInertia {
+  /// Mass. Unit: \f$[kg]\f$.
+  double mass;
+  /// Center of mass. Unit: \f$[m]\f$.
+  double com[3];
+  /// Inertia relative to the center of mass as xx, yy, zz, xy, xz, yz.
+  /// Unit: \f$[kg \times m^2]\f$.
+  double inertia[6];
+};
+
+/**
+ * Number of moving links.
+ */
+constexpr std::size_t kJointCount = 7;
+
+/**
+ * Identified inertial parameters of the links moved by joint 1 to 7, without end effector.
+ *
+ * Physically feasible parameters from C. Gaz, M. Cognetti, A. Oliva, P. Robuffo Giordano and
+ * A. De Luca, "Dynamic Identification of the Franka Emika Panda Robot With Retrieval of Feasible
+ * Parameters Using Penalty-Based Optimization", IEEE RA-L, 2019.
+ */
+constexpr LinkInertia kLinkInertias[kJointCount] = {
+    {4.970684,
+     {3.875e-03, 2.081e-03, -4.762e-02},
+     {7.0337e-01, 7.0661e-01, 9.1170e-03, -1.3900e-04, 6.7720e-03, 1.9169e-02}},
+    {0.646926,
+     {-3.141e-03, -2.872e-02, 3.495e-03},
+     {7.9620e-03, 2.8110e-02, 2.5995e-02, -3.9250e-03, 1.0254e-02, 7.0400e-04}},
+    {3.228604,
+     {2.7518e-02, 3.9252e-02, -6.6502e-02},
+     {3.7242e-02, 3.6155e-02, 1.0830e-02, -4.7610e-03, -1.1396e-02, -1.2805e-02}},
+    {3.587895,
+     {-5.317e-02, 1.04419e-01, 2.7454e-02},
+     {2.5853e-02, 1.9552e-02, 2.8323e-02, 7.7960e-03, -1.3320e-03, 8.6410e-03}},
+    {1.225946,
+     {-1.1953e-02, 4.1065e-02, -3.8437e-02},
+     {3.5549e-02, 2.9474e-02, 8.6270e-03, -2.1170e-03, -4.0370e-03, 2.2900e-04}},
+    {1.666555,
+     {6.0149e-02, -1.4117e-02, -1.0517e-02},
+     {1.9640e-03, 4.3540e-03, 5.4330e-03, 1.0900e-04, -1.1580e-03, 3.4100e-04}},
+    {7.35522e-01,
+     {1.0517e-02, -4.252e-03, 6.1597e-02},
+     {1.2516e-02, 1.0027e-02, 4.8150e-03, -4.2800e-04, -1.1960e-03, -7.4100e-04}},
+};
+
+}  // namespace dynamics
+}  // namespace panda_model
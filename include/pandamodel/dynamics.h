@@ -0,0 +1,538 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "pandamodel/dynamic_parameters.h"
+#include "pandamodel/kinematics.h"
+
+/**
+ * @file dynamics.h
+ * Contains a header-only implementation of the robot's rigid body dynamics.
+ *
+ * The functions are templates over the scalar type, e.g. float, double or
+ * Eigen::AutoDiffScalar, which is deduced from the joint position.
+ */
+
+namespace panda_model {
+namespace dynamics {
+
+using kinematics::Matrix3;
+using kinematics::Vector3;
+
+/**
+ * Inertial properties of one rigid body in the frame of its link.
+ */
+template <typename Scalar>
+struct RigidBody {
+  /// Mass. Unit: \f$[kg]\f$.
+  Scalar mass;
+  /// Center of mass. Unit: \f$[m]\f$.
+  Vector3<Scalar> com;
+  /// Inertia relative to the center of mass. Unit: \f$[kg \times m^2]\f$.
+  Matrix3<Scalar> inertia;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * Gets the bodies moved by the joints, with the attached total load lumped into the last link.
+ *
+ * @param[in] I_total Inertia of the attached total load including end effector, relative to
+ * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+ * @param[in] m_total Weight of the attached total load including end effector.
+ * Unit: \f$[kg]\f$.
+ * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+ * 3 elements. Unit: \f$[m]\f$.
+ * @param[out] bodies Receives kJointCount bodies.
+ */
+template <typename Scalar>
+inline void rigidBodies(
+    const Scalar* I_total,
+    Scalar m_total,
+    const Scalar* F_x_Ctotal,
+    RigidBody<Scalar>* bodies) noexcept {
+  for (std::size_t joint = 0; joint < kJointCount; joint++) {
+    const LinkInertia& link = kLinkInertias[joint];
+    RigidBody<Scalar>& body = bodies[joint];
+    body.mass = Scalar(link.mass);
+    body.com = Eigen::Map<const Eigen::Vector3d>(link.com).cast<Scalar>();
+    body.inertia << Scalar(link.inertia[0]), Scalar(link.inertia[3]), Scalar(link.inertia[4]),
+                    Scalar(link.inertia[3]), Scalar(link.inertia[1]), Scalar(link.inertia[5]),
+                    Scalar(link.inertia[4]), Scalar(link.inertia[5]), Scalar(link.inertia[2]);
+  }
+
+  // The flange frame only differs from the last link's frame by a translation along z.
+  RigidBody<Scalar>& last = bodies[kJointCount - 1];
+  const Vector3<Scalar> load_com =
+      Eigen::Map<const Vector3<Scalar>>(F_x_Ctotal) +
+      Vector3<Scalar>(Scalar(0.), Scalar(0.), Scalar(kinematics::kLinks[kJointCount].d));
+  const Scalar mass = last.mass + m_total;
+  const Vector3<Scalar> com = (last.mass * last.com + m_total * load_com) / mass;
+  const auto steiner = [&com](const Scalar& body_mass,
+                              const Vector3<Scalar>& body_com) -> Matrix3<Scalar> {
+    const Vector3<Scalar> offset = body_com - com;
+    return body_mass * (offset.squaredNorm() * Matrix3<Scalar>::Identity() -
+                        offset * offset.transpose());
+  };
+  last.inertia += steiner(last.mass, last.com) +
+                  Eigen::Map<const Matrix3<Scalar>>(I_total) + steiner(m_total, load_com);
+  last.mass = mass;
+  last.com = com;
+}
+
+/**
+ * Calculates joint torques with the recursive Newton-Euler algorithm in \f$O(n)\f$:
+ * \f$\tau = M(q) \ddot{q} + C(q, \dot{q}) \dot{q} + g(q)\f$.
+ *
+ * @param[in] bodies Bodies moved by the joints, see rigidBodies().
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] ddq Joint acceleration, 7 elements.
+ * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+ * @param[out] tau Joint torques, 7 elements. Unit: \f$[Nm]\f$.
+ */
+template <typename Scalar>
+inline void inverseDynamics(
+    const RigidBody<Scalar>* bodies,
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* ddq,
+    const Scalar* gravity_earth,
+    Scalar* tau) noexcept {
+  Matrix3<Scalar> R[kJointCount];
+  Vector3<Scalar> p[kJointCount];
+  Vector3<Scalar> force[kJointCount];
+  Vector3<Scalar> torque[kJointCount];
+
+  // Forward pass: velocities and accelerations of the links in their own frames.
+  Vector3<Scalar> omega = Vector3<Scalar>::Zero();
+  Vector3<Scalar> omega_dot = Vector3<Scalar>::Zero();
+  Vector3<Scalar> acceleration = -Eigen::Map<const Vector3<Scalar>>(gravity_earth);
+  kinematics::Matrix4<Scalar> T;
+  for (std::size_t joint = 0; joint < kJointCount; joint++) {
+    kinematics::detail::linkTransform(kinematics::kLinks[joint], q[joint], T);
+    R[joint] = T.template topLeftCorner<3, 3>();
+    p[joint] = T.template block<3, 1>(0, 3);
+    const Matrix3<Scalar> R_T = R[joint].transpose();
+    const Vector3<Scalar> z = Vector3<Scalar>::UnitZ();
+
+    acceleration =
+        R_T * (omega_dot.cross(p[joint]) + omega.cross(omega.cross(p[joint])) + acceleration);
+    const Vector3<Scalar> omega_parent = R_T * omega;
+    omega = omega_parent + dq[joint] * z;
+    omega_dot = R_T * omega_dot + omega_parent.cross(dq[joint] * z) + ddq[joint] * z;
+
+    const RigidBody<Scalar>& body = bodies[joint];
+    const Vector3<Scalar> com_acceleration =
+        omega_dot.cross(body.com) + omega.cross(omega.cross(body.com)) + acceleration;
+    force[joint] = body.mass * com_acceleration;
+    torque[joint] = body.inertia * omega_dot + omega.cross(body.inertia * omega);
+  }
+
+  // Backward pass: forces and torques exerted on each link by its parent.
+  Vector3<Scalar> f = Vector3<Scalar>::Zero();
+  Vector3<Scalar> n = Vector3<Scalar>::Zero();
+  for (std::size_t joint = kJointCount; joint-- > 0;) {
+    Vector3<Scalar> child_force = Vector3<Scalar>::Zero();
+    Vector3<Scalar> child_torque = Vector3<Scalar>::Zero();
+    if (joint + 1 < kJointCount) {
+      child_force = R[joint + 1] * f;
+      child_torque = R[joint + 1] * n + p[joint + 1].cross(child_force);
+    }
+    f = force[joint] + child_force;
+    n = torque[joint] + bodies[joint].com.cross(force[joint]) + child_torque;
+    tau[joint] = n.z();
+  }
+}
+
+/**
+ * Calculates joint torques with the recursive Newton-Euler algorithm, see
+ * inverseDynamics(const RigidBody<Scalar>*, const Scalar*, const Scalar*, const Scalar*,
+ * const Scalar*, Scalar*).
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] ddq Joint acceleration, 7 elements.
+ * @param[in] I_total Inertia of the attached total load including end effector, relative to
+ * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+ * @param[in] m_total Weight of the attached total load including end effector.
+ * Unit: \f$[kg]\f$.
+ * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+ * 3 elements. Unit: \f$[m]\f$.
+ * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+ * @param[out] tau Joint torques, 7 elements. Unit: \f$[Nm]\f$.
+ */
+template <typename Scalar>
+inline void inverseDynamics(
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* ddq,
+    const Scalar* I_total,
+    Scalar m_total,
+    const Scalar* F_x_Ctotal,
+    const Scalar* gravity_earth,
+    Scalar* tau) noexcept {
+  RigidBody<Scalar> bodies[kJointCount];
+  rigidBodies(I_total, m_total, F_x_Ctotal, bodies);
+  inverseDynamics(bodies, q, dq, ddq, gravity_earth, tau);
+}
+
+namespace detail {
+
+template <typename Scalar>
+using Matrix6 = Eigen::Matrix<Scalar, 6, 6>;
+template <typename Scalar>
+using Vector6 = Eigen::Matrix<Scalar, 6, 1>;
+
+template <typename Scalar>
+inline Matrix3<Scalar> skew(const Vector3<Scalar>& vector) noexcept {
+  Matrix3<Scalar> matrix;
+  const Scalar zero(0.);
+  matrix << zero, -vector.z(), vector.y(),
+            vector.z(), zero, -vector.x(),
+            -vector.y(), vector.x(), zero;
+  return matrix;
+}
+
+// Spatial cross product for motion vectors [angular; linear].
+template <typename Scalar>
+inline Vector6<Scalar> crossMotion(const Vector6<Scalar>& v, const Vector6<Scalar>& m) noexcept {
+  const Vector3<Scalar> v_angular = v.template head<3>(), v_linear = v.template tail<3>();
+  const Vector3<Scalar> m_angular = m.template head<3>(), m_linear = m.template tail<3>();
+  Vector6<Scalar> result;
+  result.template head<3>() = v_angular.cross(m_angular);
+  result.template tail<3>() = v_angular.cross(m_linear) + v_linear.cross(m_angular);
+  return result;
+}
+
+// Spatial cross product for force vectors [torque; force].
+template <typename Scalar>
+inline Vector6<Scalar> crossForce(const Vector6<Scalar>& v, const Vector6<Scalar>& f) noexcept {
+  const Vector3<Scalar> v_angular = v.template head<3>(), v_linear = v.template tail<3>();
+  const Vector3<Scalar> f_angular = f.template head<3>(), f_linear = f.template tail<3>();
+  Vector6<Scalar> result;
+  result.template head<3>() = v_angular.cross(f_angular) + v_linear.cross(f_linear);
+  result.template tail<3>() = v_angular.cross(f_linear);
+  return result;
+}
+
+// Spatial inertia of the body relative to the origin of its link frame.
+template <typename Scalar>
+inline Matrix6<Scalar> spatialInertia(const RigidBody<Scalar>& body) noexcept {
+  const Matrix3<Scalar> C = skew(body.com);
+  Matrix6<Scalar> inertia;
+  inertia.template topLeftCorner<3, 3>() = body.inertia + body.mass * C * C.transpose();
+  inertia.template topRightCorner<3, 3>() = body.mass * C;
+  inertia.template bottomLeftCorner<3, 3>() = body.mass * C.transpose();
+  inertia.template bottomRightCorner<3, 3>() = body.mass * Matrix3<Scalar>::Identity();
+  return inertia;
+}
+
+// Spatial motion transform from the parent link's frame to the link's frame.
+template <typename Scalar>
+inline Matrix6<Scalar> motionTransform(const Matrix3<Scalar>& R,
+                                       const Vector3<Scalar>& p) noexcept {
+  const Matrix3<Scalar> E = R.transpose();
+  Matrix6<Scalar> X;
+  X.template topLeftCorner<3, 3>() = E;
+  X.template topRightCorner<3, 3>().setZero();
+  X.template bottomLeftCorner<3, 3>() = -E * skew(p);
+  X.template bottomRightCorner<3, 3>() = E;
+  return X;
+}
+
+}  // namespace detail
+
+/**
+ * Calculates joint accelerations with the articulated-body algorithm in \f$O(n)\f$:
+ * \f$\ddot{q} = M(q)^{-1} (\tau - C(q, \dot{q}) \dot{q} - g(q))\f$, without building or
+ * inverting the mass matrix.
+ *
+ * @param[in] bodies Bodies moved by the joints, see rigidBodies().
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] tau Joint torques, 7 elements. Unit: \f$[Nm]\f$.
+ * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+ * @param[out] ddq Joint acceleration, 7 elements.
+ */
+template <typename Scalar>
+inline void forwardDynamics(
+    const RigidBody<Scalar>* bodies,
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* tau,
+    const Scalar* gravity_earth,
+    Scalar* ddq) noexcept {
+  using Matrix6 = detail::Matrix6<Scalar>;
+  using Vector6 = detail::Vector6<Scalar>;
+  // Every joint rotates about the z axis of its link, the third spatial coordinate.
+  constexpr int kAxis = 2;
+
+  Matrix6 X[kJointCount];
+  Vector6 velocity_product[kJointCount];
+  Matrix6 articulated_inertia[kJointCount];
+  Vector6 bias_force[kJointCount];
+
+  // Velocities and velocity-product terms from base to tip.
+  Vector6 velocity = Vector6::Zero();
+  kinematics::Matrix4<Scalar> T;
+  for (std::size_t joint = 0; joint < kJointCount; joint++) {
+    kinematics::detail::linkTransform(kinematics::kLinks[joint], q[joint], T);
+    X[joint] = detail::motionTransform<Scalar>(T.template topLeftCorner<3, 3>(),
+                                               T.template block<3, 1>(0, 3));
+    Vector6 joint_velocity = Vector6::Zero();
+    joint_velocity[kAxis] = dq[joint];
+    velocity = X[joint] * velocity + joint_velocity;
+    velocity_product[joint] = detail::crossMotion(velocity, joint_velocity);
+    articulated_inertia[joint] = detail::spatialInertia(bodies[joint]);
+    bias_force[joint] = detail::crossForce<Scalar>(velocity, articulated_inertia[joint] * velocity);
+  }
+
+  // Articulated-body inertias and bias forces from tip to base.
+  Vector6 U[kJointCount];
+  Scalar D[kJointCount];
+  Scalar u[kJointCount];
+  for (std::size_t joint = kJointCount; joint-- > 0;) {
+    U[joint] = articulated_inertia[joint].col(kAxis);
+    D[joint] = U[joint][kAxis];
+    u[joint] = tau[joint] - bias_force[joint][kAxis];
+    if (joint > 0) {
+      const Matrix6 inertia =
+          articulated_inertia[joint] - U[joint] * U[joint].transpose() / D[joint];
+      const Vector6 force =
+          bias_force[joint] + inertia * velocity_product[joint] + U[joint] * (u[joint] / D[joint]);
+      articulated_inertia[joint - 1].noalias() += X[joint].transpose() * inertia * X[joint];
+      bias_force[joint - 1].noalias() += X[joint].transpose() * force;
+    }
+  }
+
+  // Accelerations from base to tip, gravity enters as acceleration of the base.
+  Vector6 acceleration = Vector6::Zero();
+  acceleration.template tail<3>() = -Eigen::Map<const Vector3<Scalar>>(gravity_earth);
+  for (std::size_t joint = 0; joint < kJointCount; joint++) {
+    acceleration = X[joint] * acceleration + velocity_product[joint];
+    ddq[joint] = (u[joint] - U[joint].dot(acceleration)) / D[joint];
+    acceleration[kAxis] += ddq[joint];
+  }
+}
+
+/**
+ * Calculates joint accelerations with the articulated-body algorithm, see
+ * forwardDynamics(const RigidBody<Scalar>*, const Scalar*, const Scalar*, const Scalar*,
+ * const Scalar*, Scalar*).
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] tau Joint torques, 7 elements. Unit: \f$[Nm]\f$.
+ * @param[in] I_total Inertia of the attached total load including end effector, relative to
+ * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+ * @param[in] m_total Weight of the attached total load including end effector.
+ * Unit: \f$[kg]\f$.
+ * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+ * 3 elements. Unit: \f$[m]\f$.
+ * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+ * @param[out] ddq Joint acceleration, 7 elements.
+ */
+template <typename Scalar>
+inline void forwardDynamics(
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* tau,
+    const Scalar* I_total,
+    Scalar m_total,
+    const Scalar* F_x_Ctotal,
+    const Scalar* gravity_earth,
+    Scalar* ddq) noexcept {
+  RigidBody<Scalar> bodies[kJointCount];
+  rigidBodies(I_total, m_total, F_x_Ctotal, bodies);
+  forwardDynamics(bodies, q, dq, tau, gravity_earth, ddq);
+}
+
+/**
+ * Calculates the 7x7 mass matrix column by column with the recursive Newton-Euler algorithm.
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] I_total Inertia of the attached total load including end effector, relative to
+ * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+ * @param[in] m_total Weight of the attached total load including end effector.
+ * Unit: \f$[kg]\f$.
+ * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+ * 3 elements. Unit: \f$[m]\f$.
+ * @param[out] output Vectorized 7x7 mass matrix, column-major. Must hold 49 elements.
+ */
+template <typename Scalar>
+inline void mass(
+    const Scalar* q,
+    const Scalar* I_total,
+    Scalar m_total,
+    const Scalar* F_x_Ctotal,
+    Scalar* output) noexcept {
+  RigidBody<Scalar> bodies[kJointCount];
+  rigidBodies(I_total, m_total, F_x_Ctotal, bodies);
+  Scalar zero[kJointCount];
+  for (Scalar& value : zero) {
+    value = Scalar(0.);
+  }
+  for (std::size_t column = 0; column < kJointCount; column++) {
+    Scalar ddq[kJointCount];
+    for (std::size_t joint = 0; joint < kJointCount; joint++) {
+      ddq[joint] = Scalar(joint == column ? 1. : 0.);
+    }
+    inverseDynamics(bodies, q, zero, ddq, zero, output + kJointCount * column);
+  }
+}
+
+/**
+ * Calculates the Coriolis force vector with the recursive Newton-Euler algorithm.
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] I_total Inertia of the attached total load including end effector, relative to
+ * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+ * @param[in] m_total Weight of the attached total load including end effector.
+ * Unit: \f$[kg]\f$.
+ * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+ * 3 elements. Unit: \f$[m]\f$.
+ * @param[out] output Coriolis force vector, 7 elements. Unit: \f$[Nm]\f$.
+ */
+template <typename Scalar>
+inline void coriolis(
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* I_total,
+    Scalar m_total,
+    const Scalar* F_x_Ctotal,
+    Scalar* output) noexcept {
+  Scalar zero[kJointCount];
+  for (Scalar& value : zero) {
+    value = Scalar(0.);
+  }
+  inverseDynamics(q, dq, zero, I_total, m_total, F_x_Ctotal, zero, output);
+}
+
+/**
+ * Calculates the 7x7 Coriolis matrix \f$C(q, \dot{q})\f$ in \f$O(n^3)\f$, such that
+ * \f$C(q, \dot{q}) \dot{q}\f$ is the Coriolis force vector and \f$\dot{M} - 2 C\f$ is
+ * skew-symmetric.
+ *
+ * The matrix is accumulated from the bodies' contributions
+ * \f$J_i^T (I_i \dot{J}_i + B_i J_i)\f$ in base coordinates, with the spatial Jacobians
+ * \f$J_i\f$, the spatial inertias \f$I_i\f$ and the factorization
+ * \f$B_i = \frac{1}{2} (v_i \times^* I_i - I_i v_i \times + (I_i v_i) \bar{\times}^*)\f$ of
+ * the velocity product force \f$v_i \times^* I_i v_i\f$, see Niemeyer and Slotine. Every body
+ * projects its forces onto all preceding joint axes, hence the cubic cost.
+ *
+ * @param[in] bodies Bodies moved by the joints, see rigidBodies().
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[out] output Vectorized 7x7 Coriolis matrix, column-major. Must hold 49 elements.
+ */
+template <typename Scalar>
+inline void coriolisMatrix(
+    const RigidBody<Scalar>* bodies,
+    const Scalar* q,
+    const Scalar* dq,
+    Scalar* output) noexcept {
+  using Vector6 = detail::Vector6<Scalar>;
+
+  // Joint axes and their time derivatives as motion vectors in base coordinates.
+  Vector6 S[kJointCount];
+  Vector6 S_dot[kJointCount];
+  Vector6 velocity[kJointCount];
+  detail::Matrix6<Scalar> inertia[kJointCount];
+  kinematics::Matrix4<Scalar> O_T_J = kinematics::Matrix4<Scalar>::Identity();
+  kinematics::Matrix4<Scalar> T;
+  Vector6 parent_velocity = Vector6::Zero();
+  for (std::size_t joint = 0; joint < kJointCount; joint++) {
+    kinematics::detail::linkTransform(kinematics::kLinks[joint], q[joint], T);
+    O_T_J = O_T_J * T;
+    const Matrix3<Scalar> R = O_T_J.template topLeftCorner<3, 3>();
+    const Vector3<Scalar> p = O_T_J.template block<3, 1>(0, 3);
+    const Vector3<Scalar> axis = R.col(2);
+    S[joint] << axis, p.cross(axis);
+    S_dot[joint] = detail::crossMotion(parent_velocity, S[joint]);
+    velocity[joint] = parent_velocity + S[joint] * dq[joint];
+    parent_velocity = velocity[joint];
+
+    const RigidBody<Scalar>& body = bodies[joint];
+    const RigidBody<Scalar> O_body{body.mass, R * body.com + p,
+                                   R * body.inertia * R.transpose()};
+    inertia[joint] = detail::spatialInertia(O_body);
+  }
+
+  Eigen::Map<Eigen::Matrix<Scalar, kJointCount, kJointCount>> C(output);
+  C.setZero();
+  for (std::size_t body = 0; body < kJointCount; body++) {
+    const Vector6& v = velocity[body];
+    const Vector6 momentum = inertia[body] * v;
+    for (std::size_t column = 0; column <= body; column++) {
+      const Vector6 force =
+          inertia[body] * S_dot[column] +
+          Scalar(0.5) * (detail::crossForce<Scalar>(v, inertia[body] * S[column]) -
+                         inertia[body] * detail::crossMotion(v, S[column]) +
+                         detail::crossForce(S[column], momentum));
+      for (std::size_t row = 0; row <= body; row++) {
+        C(row, column) += S[row].dot(force);
+      }
+    }
+  }
+}
+
+/**
+ * Calculates the 7x7 Coriolis matrix, see
+ * coriolisMatrix(const RigidBody<Scalar>*, const Scalar*, const Scalar*, Scalar*).
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] I_total Inertia of the attached total load including end effector, relative to
+ * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+ * @param[in] m_total Weight of the attached total load including end effector.
+ * Unit: \f$[kg]\f$.
+ * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+ * 3 elements. Unit: \f$[m]\f$.
+ * @param[out] output Vectorized 7x7 Coriolis matrix, column-major. Must hold 49 elements.
+ */
+template <typename Scalar>
+inline void coriolisMatrix(
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* I_total,
+    Scalar m_total,
+    const Scalar* F_x_Ctotal,
+    Scalar* output) noexcept {
+  RigidBody<Scalar> bodies[kJointCount];
+  rigidBodies(I_total, m_total, F_x_Ctotal, bodies);
+  coriolisMatrix(bodies, q, dq, output);
+}
+
+/**
+ * Calculates the gravity vector with the recursive Newton-Euler algorithm.
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+ * @param[in] m_total Weight of the attached total load including end effector.
+ * Unit: \f$[kg]\f$.
+ * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+ * 3 elements. Unit: \f$[m]\f$.
+ * @param[out] output Gravity vector, 7 elements. Unit: \f$[Nm]\f$.
+ */
+template <typename Scalar>
+inline void gravity(
+    const Scalar* q,
+    const Scalar* gravity_earth,
+    Scalar m_total,
+    const Scalar* F_x_Ctotal,
+    Scalar* output) noexcept {
+  // The load's inertia does not contribute to gravity.
+  Scalar zero[9];
+  for (Scalar& value : zero) {
+    value = Scalar(0.);
+  }
+  inverseDynamics(q, zero, zero, zero, m_total, F_x_Ctotal, gravity_earth, output);
+}
+
+}  // namespace dynamics
+}  // namespace panda_model
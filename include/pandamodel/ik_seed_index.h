@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/model.h"
+
+/**
+ * @file ik_seed_index.h
+ * Contains a nearest neighbour index of precomputed poses for seeding inverse kinematics.
+ */
+
+namespace panda_model {
+
+/**
+ * Maps poses of a frame to the joint positions they were computed from, to look up the
+ * nearest seeds of InverseKinematics for a target pose.
+ *
+ * The index is a k-d tree over the position of the frame and its x and y axes scaled by the
+ * orientation scale, so the distance between two poses is
+ * \f$\sqrt{\|\Delta p\|^2 + s^2 (\|\Delta x\|^2 + \|\Delta y\|^2)}\f$ in meters. The tree is
+ * stored implicitly in median order in one contiguous block of single precision floats, which
+ * is written to disk by save() and memory-mapped by load() without parsing, so even large
+ * indices load instantly and are shared between processes through the page cache. The file is
+ * stored in native byte order.
+ *
+ * Copies share the same storage. Queries are thread-safe.
+ */
+class IKSeedIndex {
+ public:
+  /**
+   * Builds an index from the poses of the given joint positions, e.g. a dense sample of the
+   * joint space within the joint limits.
+   *
+   * @param[in] model Model to calculate the poses with.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions.
+   * @param[in] frame The frame whose poses are indexed.
+   * @param[in] orientation_scale Weight \f$s\f$ of the orientation in the distance.
+   * Unit: \f$[m]\f$.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Index of the poses.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  static IKSeedIndex build(const Model& model,
+                           const double* q,
+                           std::size_t n,
+                           Frame frame = Frame::kEndEffector,
+                           double orientation_scale = 0.1,
+                           const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                           const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Memory-maps an index written by save(). The file is mapped read-only for the lifetime of
+   * the index and its copies.
+   *
+   * @param[in] path Path of the index file.
+   *
+   * @return Index stored in the file.
+   *
+   * @throw std::runtime_error if the file cannot be mapped or is not a valid index.
+   */
+  static IKSeedIndex load(const std::string& path);
+
+  /**
+   * Writes the index to a file that can be memory-mapped by load().
+   *
+   * @param[in] path Path of the index file, overwritten if it exists.
+   *
+   * @throw std::runtime_error if the file cannot be written.
+   */
+  void save(const std::string& path) const;
+
+  /**
+   * Gets the number of indexed poses.
+   *
+   * @return Number of poses.
+   */
+  std::size_t size() const noexcept;
+
+  /**
+   * Gets the frame whose poses are indexed.
+   *
+   * @return Indexed frame.
+   */
+  Frame frame() const noexcept;
+
+  /**
+   * Gets the weight of the orientation in the distance.
+   *
+   * @return Orientation scale. Unit: \f$[m]\f$.
+   */
+  double orientationScale() const noexcept;
+
+  /**
+   * Finds the joint positions whose poses are nearest to the given target.
+   *
+   * @param[in] target Target pose of the frame relative to the base frame.
+   * @param[in] k Maximum number of seeds.
+   * @param[out] seeds Joint positions by ascending distance. Must hold 7 * k elements.
+   * @param[out] distances Distances of the seeds' poses from the target. Must hold k elements,
+   * may be null. Unit: \f$[m]\f$.
+   *
+   * @return Number of seeds found, the smaller of k and size().
+   */
+  std::size_t nearest(const Eigen::Matrix4d& target,
+                      std::size_t k,
+                      double* seeds,
+                      double* distances = nullptr) const;
+
+  /**
+   * Finds the nearest joint positions for a batch of targets, see nearest().
+   *
+   * @param[in] targets Vectorized 4x4 target poses, column-major, n consecutive matrices of 16
+   * elements each.
+   * @param[in] n Number of targets.
+   * @param[in] k Maximum number of seeds per target.
+   * @param[out] seeds Joint positions, n consecutive blocks of min(k, size()) vectors of 7
+   * elements each.
+   * @param[out] distances Distances, n consecutive blocks of min(k, size()) elements. May be
+   * null.
+   */
+  void nearest(const double* targets,
+               std::size_t n,
+               std::size_t k,
+               double* seeds,
+               double* distances = nullptr) const;
+
+ private:
+  explicit IKSeedIndex(std::shared_ptr<const char> data, std::size_t bytes);
+
+  std::shared_ptr<const char> data_;
+  std::size_t bytes_;
+  std::size_t size_;
+  Frame frame_;
+  double orientation_scale_;
+  const float* features_;
+  const float* q_;
+  const std::uint8_t* split_;
+};
+
+}  // namespace panda_model
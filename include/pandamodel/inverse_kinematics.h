@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/kinematic_parameters.h"
+#include "pandamodel/model.h"
+#include "pandamodel/thread_pool.h"
+
+/**
+ * @file inverse_kinematics.h
+ * Contains the parallel damped least squares inverse kinematics of a Model.
+ */
+
+namespace panda_model {
+
+/**
+ * Enumerates the outcomes of an InverseKinematics query.
+ */
+enum class IKStatus : std::uint8_t {
+  /// The pose error is within both tolerances.
+  kConverged,
+  /// The iteration budget was exhausted before convergence.
+  kMaxIterations,
+  /// The step vanished before convergence, e.g. at a joint limit or a local minimum.
+  kStalled
+};
+
+/**
+ * Tuning parameters of InverseKinematics.
+ */
+struct IKOptions {
+  /// Maximum number of damped least squares steps.
+  std::size_t max_iterations = 100;
+  /// Damping \f$\lambda\f$ of the step \f$J^T (J J^T + \lambda^2 I)^{-1} e\f$.
+  double damping = 1e-3;
+  /// Largest norm of one step, longer steps are shortened. Unit: \f$[rad]\f$.
+  double max_step = 0.5;
+  /// Norm of a step below which the query is stalled. Unit: \f$[rad]\f$.
+  double min_step = 1e-12;
+  /// Accepted distance of the frame from the target position. Unit: \f$[m]\f$.
+  double position_tolerance = 1e-6;
+  /// Accepted rotation angle of the frame from the target orientation. Unit: \f$[rad]\f$.
+  double orientation_tolerance = 1e-5;
+  /// Lower joint position limits the solution is clamped to. Unit: \f$[rad]\f$.
+  Eigen::Matrix<double, 7, 1> q_min{
+      Eigen::Map<const Eigen::Matrix<double, 7, 1>>(kinematics::kJointPositionMin)};
+  /// Upper joint position limits the solution is clamped to. Unit: \f$[rad]\f$.
+  Eigen::Matrix<double, 7, 1> q_max{
+      Eigen::Map<const Eigen::Matrix<double, 7, 1>>(kinematics::kJointPositionMax)};
+};
+
+/**
+ * Result of one InverseKinematics query.
+ */
+struct IKSolution {
+  /// Joint position of the last iterate, within the joint limits.
+  Eigen::Matrix<double, 7, 1> q;
+  /// Outcome of the query.
+  IKStatus status;
+  /// Number of steps taken.
+  std::size_t iterations;
+  /// Distance of the frame from the target position at q. Unit: \f$[m]\f$.
+  double position_error;
+  /// Rotation angle of the frame from the target orientation at q. Unit: \f$[rad]\f$.
+  double orientation_error;
+};
+
+/**
+ * Solves inverse kinematics for batches of target poses with damped least squares on a
+ * work-stealing thread pool.
+ *
+ * Each query starts from its own seed, e.g. the previous solution of a tracking loop, and
+ * iterates \f$q \leftarrow clamp(q + J^T (J J^T + \lambda^2 I)^{-1} e)\f$ with the zero
+ * Jacobian \f$J\f$ and the pose error \f$e\f$ of the frame relative to the base frame, whose
+ * orientation part is the rotation vector from the current to the target orientation. The
+ * poses and Jacobians are evaluated with Model::pose and Model::zeroJacobian, so the model
+ * library is used if the Model has one. The Model must outlive the InverseKinematics.
+ */
+class InverseKinematics {
+ public:
+  /**
+   * Creates an inverse kinematics engine and starts its worker threads.
+   *
+   * @param[in] model Model to invert.
+   * @param[in] num_threads Number of threads, zero selects the number of hardware threads.
+   * @param[in] grain_size Number of queries solved per scheduled chunk.
+   */
+  explicit InverseKinematics(const Model& model,
+                             std::size_t num_threads = 0,
+                             std::size_t grain_size = 4);
+
+  /**
+   * Gets the number of threads used for solving.
+   *
+   * @return Number of threads.
+   */
+  std::size_t numThreads() const noexcept;
+
+  /**
+   * Solves one query on the calling thread.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] target Desired pose of the frame relative to the base frame.
+   * @param[in] seed Initial joint position, clamped to the joint limits.
+   * @param[in] options Tuning parameters.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Solution of the query.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  IKSolution solve(Frame frame,
+                   const Eigen::Matrix4d& target,
+                   const Eigen::Matrix<double, 7, 1>& seed,
+                   const IKOptions& options = IKOptions(),
+                   const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                   const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K) const;
+
+  /**
+   * Solves a batch of queries in parallel.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] targets Vectorized 4x4 desired poses, column-major, n consecutive matrices of 16
+   * elements each.
+   * @param[in] seeds Initial joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of queries.
+   * @param[out] output Solutions. Must hold n elements.
+   * @param[in] options Tuning parameters shared by all queries.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void solve(Frame frame,
+             const double* targets,
+             const double* seeds,
+             std::size_t n,
+             IKSolution* output,
+             const IKOptions& options = IKOptions(),
+             const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+             const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+ private:
+  const Model& model_;
+  ThreadPool pool_;
+  std::size_t grain_size_;
+};
+
+}  // namespace panda_model
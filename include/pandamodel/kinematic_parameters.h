@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file kinematic_parameters.h
+ * Contains the kinematic parameters of the robot.
+ */
+
+namespace panda_model {
+namespace kinematics {
+
+/**
+ * Modified (Craig) Denavit-Hartenberg parameters of one link.
+ *
+ * The transform from the previous frame is \f$Rot_x(\alpha) Trans_x(a) Rot_z(\theta)
+ * Trans_z(d)\f$. \f$\alpha\f$ is a multiple of \f$\frac{\pi}{2}\f$ for every link, so its cosine
+ * and sine are stored exactly.
+ */
+struct LinkParameters {
+  /// Distance along the previous x axis. Unit: \f$[m]\f$.
+  double a;
+  /// Distance along the own z axis. Unit: \f$[m]\f$.
+  double d;
+  /// Cosine of the twist about the previous x axis.
+  double cos_alpha;
+  /// Sine of the twist about the previous x axis.
+  double sin_alpha;
+};
+
+/**
+ * Number of links in the kinematic chain: seven joints and the flange.
+ */
+constexpr std::size_t kLinkCount = 8;
+
+/**
+ * Published kinematic parameters of the robot, indexed like Frame from kJoint1 to kFlange.
+ */
+constexpr LinkParameters kLinks[kLinkCount] = {
+    {0., 0.333, 1., 0.},       {0., 0., 0., -1.},  {0., 0.316, 0., 1.}, {0.0825, 0., 0., 1.},
+    {-0.0825, 0.384, 0., -1.}, {0., 0., 0., 1.},   {0.088, 0., 0., 1.}, {0., 0.107, 1., 0.},
+};
+
+/**
+ * Published lower joint position limits of the robot, indexed like Frame from kJoint1 to
+ * kJoint7. Unit: \f$[rad]\f$.
+ */
+constexpr double kJointPositionMin[kLinkCount - 1] = {-2.8973, -1.7628, -2.8973, -3.0718,
+                                                      -2.8973, -0.0175, -2.8973};
+
+/**
+ * Published upper joint position limits of the robot, indexed like Frame from kJoint1 to
+ * kJoint7. Unit: \f$[rad]\f$.
+ */
+constexpr double kJointPositionMax[kLinkCount - 1] = {2.8973, 1.7628, 2.8973, -0.0698,
+                                                      2.8973, 3.7525, 2.8973};
+
+}  // namespace kinematics
+}  // namespace panda_model
@@ -0,0 +1,387 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "pandamodel/kinematic_parameters.h"
+#include "pandamodel/model.h"
+
+/**
+ * @file kinematics.h
+ * Contains a header-only implementation of the robot's forward kinematics and Jacobians.
+ *
+ * The functions are templates over the scalar type, e.g. float, double or
+ * Eigen::AutoDiffScalar, which is deduced from the joint position.
+ */
+
+namespace panda_model {
+namespace kinematics {
+
+/// 4x4 matrix of the given scalar type.
+template <typename Scalar>
+using Matrix4 = Eigen::Matrix<Scalar, 4, 4>;
+
+/// 3x3 matrix of the given scalar type.
+template <typename Scalar>
+using Matrix3 = Eigen::Matrix<Scalar, 3, 3>;
+
+/// 3 element vector of the given scalar type.
+template <typename Scalar>
+using Vector3 = Eigen::Matrix<Scalar, 3, 1>;
+
+namespace detail {
+
+constexpr std::size_t index(Frame frame) noexcept {
+  return static_cast<std::size_t>(frame);
+}
+
+/**
+ * Number of links whose poses are needed to calculate the pose of the given frame.
+ */
+constexpr std::size_t linkCount(Frame frame) noexcept {
+  return std::min(index(frame) + 1, kLinkCount);
+}
+
+/**
+ * Number of joints that move the given frame.
+ */
+constexpr std::size_t jointCount(Frame frame) noexcept {
+  return std::min(index(frame) + 1, std::size_t{7});
+}
+
+constexpr bool isValid(Frame frame) noexcept {
+  return index(frame) < kFrameCount;
+}
+
+template <typename Scalar>
+inline void linkTransform(const LinkParameters& link,
+                          const Scalar& theta,
+                          Matrix4<Scalar>& T) noexcept {
+  // Unqualified, so scalar types like Eigen::AutoDiffScalar are found by argument-dependent
+  // lookup.
+  using std::cos;
+  using std::sin;
+  const Scalar cos_theta = cos(theta);
+  const Scalar sin_theta = sin(theta);
+  const Scalar a(link.a), d(link.d), cos_alpha(link.cos_alpha), sin_alpha(link.sin_alpha);
+  const Scalar zero(0.), one(1.);
+  T << cos_theta, -sin_theta, zero, a,
+       sin_theta * cos_alpha, cos_theta * cos_alpha, -sin_alpha, -sin_alpha * d,
+       sin_theta * sin_alpha, cos_theta * sin_alpha, cos_alpha, cos_alpha * d,
+       zero, zero, zero, one;
+}
+
+/**
+ * Gets the pose of the given frame from the poses of the links.
+ */
+template <typename Scalar>
+inline Matrix4<Scalar> targetPose(
+    Frame frame,
+    const Matrix4<Scalar>* O_T_J,
+    const Scalar* F_T_EE,
+    const Scalar* EE_T_K) noexcept {
+  if (frame == Frame::kEndEffector) {
+    return O_T_J[kLinkCount - 1] * Eigen::Map<const Matrix4<Scalar>>(F_T_EE);
+  }
+  if (frame == Frame::kStiffness) {
+    return O_T_J[kLinkCount - 1] * Eigen::Map<const Matrix4<Scalar>>(F_T_EE) *
+           Eigen::Map<const Matrix4<Scalar>>(EE_T_K);
+  }
+  return O_T_J[index(frame)];
+}
+
+/**
+ * Writes the zero Jacobian of a point at the given position, moved by the first joints.
+ */
+template <typename Scalar>
+inline void zeroJacobian(
+    const Matrix4<Scalar>* O_T_J,
+    std::size_t joints,
+    const Vector3<Scalar>& position,
+    Scalar* output) noexcept {
+  Eigen::Map<Eigen::Matrix<Scalar, 6, 7>> jacobian(output);
+  jacobian.setZero();
+  for (std::size_t joint = 0; joint < joints; joint++) {
+    const Vector3<Scalar> axis = O_T_J[joint].template block<3, 1>(0, 2);
+    const Vector3<Scalar> offset = position - O_T_J[joint].template block<3, 1>(0, 3);
+    jacobian.template block<3, 1>(0, joint) = axis.cross(offset);
+    jacobian.template block<3, 1>(3, joint) = axis;
+  }
+}
+
+/**
+ * Writes the zero Jacobian of a point at the given position, moved by the first joints, and
+ * its time derivative. Also gets the angular velocity of the body the point is attached to.
+ */
+template <typename Scalar>
+inline void zeroJacobianDot(
+    const Matrix4<Scalar>* O_T_J,
+    std::size_t joints,
+    const Vector3<Scalar>& position,
+    const Scalar* dq,
+    Scalar* jacobian_output,
+    Scalar* output,
+    Vector3<Scalar>& omega) noexcept {
+  zeroJacobian(O_T_J, joints, position, jacobian_output);
+  Eigen::Map<const Eigen::Matrix<Scalar, 6, 7>> jacobian(jacobian_output);
+  Eigen::Map<Eigen::Matrix<Scalar, 6, 7>> jacobian_dot(output);
+  jacobian_dot.setZero();
+
+  Vector3<Scalar> velocity = Vector3<Scalar>::Zero();
+  for (std::size_t joint = 0; joint < joints; joint++) {
+    velocity += jacobian.template block<3, 1>(0, joint) * dq[joint];
+  }
+
+  // The origin of each joint frame is fixed in the previous link, so its velocity follows from
+  // the previous origin's. Each axis rotates with the angular velocity of the previous link.
+  omega.setZero();
+  Vector3<Scalar> origin = Vector3<Scalar>::Zero();
+  Vector3<Scalar> origin_velocity = Vector3<Scalar>::Zero();
+  for (std::size_t joint = 0; joint < joints; joint++) {
+    const Vector3<Scalar> axis = O_T_J[joint].template block<3, 1>(0, 2);
+    const Vector3<Scalar> joint_origin = O_T_J[joint].template block<3, 1>(0, 3);
+    origin_velocity += omega.cross(joint_origin - origin);
+    origin = joint_origin;
+    const Vector3<Scalar> axis_dot = omega.cross(axis);
+    jacobian_dot.template block<3, 1>(0, joint) =
+        axis_dot.cross(position - origin) + axis.cross(velocity - origin_velocity);
+    jacobian_dot.template block<3, 1>(3, joint) = axis_dot;
+    omega += axis * dq[joint];
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Calculates the poses of the first links in base frame.
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] count Number of links to calculate, at most kLinkCount.
+ * @param[out] O_T_J Receives the 4x4 pose matrices of the links, indexed like Frame.
+ */
+template <typename Scalar>
+inline void linkPoses(const Scalar* q, std::size_t count, Matrix4<Scalar>* O_T_J) noexcept {
+  Matrix4<Scalar> T;
+  for (std::size_t link = 0; link < count; link++) {
+    detail::linkTransform(kLinks[link], link < 7 ? q[link] : Scalar(0.), T);
+    if (link == 0) {
+      O_T_J[link] = T;
+    } else {
+      O_T_J[link].noalias() = O_T_J[link - 1] * T;
+    }
+  }
+}
+
+/**
+ * Writes the 4x4 pose matrix for the given frame in base frame into the given output.
+ *
+ * @param[in] frame The desired frame.
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+ * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+ * column-major.
+ * @param[out] output Vectorized 4x4 pose matrix, column-major. Must hold 16 elements.
+ *
+ * @return False if the given frame is invalid, in which case output is not written.
+ */
+template <typename Scalar>
+inline bool pose(
+    Frame frame,
+    const Scalar* q,
+    const Scalar* F_T_EE,
+    const Scalar* EE_T_K,
+    Scalar* output) noexcept {
+  if (!detail::isValid(frame)) {
+    return false;
+  }
+  Matrix4<Scalar> O_T_J[kLinkCount];
+  linkPoses(q, detail::linkCount(frame), O_T_J);
+  Eigen::Map<Matrix4<Scalar>> O_T_F(output);
+  O_T_F = detail::targetPose(frame, O_T_J, F_T_EE, EE_T_K);
+  return true;
+}
+
+/**
+ * Writes the 4x4 pose matrices of all frames in base frame into the given output.
+ *
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+ * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+ * column-major.
+ * @param[out] output Vectorized 4x4 pose matrices, column-major, indexed by Frame.
+ * Must hold 16 * kFrameCount elements.
+ */
+template <typename Scalar>
+inline void poses(
+    const Scalar* q,
+    const Scalar* F_T_EE,
+    const Scalar* EE_T_K,
+    Scalar* output) noexcept {
+  // The output is not necessarily aligned for vectorized Matrix4 access, so the poses are
+  // built locally and written through unaligned maps.
+  Matrix4<Scalar> O_T_J[kLinkCount];
+  linkPoses(q, kLinkCount, O_T_J);
+  for (std::size_t link = 0; link < kLinkCount; link++) {
+    Eigen::Map<Matrix4<Scalar>>(output + 16 * link) = O_T_J[link];
+  }
+  const Matrix4<Scalar> O_T_EE =
+      O_T_J[kLinkCount - 1] * Eigen::Map<const Matrix4<Scalar>>(F_T_EE);
+  Eigen::Map<Matrix4<Scalar>>(output + 16 * detail::index(Frame::kEndEffector)) = O_T_EE;
+  Eigen::Map<Matrix4<Scalar>>(output + 16 * detail::index(Frame::kStiffness)) =
+      O_T_EE * Eigen::Map<const Matrix4<Scalar>>(EE_T_K);
+}
+
+/**
+ * Writes the 6x7 Jacobian for the given frame relative to the base frame into the given
+ * output.
+ *
+ * @param[in] frame The desired frame.
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+ * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+ * column-major.
+ * @param[out] output Vectorized 6x7 Jacobian, column-major. Must hold 42 elements.
+ *
+ * @return False if the given frame is invalid, in which case output is not written.
+ */
+template <typename Scalar>
+inline bool zeroJacobian(
+    Frame frame,
+    const Scalar* q,
+    const Scalar* F_T_EE,
+    const Scalar* EE_T_K,
+    Scalar* output) noexcept {
+  if (!detail::isValid(frame)) {
+    return false;
+  }
+  Matrix4<Scalar> O_T_J[kLinkCount];
+  linkPoses(q, detail::linkCount(frame), O_T_J);
+  const Matrix4<Scalar> O_T_F = detail::targetPose(frame, O_T_J, F_T_EE, EE_T_K);
+  detail::zeroJacobian<Scalar>(O_T_J, detail::jointCount(frame),
+                               O_T_F.template block<3, 1>(0, 3), output);
+  return true;
+}
+
+/**
+ * Writes the 6x7 Jacobian for the given frame, relative to that frame, into the given output.
+ *
+ * @param[in] frame The desired frame.
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+ * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+ * column-major.
+ * @param[out] output Vectorized 6x7 Jacobian, column-major. Must hold 42 elements.
+ *
+ * @return False if the given frame is invalid, in which case output is not written.
+ */
+template <typename Scalar>
+inline bool bodyJacobian(
+    Frame frame,
+    const Scalar* q,
+    const Scalar* F_T_EE,
+    const Scalar* EE_T_K,
+    Scalar* output) noexcept {
+  if (!detail::isValid(frame)) {
+    return false;
+  }
+  Matrix4<Scalar> O_T_J[kLinkCount];
+  linkPoses(q, detail::linkCount(frame), O_T_J);
+  const Matrix4<Scalar> O_T_F = detail::targetPose(frame, O_T_J, F_T_EE, EE_T_K);
+  detail::zeroJacobian<Scalar>(O_T_J, detail::jointCount(frame),
+                               O_T_F.template block<3, 1>(0, 3), output);
+  Eigen::Map<Eigen::Matrix<Scalar, 6, 7>> jacobian(output);
+  const Matrix3<Scalar> F_R_O = O_T_F.template topLeftCorner<3, 3>().transpose();
+  jacobian.template topRows<3>() = F_R_O * jacobian.template topRows<3>();
+  jacobian.template bottomRows<3>() = F_R_O * jacobian.template bottomRows<3>();
+  return true;
+}
+
+/**
+ * Writes the time derivative of the 6x7 Jacobian for the given frame relative to the base
+ * frame into the given output, see zeroJacobian().
+ *
+ * @param[in] frame The desired frame.
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+ * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+ * column-major.
+ * @param[out] output Vectorized 6x7 Jacobian derivative, column-major. Must hold 42 elements.
+ *
+ * @return False if the given frame is invalid, in which case output is not written.
+ */
+template <typename Scalar>
+inline bool zeroJacobianDot(
+    Frame frame,
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* F_T_EE,
+    const Scalar* EE_T_K,
+    Scalar* output) noexcept {
+  if (!detail::isValid(frame)) {
+    return false;
+  }
+  Matrix4<Scalar> O_T_J[kLinkCount];
+  linkPoses(q, detail::linkCount(frame), O_T_J);
+  const Matrix4<Scalar> O_T_F = detail::targetPose(frame, O_T_J, F_T_EE, EE_T_K);
+  Scalar jacobian[42];
+  Vector3<Scalar> omega;
+  detail::zeroJacobianDot<Scalar>(O_T_J, detail::jointCount(frame),
+                                  O_T_F.template block<3, 1>(0, 3), dq, jacobian, output, omega);
+  return true;
+}
+
+/**
+ * Writes the time derivative of the 6x7 Jacobian for the given frame, relative to that frame,
+ * into the given output, see bodyJacobian().
+ *
+ * @param[in] frame The desired frame.
+ * @param[in] q Joint position, 7 elements.
+ * @param[in] dq Joint velocity, 7 elements.
+ * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+ * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+ * column-major.
+ * @param[out] output Vectorized 6x7 Jacobian derivative, column-major. Must hold 42 elements.
+ *
+ * @return False if the given frame is invalid, in which case output is not written.
+ */
+template <typename Scalar>
+inline bool bodyJacobianDot(
+    Frame frame,
+    const Scalar* q,
+    const Scalar* dq,
+    const Scalar* F_T_EE,
+    const Scalar* EE_T_K,
+    Scalar* output) noexcept {
+  if (!detail::isValid(frame)) {
+    return false;
+  }
+  Matrix4<Scalar> O_T_J[kLinkCount];
+  linkPoses(q, detail::linkCount(frame), O_T_J);
+  const Matrix4<Scalar> O_T_F = detail::targetPose(frame, O_T_J, F_T_EE, EE_T_K);
+  Scalar jacobian_data[42];
+  Vector3<Scalar> omega;
+  detail::zeroJacobianDot<Scalar>(O_T_J, detail::jointCount(frame),
+                                  O_T_F.template block<3, 1>(0, 3), dq, jacobian_data, output,
+                                  omega);
+
+  // The body Jacobian is F_R_O times the zero Jacobian, and F_R_O changes with -omega x.
+  Eigen::Map<const Eigen::Matrix<Scalar, 6, 7>> jacobian(jacobian_data);
+  Eigen::Map<Eigen::Matrix<Scalar, 6, 7>> jacobian_dot(output);
+  const Matrix3<Scalar> F_R_O = O_T_F.template topLeftCorner<3, 3>().transpose();
+  for (std::size_t joint = 0; joint < 7; joint++) {
+    for (int row = 0; row < 6; row += 3) {
+      const Vector3<Scalar> column = jacobian.template block<3, 1>(row, joint);
+      const Vector3<Scalar> column_dot = jacobian_dot.template block<3, 1>(row, joint);
+      jacobian_dot.template block<3, 1>(row, joint) = F_R_O * (column_dot - omega.cross(column));
+    }
+  }
+  return true;
+}
+
+}  // namespace kinematics
+}  // namespace panda_model
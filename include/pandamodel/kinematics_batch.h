@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+
+#include "pandamodel/model.h"
+
+/**
+ * @file kinematics_batch.h
+ * Contains a vectorized forward kinematics kernel for large batches of joint positions.
+ */
+
+namespace panda_model {
+namespace kinematics {
+
+/**
+ * Enumerates the instruction sets the batch kernel is implemented for.
+ */
+enum class InstructionSet {
+  /// One configuration at a time, portable.
+  kScalar,
+  /// Four configurations per instruction.
+  kAVX2,
+  /// Eight configurations per instruction.
+  kAVX512
+};
+
+/**
+ * Checks whether the batch kernel for the given instruction set was built and is supported by
+ * the processor.
+ *
+ * @param[in] instruction_set The instruction set to check.
+ *
+ * @return True if the kernel can be used.
+ */
+bool isSupported(InstructionSet instruction_set) noexcept;
+
+/**
+ * Gets the widest instruction set the batch kernel can use on this processor.
+ *
+ * @return Instruction set used by default.
+ */
+InstructionSet bestInstructionSet() noexcept;
+
+/**
+ * Calculates the 4x4 pose matrices for the given frame in base frame for a batch of joint
+ * positions.
+ *
+ * The joint positions are transposed into structure-of-arrays blocks, so several configurations
+ * are evaluated with the same instructions. Sine and cosine are computed with a branch-free
+ * polynomial approximation accurate to a few units in the last place. The results match
+ * kinematics::pose.
+ *
+ * @param[in] frame The desired frame.
+ * @param[in] q Joint positions, n x 7 elements stored contiguously, one position per row.
+ * @param[in] n Number of joint positions.
+ * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+ * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+ * column-major.
+ * @param[out] output Vectorized 4x4 pose matrices, column-major. Must hold n * 16 elements.
+ * @param[in] instruction_set Instruction set to use. Falls back to bestInstructionSet() if the
+ * given one is not supported.
+ *
+ * @return False if the given frame is invalid, in which case output is not written.
+ */
+bool poseBatch(
+    Frame frame,
+    const double* q,
+    std::size_t n,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output,
+    InstructionSet instruction_set = bestInstructionSet()) noexcept;
+
+}  // namespace kinematics
+}  // namespace panda_model
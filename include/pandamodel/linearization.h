@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/model.h"
+#include "pandamodel/thread_pool.h"
+
+/**
+ * @file linearization.h
+ * Contains the parallel linearization of the equations of motion of a Model.
+ */
+
+namespace panda_model {
+
+/**
+ * Enumerates the finite difference schemes of Linearization.
+ */
+enum class Difference {
+  /// One-sided differences, one perturbed evaluation per state coordinate.
+  kForward,
+  /// Central differences, two perturbed evaluations per state coordinate.
+  kCentral
+};
+
+/**
+ * Linearizes the equations of motion \f$\ddot{q} = M(q)^{-1} (\tau - C(q, \dot{q}) \dot{q} -
+ * g(q))\f$ of a Model around batches of knots, e.g. the horizon of a model predictive
+ * controller, on a work-stealing thread pool.
+ *
+ * For the state \f$x = (q, \dot{q})\f$ the continuous-time state space matrices are
+ * \f$A = \frac{\partial \dot{x}}{\partial x} =
+ * \begin{pmatrix} 0 & I \\ \frac{\partial \ddot{q}}{\partial q} &
+ * \frac{\partial \ddot{q}}{\partial \dot{q}} \end{pmatrix}\f$ and
+ * \f$B = \frac{\partial \dot{x}}{\partial \tau} = \begin{pmatrix} 0 \\ M^{-1} \end{pmatrix}\f$.
+ * The partial derivatives of the acceleration are approximated with finite differences, whose
+ * perturbations of all knots are evaluated in parallel; \f$M^{-1}\f$ is exact. The dynamics are
+ * evaluated with Model::mass, Model::coriolis and Model::gravity, so the model library is used if
+ * the Model has one. The Model must outlive the Linearization.
+ */
+class Linearization {
+ public:
+  /**
+   * Creates a linearization engine and starts its worker threads.
+   *
+   * @param[in] model Model to linearize.
+   * @param[in] num_threads Number of threads, zero selects the number of hardware threads.
+   * @param[in] grain_size Number of perturbations evaluated per scheduled chunk.
+   */
+  explicit Linearization(const Model& model,
+                         std::size_t num_threads = 0,
+                         std::size_t grain_size = 4);
+
+  /**
+   * Gets the number of threads used for linearization.
+   *
+   * @return Number of threads.
+   */
+  std::size_t numThreads() const noexcept;
+
+  /**
+   * Calculates the state space matrices for the given knots.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] tau Joint torques, n consecutive vectors of 7 elements each. Unit: \f$[Nm]\f$.
+   * @param[in] n Number of knots.
+   * @param[out] A Vectorized 14x14 state matrices, column-major. Must hold 196 * n elements.
+   * @param[out] B Vectorized 14x7 input matrices, column-major. Must hold 98 * n elements.
+   * @param[in] difference Finite difference scheme.
+   * @param[in] step Perturbation of each state coordinate.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  void linearize(const double* q,
+                 const double* dq,
+                 const double* tau,
+                 std::size_t n,
+                 double* A,
+                 double* B,
+                 Difference difference = Difference::kCentral,
+                 double step = 1e-6,
+                 const Eigen::Matrix3d& I_total = Defaults::I_total,
+                 double m_total = Defaults::m_total,
+                 const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+                 const Eigen::Vector3d& gravity_earth = {0., 0., -9.81});
+
+ private:
+  const Model& model_;
+  ThreadPool pool_;
+  std::size_t grain_size_;
+};
+
+}  // namespace panda_model
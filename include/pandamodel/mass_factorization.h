@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Eigen/Core>
+
+/**
+ * @file mass_factorization.h
+ * Contains the factorization of the mass matrix.
+ */
+
+namespace panda_model {
+
+/**
+ * Factorization \f$M = L D L^T\f$ of a 7x7 mass matrix with unit lower triangular \f$L\f$ and
+ * diagonal \f$D\f$, which is reused to solve for several right-hand sides.
+ *
+ * The factors are stored in place of the mass matrix without heap allocation, so arrays of
+ * factorizations are contiguous, see Model::massFactorizationBatch. The mass matrix must be
+ * positive definite, which holds for every configuration of the robot.
+ */
+class MassFactorization {
+ public:
+  /**
+   * Creates the factorization of the identity.
+   */
+  MassFactorization() noexcept;
+
+  /**
+   * Factorizes the given mass matrix.
+   *
+   * @param[in] mass 7x7 mass matrix.
+   */
+  explicit MassFactorization(const Eigen::Matrix<double, 7, 7>& mass) noexcept;
+
+  /**
+   * Factorizes the given mass matrix, replacing the previous factors.
+   *
+   * @param[in] mass Vectorized 7x7 mass matrix, column-major. Must hold 49 elements.
+   */
+  void compute(const double* mass) noexcept;
+
+  /**
+   * Factorizes the mass matrix that was written into data(), replacing it with its factors.
+   */
+  void computeInPlace() noexcept;
+
+  /**
+   * Gets the packed factors: the strictly lower triangle holds \f$L\f$, the diagonal holds
+   * \f$D\f$.
+   *
+   * @return Vectorized 7x7 matrix, column-major.
+   */
+  const double* data() const noexcept;
+
+  /**
+   * Gets the packed factors for writing, see computeInPlace().
+   *
+   * @return Vectorized 7x7 matrix, column-major.
+   */
+  double* data() noexcept;
+
+  /**
+   * Gets the unit lower triangular factor.
+   *
+   * @return 7x7 matrix \f$L\f$.
+   */
+  Eigen::Matrix<double, 7, 7> L() const noexcept;
+
+  /**
+   * Gets the diagonal factor.
+   *
+   * @return Diagonal of \f$D\f$.
+   */
+  Eigen::Matrix<double, 7, 1> D() const noexcept;
+
+  /**
+   * Reconstructs the factorized mass matrix.
+   *
+   * @return 7x7 mass matrix.
+   */
+  Eigen::Matrix<double, 7, 7> mass() const noexcept;
+
+  /**
+   * Solves \f$M x = b\f$.
+   *
+   * @param[in] rhs Right-hand side \f$b\f$, 7 elements.
+   * @param[out] output Solution \f$x\f$. Must hold 7 elements, may alias rhs.
+   */
+  void solve(const double* rhs, double* output) const noexcept;
+
+  /**
+   * Solves \f$M x = b\f$.
+   *
+   * @param[in] rhs Right-hand side \f$b\f$.
+   *
+   * @return Solution \f$x\f$.
+   */
+  Eigen::Matrix<double, 7, 1> solve(const Eigen::Matrix<double, 7, 1>& rhs) const noexcept;
+
+  /**
+   * Calculates the inverse mass matrix.
+   *
+   * @param[out] output Vectorized 7x7 inverse mass matrix, column-major. Must hold 49 elements.
+   */
+  void inverse(double* output) const noexcept;
+
+  /**
+   * Calculates the inverse mass matrix.
+   *
+   * @return 7x7 inverse mass matrix.
+   */
+  Eigen::Matrix<double, 7, 7> inverse() const noexcept;
+
+ private:
+  Eigen::Matrix<double, 7, 7> factors_;
+};
+
+}  // namespace panda_model
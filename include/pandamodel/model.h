@@ -3,10 +3,13 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <Eigen/Core>
 
 #include "pandamodel/defaults.h"
+#include "pandamodel/mass_factorization.h"
 
 /**
  * @file model.h
@@ -31,6 +34,11 @@ enum class Frame {
   kStiffness
 };
 
+/**
+ * Number of frames enumerated by Frame.
+ */
+constexpr std::size_t kFrameCount = 10;
+
 /**
  * Post-increments the given Frame by one.
  *
@@ -42,6 +50,60 @@ enum class Frame {
  */
 Frame operator++(Frame& frame, int /* dummy */) noexcept;
 
+namespace kinematics {
+// Defined in kinematics_batch.h, which depends on this header.
+enum class InstructionSet;
+}  // namespace kinematics
+
+/**
+ * Receives a chunk of joint torques streamed by Model::inverseDynamicsTrajectory.
+ *
+ * Called as sink(offset, count, tau) with the index of the first sample of the chunk, the number
+ * of samples in the chunk, and count consecutive vectors of 7 torques each. The torques are only
+ * valid during the call, the buffer is reused for the next chunk.
+ */
+using TorqueSink = std::function<void(std::size_t, std::size_t, const double*)>;
+
+/**
+ * Kinematic and dynamic quantities of the robot in one state, see Model::computeState.
+ */
+struct DynamicsState {
+  /// End effector pose in base frame.
+  Eigen::Matrix4d O_T_EE;
+  /// End effector Jacobian relative to the base frame.
+  Eigen::Matrix<double, 6, 7> O_Jac_EE;
+  /// Mass matrix. Unit: \f$[kg \times m^2]\f$.
+  Eigen::Matrix<double, 7, 7> mass;
+  /// Coriolis force vector. Unit: \f$[Nm]\f$.
+  Eigen::Matrix<double, 7, 1> coriolis;
+  /// Gravity vector. Unit: \f$[Nm]\f$.
+  Eigen::Matrix<double, 7, 1> gravity;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * Operational space dynamics of one frame in one state, see Model::operationalSpace.
+ *
+ * The task space equations of motion are \f$\Lambda \dot{v} + \mu + p = F\f$ for the
+ * frame's twist \f$v = J \dot{q}\f$ relative to the base frame and the wrench \f$F\f$.
+ */
+struct OperationalSpaceState {
+  /// Operational space inertia matrix \f$\Lambda = (J M^{-1} J^T)^{-1}\f$.
+  Eigen::Matrix<double, 6, 6> Lambda;
+  /// Dynamically consistent generalized inverse \f$\bar{J} = M^{-1} J^T \Lambda\f$.
+  Eigen::Matrix<double, 7, 6> J_bar;
+  /// Task space Coriolis force \f$\mu = \bar{J}^T c - \Lambda \dot{J} \dot{q}\f$.
+  Eigen::Matrix<double, 6, 1> mu;
+  /// Task space gravity force \f$p = \bar{J}^T g\f$.
+  Eigen::Matrix<double, 6, 1> p;
+  /// Dynamically consistent null-space projector for joint torques
+  /// \f$N = I - J^T \bar{J}^T\f$.
+  Eigen::Matrix<double, 7, 7> N;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
 class ModelLibrary;
 // class Network;
 
@@ -53,6 +115,17 @@ class Model {
 
   explicit Model(const std::string &path);
 
+  /**
+   * Creates a Model that uses the native, header-only implementation in kinematics.h and
+   * dynamics.h instead of a downloaded model library.
+   *
+   * Poses and Jacobians are calculated from the published kinematic parameters of the robot,
+   * dynamic quantities with the recursive Newton-Euler algorithm in dynamics.h.
+   *
+   * @return Native Model instance.
+   */
+  static Model native();
+
   /**
    * Move-constructs a new Model instance.
    *
@@ -127,10 +200,115 @@ class Model {
   Eigen::Matrix<double, 6, 7> zeroJacobian(
       Frame frame,
       const Eigen::Matrix<double, 7, 1>& q,
-      const Eigen::Matrix4d& F_T_EE = Defaults::EE_T_K,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const;
+
+  /**
+   * Gets the time derivative of the 6x7 Jacobian for the given frame, relative to that frame.
+   *
+   * The derivative is calculated natively from the kinematic parameters, see kinematics.h,
+   * independent of the model library. Together with the joint velocity it gives the
+   * velocity-dependent part of the frame's acceleration, \f$\dot{J}(q, \dot{q}) \dot{q}\f$.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Vectorized 6x7 Jacobian derivative, column-major.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix<double, 6, 7> bodyJacobianDot(
+      Frame frame,
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const;
+
+  /**
+   * Gets the time derivative of the 6x7 Jacobian for the given frame relative to the base
+   * frame, see bodyJacobianDot().
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Vectorized 6x7 Jacobian derivative, column-major.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix<double, 6, 7> zeroJacobianDot(
+      Frame frame,
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
       const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
       const;
 
+  /**
+   * Gets the 4x4 pose matrix for the given frame in base frame.
+   *
+   * The frame is resolved at compile time, so the model library function is called without
+   * runtime dispatch, e.g. `model.pose<Frame::kEndEffector>(q)`.
+   *
+   * @tparam frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Vectorized 4x4 pose matrix, column-major.
+   */
+  template <Frame frame>
+  Eigen::Matrix4d pose(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Gets the 6x7 Jacobian for the given frame, relative to that frame.
+   *
+   * The frame is resolved at compile time, see pose<frame>().
+   *
+   * @tparam frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Vectorized 6x7 Jacobian, column-major.
+   */
+  template <Frame frame>
+  Eigen::Matrix<double, 6, 7> bodyJacobian(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Gets the 6x7 Jacobian for the given frame relative to the base frame.
+   *
+   * The frame is resolved at compile time, see pose<frame>().
+   *
+   * @tparam frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Vectorized 6x7 Jacobian, column-major.
+   */
+  template <Frame frame>
+  Eigen::Matrix<double, 6, 7> zeroJacobian(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
   /**
    * Calculates the 7x7 mass matrix. Unit: \f$[kg \times m^2]\f$.
    *
@@ -193,12 +371,1149 @@ class Model {
       const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
       const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const noexcept;
 
-  /// @cond DO_NOT_DOCUMENT
-  Model(const Model&) = delete;
-  Model& operator=(const Model&) = delete;
-  /// @endcond
+  /**
+   * Calculates the joint torques for the given joint acceleration:
+   * \f$\tau = M(q) \ddot{q} + C(q, \dot{q}) \dot{q} + g(q)\f$.
+   * Unit: \f$[Nm]\f$.
+   *
+   * A native Model, see native(), calculates the torques in \f$O(n)\f$ with the recursive
+   * Newton-Euler algorithm from identified inertial parameters, see dynamics.h. A Model backed
+   * by the model library assembles them from the library's mass(), coriolis() and gravity()
+   * instead, so they stay consistent with those.
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[in] ddq Joint acceleration.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   *
+   * @return Joint torques.
+   */
+  Eigen::Matrix<double, 7, 1> inverseDynamics(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      const Eigen::Matrix<double, 7, 1>& ddq,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const noexcept;
+
+  /**
+   * Calculates the joint acceleration for the given joint torques:
+   * \f$\ddot{q} = M(q)^{-1} (\tau - C(q, \dot{q}) \dot{q} - g(q))\f$.
+   * Unit: \f$[\frac{rad}{s^2}]\f$.
+   *
+   * A native Model, see native(), calculates the acceleration in \f$O(n)\f$ from identified
+   * inertial parameters, see dynamics.h, without building or inverting the mass matrix. A Model
+   * backed by the model library factorizes the library's mass() and solves it against the
+   * library's coriolis() and gravity() instead, like Rollout. Either way it is the inverse of
+   * inverseDynamics().
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[in] tau Joint torques. Unit: \f$[Nm]\f$.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   *
+   * @return Joint acceleration.
+   */
+  Eigen::Matrix<double, 7, 1> forwardDynamics(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      const Eigen::Matrix<double, 7, 1>& tau,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const noexcept;
+
+  /**
+   * Calculates the 7x7 Coriolis matrix \f$C(q, \dot{q})\f$, such that
+   * \f$C(q, \dot{q}) \dot{q}\f$ is the Coriolis force vector of coriolis() and
+   * \f$\dot{M}(q) - 2 C(q, \dot{q})\f$ is skew-symmetric for the mass matrix of mass().
+   *
+   * A native Model, see native(), calculates the matrix in one pass over the bodies from
+   * identified inertial parameters, see dynamics.h. A Model backed by the model library sums the
+   * Christoffel symbols of the library's mass() instead, whose partial derivatives are taken by
+   * central differences from 14 evaluations of the mass matrix. The skew symmetry then holds
+   * exactly for the differenced \f$\dot{M}\f$, and both properties hold for the library's
+   * mass() and coriolis() up to the differencing accuracy.
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return Coriolis matrix.
+   */
+  Eigen::Matrix<double, 7, 7> coriolisMatrix(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Factorizes the 7x7 mass matrix, see mass(), to solve for several right-hand sides.
+   * ModelCache reuses the factorization for repeated queries of the same configuration.
+   *
+   * @param[in] q Joint position.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return Factorization of the mass matrix.
+   */
+  MassFactorization massFactorization(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Calculates the inverse of the 7x7 mass matrix from its factorization.
+   *
+   * @param[in] q Joint position.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return 7x7 inverse mass matrix.
+   */
+  Eigen::Matrix<double, 7, 7> inverseMass(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Solves \f$M(q) x = b\f$ from the factorization of the mass matrix, e.g. to get the joint
+   * acceleration for a joint torque.
+   *
+   * @param[in] q Joint position.
+   * @param[in] rhs Right-hand side \f$b\f$.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return Solution \f$x\f$.
+   */
+  Eigen::Matrix<double, 7, 1> solveMass(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& rhs,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Gets the 4x4 pose matrices of all frames in base frame.
+   *
+   * The end effector and stiffness frames are derived from the flange pose instead of being
+   * calculated from scratch.
+   *
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return 4x4 pose matrices, indexed by Frame and stored contiguously.
+   */
+  std::array<Eigen::Matrix4d, kFrameCount> poses(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Writes the 4x4 pose matrices of all frames in base frame into the given output.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 4x4 pose matrices, column-major, indexed by Frame.
+   * Must hold 16 * kFrameCount elements.
+   */
+  void poses(
+      const double* q,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Gets the 6x7 Jacobians of all frames, each relative to its own frame.
+   *
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return 6x7 Jacobians, column-major, indexed by Frame and stored contiguously.
+   */
+  std::array<Eigen::Matrix<double, 6, 7>, kFrameCount> bodyJacobians(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Writes the 6x7 Jacobians of all frames, each relative to its own frame, into the given
+   * output.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major, indexed by Frame.
+   * Must hold 42 * kFrameCount elements.
+   */
+  void bodyJacobians(
+      const double* q,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Gets the 6x7 Jacobians of all frames relative to the base frame.
+   *
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return 6x7 Jacobians, column-major, indexed by Frame and stored contiguously.
+   */
+  std::array<Eigen::Matrix<double, 6, 7>, kFrameCount> zeroJacobians(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Writes the 6x7 Jacobians of all frames relative to the base frame into the given output.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major, indexed by Frame.
+   * Must hold 42 * kFrameCount elements.
+   */
+  void zeroJacobians(
+      const double* q,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Calculates end effector pose, end effector zero Jacobian, mass matrix, Coriolis and gravity
+   * vector for one state in a single call.
+   *
+   * All results are written into the given, preallocated state.
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[out] state Receives the calculated quantities.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  void computeState(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      DynamicsState& state,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const noexcept;
+
+  /**
+   * Calculates the operational space inertia matrix, the dynamically consistent generalized
+   * inverse, the task space Coriolis and gravity forces and the null-space projector of the
+   * given frame for one state in a single call.
+   *
+   * The mass matrix is factorized once and shared by all quantities. The Jacobian's time
+   * derivative is calculated natively, see zeroJacobianDot(). The Jacobian of the given frame
+   * must have full row rank, which excludes the frames of joints 1 to 5 and singular
+   * configurations. All results are written into the given, preallocated state.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[out] state Receives the calculated quantities.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void operationalSpace(
+      Frame frame,
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      OperationalSpaceState& state,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const;
+
+  /**
+   * Writes the 4x4 pose matrix for the given frame in base frame into the given output.
+   *
+   * The model library writes directly into the output, nothing is allocated or copied.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 4x4 pose matrix, column-major. Must hold 16 elements.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool pose(
+      Frame frame,
+      const double* q,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the 4x4 pose matrix for the given frame in base frame into the given output.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   * @param[out] output 4x4 pose matrix, must be stored contiguously.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool pose(
+      Frame frame,
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE,
+      const Eigen::Matrix4d& EE_T_K,
+      Eigen::Ref<Eigen::Matrix4d, 0, Eigen::OuterStride<4>> output)
+      const noexcept;
+
+  /**
+   * Writes the 6x7 Jacobian for the given frame, relative to that frame, into the given
+   * output.
+   *
+   * The model library writes directly into the output, nothing is allocated or copied.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 6x7 Jacobian, column-major. Must hold 42 elements.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool bodyJacobian(
+      Frame frame,
+      const double* q,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the 6x7 Jacobian for the given frame, relative to that frame, into the given
+   * output.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   * @param[out] output 6x7 Jacobian, must be stored contiguously.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool bodyJacobian(
+      Frame frame,
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE,
+      const Eigen::Matrix4d& EE_T_K,
+      Eigen::Ref<Eigen::Matrix<double, 6, 7>, 0, Eigen::OuterStride<6>> output)
+      const noexcept;
+
+  /**
+   * Writes the 6x7 Jacobian for the given frame relative to the base frame into the given
+   * output.
+   *
+   * The model library writes directly into the output, nothing is allocated or copied.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 6x7 Jacobian, column-major. Must hold 42 elements.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool zeroJacobian(
+      Frame frame,
+      const double* q,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the 6x7 Jacobian for the given frame relative to the base frame into the given
+   * output.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   * @param[out] output 6x7 Jacobian, must be stored contiguously.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool zeroJacobian(
+      Frame frame,
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix4d& F_T_EE,
+      const Eigen::Matrix4d& EE_T_K,
+      Eigen::Ref<Eigen::Matrix<double, 6, 7>, 0, Eigen::OuterStride<6>> output)
+      const noexcept;
+
+  /**
+   * Writes the time derivative of the 6x7 Jacobian for the given frame, relative to that
+   * frame, into the given output, see bodyJacobianDot().
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] dq Joint velocity, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 6x7 Jacobian derivative, column-major. Must hold 42 elements.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool bodyJacobianDot(
+      Frame frame,
+      const double* q,
+      const double* dq,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the time derivative of the 6x7 Jacobian for the given frame relative to the base
+   * frame into the given output, see zeroJacobianDot().
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] dq Joint velocity, 7 elements.
+   * @param[in] F_T_EE End effector in flange frame, vectorized 4x4 matrix, column-major.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame, vectorized 4x4 matrix,
+   * column-major.
+   * @param[out] output Vectorized 6x7 Jacobian derivative, column-major. Must hold 42 elements.
+   *
+   * @return False if the given frame is invalid, in which case output is not written.
+   */
+  bool zeroJacobianDot(
+      Frame frame,
+      const double* q,
+      const double* dq,
+      const double* F_T_EE,
+      const double* EE_T_K,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the 7x7 mass matrix into the given output. Unit: \f$[kg \times m^2]\f$.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+   * 3 elements. Unit: \f$[m]\f$.
+   * @param[out] output Vectorized 7x7 mass matrix, column-major. Must hold 49 elements.
+   */
+  void mass(
+      const double* q,
+      const double* I_total,
+      double m_total,
+      const double* F_x_Ctotal,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the 7x7 mass matrix into the given output. Unit: \f$[kg \times m^2]\f$.
+   *
+   * @param[in] q Joint position.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[out] output 7x7 mass matrix, must be stored contiguously.
+   */
+  void mass(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix3d& I_total,
+      double m_total,
+      const Eigen::Vector3d& F_x_Ctotal,
+      Eigen::Ref<Eigen::Matrix<double, 7, 7>, 0, Eigen::OuterStride<7>> output)
+      const noexcept;
+
+  /**
+   * Writes the Coriolis force vector into the given output. Unit: \f$[Nm]\f$.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] dq Joint velocity, 7 elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+   * 3 elements. Unit: \f$[m]\f$.
+   * @param[out] output Coriolis force vector. Must hold 7 elements.
+   */
+  void coriolis(
+      const double* q,
+      const double* dq,
+      const double* I_total,
+      double m_total,
+      const double* F_x_Ctotal,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the Coriolis force vector into the given output. Unit: \f$[Nm]\f$.
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[out] output Coriolis force vector.
+   */
+  void coriolis(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      const Eigen::Matrix3d& I_total,
+      double m_total,
+      const Eigen::Vector3d& F_x_Ctotal,
+      Eigen::Ref<Eigen::Matrix<double, 7, 1>> output)
+      const noexcept;
+
+  /**
+   * Writes the gravity vector into the given output. Unit: \f$[Nm]\f$.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+   * 3 elements. Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+   * @param[out] output Gravity vector. Must hold 7 elements.
+   */
+  void gravity(
+      const double* q,
+      double m_total,
+      const double* F_x_Ctotal,
+      const double* gravity_earth,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the gravity vector into the given output. Unit: \f$[Nm]\f$.
+   *
+   * @param[in] q Joint position.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   * @param[out] output Gravity vector.
+   */
+  void gravity(
+      const Eigen::Matrix<double, 7, 1>& q,
+      double m_total,
+      const Eigen::Vector3d& F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth,
+      Eigen::Ref<Eigen::Matrix<double, 7, 1>> output)
+      const noexcept;
+
+  /**
+   * Writes the joint torques for the given joint acceleration into the given output, see
+   * inverseDynamics(). Unit: \f$[Nm]\f$.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] dq Joint velocity, 7 elements.
+   * @param[in] ddq Joint acceleration, 7 elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+   * 3 elements. Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+   * @param[out] output Joint torques. Must hold 7 elements.
+   */
+  void inverseDynamics(
+      const double* q,
+      const double* dq,
+      const double* ddq,
+      const double* I_total,
+      double m_total,
+      const double* F_x_Ctotal,
+      const double* gravity_earth,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the joint acceleration for the given joint torques into the given output, see
+   * forwardDynamics(). Unit: \f$[\frac{rad}{s^2}]\f$.
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] dq Joint velocity, 7 elements.
+   * @param[in] tau Joint torques, 7 elements. Unit: \f$[Nm]\f$.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+   * 3 elements. Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector, 3 elements. Unit: \f$\frac{m}{s^2}\f$.
+   * @param[out] output Joint acceleration. Must hold 7 elements.
+   */
+  void forwardDynamics(
+      const double* q,
+      const double* dq,
+      const double* tau,
+      const double* I_total,
+      double m_total,
+      const double* F_x_Ctotal,
+      const double* gravity_earth,
+      double* output)
+      const noexcept;
+
+  /**
+   * Writes the 7x7 Coriolis matrix into the given output, see coriolisMatrix().
+   *
+   * @param[in] q Joint position, 7 elements.
+   * @param[in] dq Joint velocity, 7 elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass, given as vectorized 3x3 column-major matrix. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load,
+   * 3 elements. Unit: \f$[m]\f$.
+   * @param[out] output Vectorized 7x7 Coriolis matrix, column-major. Must hold 49 elements.
+   */
+  void coriolisMatrix(
+      const double* q,
+      const double* dq,
+      const double* I_total,
+      double m_total,
+      const double* F_x_Ctotal,
+      double* output)
+      const noexcept;
+
+  /**
+   * Gets the 4x4 pose matrices for the given frame for a batch of joint positions.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 4x4 pose matrices, column-major. Must hold 16 * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * For a native Model, see native(), the vectorized kernel kinematics::poseBatch is used.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void poseBatch(
+      Frame frame,
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const;
+
+  /**
+   * Gets the 4x4 pose matrices for the given frame for a batch of joint positions with the given
+   * instruction set, see poseBatch(Frame, const double*, std::size_t, double*,
+   * const Eigen::Matrix4d&, const Eigen::Matrix4d&) const.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 4x4 pose matrices, column-major. Must hold 16 * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   * @param[in] instruction_set Instruction set of the vectorized kernel of a native Model. Falls
+   * back to kinematics::bestInstructionSet() if not supported, ignored by a Model backed by the
+   * model library.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void poseBatch(
+      Frame frame,
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE,
+      const Eigen::Matrix4d& EE_T_K,
+      kinematics::InstructionSet instruction_set)
+      const;
+
+  /**
+   * Gets the 4x4 pose matrices of all frames for a batch of joint positions.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 4x4 pose matrices, column-major, indexed by sample and then
+   * by Frame. Must hold 16 * kFrameCount * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   */
+  void posesBatch(
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Gets the 6x7 Jacobians for the given frame, relative to that frame, for a batch of
+   * joint positions.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major. Must hold 42 * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void bodyJacobianBatch(
+      Frame frame,
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const;
+
+  /**
+   * Gets the 6x7 Jacobians for the given frame relative to the base frame for a batch of
+   * joint positions.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major. Must hold 42 * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void zeroJacobianBatch(
+      Frame frame,
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const;
+
+  /**
+   * Gets the time derivatives of the 6x7 Jacobians for the given frame, relative to that frame,
+   * for a batch of joint states, see bodyJacobianDot().
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint states in the batch.
+   * @param[out] output Vectorized 6x7 Jacobian derivatives, column-major. Must hold 42 * n
+   * elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void bodyJacobianDotBatch(
+      Frame frame,
+      const double* q,
+      const double* dq,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const;
+
+  /**
+   * Gets the time derivatives of the 6x7 Jacobians for the given frame relative to the base
+   * frame for a batch of joint states, see zeroJacobianDot().
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint states in the batch.
+   * @param[out] output Vectorized 6x7 Jacobian derivatives, column-major. Must hold 42 * n
+   * elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void zeroJacobianDotBatch(
+      Frame frame,
+      const double* q,
+      const double* dq,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const;
+
+  /**
+   * Gets the 6x7 Jacobians of all frames, each relative to its own frame, for a batch of
+   * joint positions.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major, indexed by sample and then by
+   * Frame. Must hold 42 * kFrameCount * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   */
+  void bodyJacobiansBatch(
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Gets the 6x7 Jacobians of all frames relative to the base frame for a batch of joint
+   * positions.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major, indexed by sample and then by
+   * Frame. Must hold 42 * kFrameCount * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   */
+  void zeroJacobiansBatch(
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+      const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K)
+      const noexcept;
+
+  /**
+   * Calculates the 7x7 mass matrices for a batch of joint positions.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 7x7 mass matrices, column-major. Must hold 49 * n elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void massBatch(
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Calculates the Coriolis force vectors for a batch of joint states.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint states in the batch.
+   * @param[out] output Coriolis force vectors. Must hold 7 * n elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void coriolisBatch(
+      const double* q,
+      const double* dq,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Calculates the gravity vectors for a batch of joint positions.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Gravity vectors. Must hold 7 * n elements.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  void gravityBatch(
+      const double* q,
+      std::size_t n,
+      double* output,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const noexcept;
+
+  /**
+   * Calculates the joint accelerations for a batch of joint states and torques, see
+   * forwardDynamics().
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] tau Joint torques, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint states in the batch.
+   * @param[out] output Joint accelerations. Must hold 7 * n elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  void forwardDynamicsBatch(
+      const double* q,
+      const double* dq,
+      const double* tau,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const noexcept;
+
+  /**
+   * Calculates the joint torques \f$M(q) \ddot{q} + C(q, \dot{q}) \dot{q} + g(q)\f$ for a batch of
+   * joint states and accelerations.
+   *
+   * The torques are calculated like inverseDynamics(). A native Model, see native(), shares the
+   * rigid bodies of the load among all samples.
+   *
+   * The samples are processed in order with a single pass over the inputs and the output, so
+   * all arrays may be memory-mapped files of arbitrary length.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] ddq Joint accelerations, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint states in the batch.
+   * @param[out] output Joint torques. Must hold 7 * n elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  void inverseDynamicsBatch(
+      const double* q,
+      const double* dq,
+      const double* ddq,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const noexcept;
+
+  /**
+   * Streams the joint torques along a trajectory to the given sink in chunks, see
+   * inverseDynamicsBatch() for how they are calculated.
+   *
+   * Only one chunk of torques is held in memory, so trajectories of any length, e.g.
+   * memory-mapped logs, are evaluated with a constant working set. The default chunk of 1024
+   * samples keeps the torques and the inputs they are computed from within the L2 cache.
+   * Exceptions thrown by the sink abort the evaluation and are propagated.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] ddq Joint accelerations, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of samples of the trajectory.
+   * @param[in] sink Receives the torques of each chunk in order.
+   * @param[in] chunk_size Maximum number of samples per chunk, at least one.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   *
+   * @throw std::invalid_argument if chunk_size is zero.
+   */
+  void inverseDynamicsTrajectory(
+      const double* q,
+      const double* dq,
+      const double* ddq,
+      std::size_t n,
+      const TorqueSink& sink,
+      std::size_t chunk_size = 1024,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81}) const;
+
+  /**
+   * Factorizes the 7x7 mass matrices for a batch of joint positions, see massFactorization().
+   *
+   * The factorizations are written into a caller-provided contiguous arena, e.g. a
+   * std::vector<MassFactorization> that is reused across batches, without heap allocation.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Factorizations. Must hold n elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void massFactorizationBatch(
+      const double* q,
+      std::size_t n,
+      MassFactorization* output,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Calculates the inverse 7x7 mass matrices for a batch of joint positions, see inverseMass().
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 7x7 inverse mass matrices, column-major. Must hold 49 * n
+   * elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void inverseMassBatch(
+      const double* q,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /**
+   * Solves \f$M(q) x = b\f$ for a batch of joint positions and right-hand sides, see
+   * solveMass().
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] rhs Right-hand sides, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Solutions. Must hold 7 * n elements, may alias rhs.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void solveMassBatch(
+      const double* q,
+      const double* rhs,
+      std::size_t n,
+      double* output,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal)
+      const noexcept;
+
+  /// @cond DO_NOT_DOCUMENT
+  Model(const Model&) = delete;
+  Model& operator=(const Model&) = delete;
+  /// @endcond
+
+ private:
+  explicit Model(std::unique_ptr<ModelLibrary> library) noexcept;
 
- private:
   std::unique_ptr<ModelLibrary> library_;
 };
 
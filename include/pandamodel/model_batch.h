@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/model.h"
+#include "pandamodel/thread_pool.h"
+
+/**
+ * @file model_batch.h
+ * Contains the multi-threaded batch evaluation of a Model.
+ */
+
+namespace panda_model {
+
+/**
+ * Evaluates a Model for large batches of joint states on a work-stealing thread pool.
+ *
+ * Joint states are passed as n consecutive vectors of 7 elements each and results are
+ * written into caller-provided output arrays with the same layout as the batch methods
+ * of Model. The Model must outlive the ModelBatch.
+ */
+class ModelBatch {
+ public:
+  /**
+   * Creates a batch evaluator and starts its worker threads.
+   *
+   * @param[in] model Model to evaluate.
+   * @param[in] num_threads Number of threads, zero selects the number of hardware threads.
+   * @param[in] grain_size Number of joint states evaluated per scheduled chunk.
+   */
+  explicit ModelBatch(const Model& model, std::size_t num_threads = 0,
+                      std::size_t grain_size = 256);
+
+  /**
+   * Gets the number of threads used for evaluation.
+   *
+   * @return Number of threads.
+   */
+  std::size_t numThreads() const noexcept;
+
+  /**
+   * Gets the 4x4 pose matrices for the given frame, see Model::poseBatch.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 4x4 pose matrices, column-major. Must hold 16 * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void pose(Frame frame,
+            const double* q,
+            std::size_t n,
+            double* output,
+            const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+            const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Gets the 6x7 Jacobians relative to the given frame, see Model::bodyJacobianBatch.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major. Must hold 42 * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void bodyJacobian(Frame frame,
+                    const double* q,
+                    std::size_t n,
+                    double* output,
+                    const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                    const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Gets the 6x7 Jacobians relative to the base frame, see Model::zeroJacobianBatch.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 6x7 Jacobians, column-major. Must hold 42 * n elements.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  void zeroJacobian(Frame frame,
+                    const double* q,
+                    std::size_t n,
+                    double* output,
+                    const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                    const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Calculates the 7x7 mass matrices, see Model::massBatch.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Vectorized 7x7 mass matrices, column-major. Must hold 49 * n elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void mass(const double* q,
+            std::size_t n,
+            double* output,
+            const Eigen::Matrix3d& I_total = Defaults::I_total,
+            double m_total = Defaults::m_total,
+            const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal);
+
+  /**
+   * Calculates the Coriolis force vectors, see Model::coriolisBatch.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq Joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint states in the batch.
+   * @param[out] output Coriolis force vectors. Must hold 7 * n elements.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   */
+  void coriolis(const double* q,
+                const double* dq,
+                std::size_t n,
+                double* output,
+                const Eigen::Matrix3d& I_total = Defaults::I_total,
+                double m_total = Defaults::m_total,
+                const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal);
+
+  /**
+   * Calculates the gravity vectors, see Model::gravityBatch.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions in the batch.
+   * @param[out] output Gravity vectors. Must hold 7 * n elements.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  void gravity(const double* q,
+               std::size_t n,
+               double* output,
+               double m_total = Defaults::m_total,
+               const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+               const Eigen::Vector3d& gravity_earth = {0., 0., -9.81});
+
+ private:
+  const Model& model_;
+  ThreadPool pool_;
+  std::size_t grain_size_;
+};
+
+}  // namespace panda_model
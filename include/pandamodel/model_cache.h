@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/model.h"
+
+/**
+ * @file model_cache.h
+ * Contains a result cache for repeated Model queries.
+ */
+
+namespace panda_model {
+
+/**
+ * Hit and miss counters of a ModelCache.
+ */
+struct CacheStatistics {
+  /// Number of queries answered from the cache.
+  uint64_t hits = 0;
+  /// Number of queries that were evaluated by the model.
+  uint64_t misses = 0;
+};
+
+/**
+ * Remembers the last few results of each Model query.
+ *
+ * A query is answered from the cache if all of its arguments are bitwise identical to those of
+ * a remembered query, so independent modules querying the same state within one control cycle
+ * trigger only one evaluation. Each query type keeps its own entries and the least recently
+ * evaluated entry is replaced on a miss.
+ *
+ * The cache is not thread-safe, use one instance per thread. The Model must outlive the cache.
+ */
+class ModelCache {
+ public:
+  /**
+   * Enumerates the cached query types.
+   */
+  enum class Query {
+    kPose,
+    kBodyJacobian,
+    kZeroJacobian,
+    kMass,
+    kCoriolis,
+    kGravity,
+    kMassFactorization
+  };
+
+  /**
+   * Creates an empty cache.
+   *
+   * @param[in] model Model to evaluate on a miss.
+   * @param[in] capacity Number of results remembered per query type.
+   */
+  explicit ModelCache(const Model& model, std::size_t capacity = 4);
+
+  /**
+   * Destroys the cache.
+   */
+  ~ModelCache() noexcept;
+
+  /**
+   * Gets the 4x4 pose matrix for the given frame in base frame, see Model::pose.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return 4x4 pose matrix.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix4d pose(Frame frame,
+                       const Eigen::Matrix<double, 7, 1>& q,
+                       const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                       const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Gets the 6x7 Jacobian for the given frame, relative to that frame, see Model::bodyJacobian.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return 6x7 Jacobian.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix<double, 6, 7> bodyJacobian(Frame frame,
+                                           const Eigen::Matrix<double, 7, 1>& q,
+                                           const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                                           const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Gets the 6x7 Jacobian for the given frame relative to the base frame,
+   * see Model::zeroJacobian.
+   *
+   * @param[in] frame The desired frame.
+   * @param[in] q Joint position.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return 6x7 Jacobian.
+   *
+   * @throw std::invalid_argument if the given frame is invalid.
+   */
+  Eigen::Matrix<double, 6, 7> zeroJacobian(Frame frame,
+                                           const Eigen::Matrix<double, 7, 1>& q,
+                                           const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                                           const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Calculates the 7x7 mass matrix, see Model::mass.
+   *
+   * @param[in] q Joint position.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return 7x7 mass matrix.
+   */
+  Eigen::Matrix<double, 7, 7> mass(const Eigen::Matrix<double, 7, 1>& q,
+                                   const Eigen::Matrix3d& I_total = Defaults::I_total,
+                                   double m_total = Defaults::m_total,
+                                   const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal);
+
+  /**
+   * Factorizes the 7x7 mass matrix, see Model::massFactorization.
+   *
+   * @param[in] q Joint position.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return Factorization of the mass matrix.
+   */
+  MassFactorization massFactorization(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal);
+
+  /**
+   * Calculates the inverse of the 7x7 mass matrix from the remembered factorization, see
+   * Model::inverseMass.
+   *
+   * @param[in] q Joint position.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return 7x7 inverse mass matrix.
+   */
+  Eigen::Matrix<double, 7, 7> inverseMass(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal);
+
+  /**
+   * Solves \f$M(q) x = b\f$ with the remembered factorization, see Model::solveMass. Only the
+   * configuration and load are part of the key, so different right-hand sides share one
+   * factorization.
+   *
+   * @param[in] q Joint position.
+   * @param[in] rhs Right-hand side \f$b\f$.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return Solution \f$x\f$.
+   */
+  Eigen::Matrix<double, 7, 1> solveMass(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& rhs,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal);
+
+  /**
+   * Calculates the Coriolis force vector, see Model::coriolis.
+   *
+   * @param[in] q Joint position.
+   * @param[in] dq Joint velocity.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   *
+   * @return Coriolis force vector.
+   */
+  Eigen::Matrix<double, 7, 1> coriolis(
+      const Eigen::Matrix<double, 7, 1>& q,
+      const Eigen::Matrix<double, 7, 1>& dq,
+      const Eigen::Matrix3d& I_total = Defaults::I_total,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal);
+
+  /**
+   * Calculates the gravity vector, see Model::gravity.
+   *
+   * @param[in] q Joint position.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   *
+   * @return Gravity vector.
+   */
+  Eigen::Matrix<double, 7, 1> gravity(
+      const Eigen::Matrix<double, 7, 1>& q,
+      double m_total = Defaults::m_total,
+      const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+      const Eigen::Vector3d& gravity_earth = {0., 0., -9.81});
+
+  /**
+   * Gets the hit and miss counters of the given query type.
+   *
+   * @param[in] query Query type.
+   *
+   * @return Counters since construction or the last call to clear().
+   */
+  CacheStatistics statistics(Query query) const noexcept;
+
+  /**
+   * Gets the hit and miss counters summed over all query types.
+   *
+   * @return Counters since construction or the last call to clear().
+   */
+  CacheStatistics statistics() const noexcept;
+
+  /**
+   * Forgets all remembered results and resets the counters.
+   */
+  void clear() noexcept;
+
+  /// @cond DO_NOT_DOCUMENT
+  ModelCache(const ModelCache&) = delete;
+  ModelCache& operator=(const ModelCache&) = delete;
+  /// @endcond
+
+ private:
+  struct Entries;
+
+  const Model& model_;
+  std::unique_ptr<Entries> entries_;
+};
+
+}  // namespace panda_model
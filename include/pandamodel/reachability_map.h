@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/kinematic_parameters.h"
+#include "pandamodel/model.h"
+
+/**
+ * @file reachability_map.h
+ * Contains a voxelized map of the reachable workspace and its manipulability.
+ */
+
+namespace panda_model {
+
+/**
+ * Sampling parameters of ReachabilityMap::generate.
+ */
+struct ReachabilityOptions {
+  /// Frame whose positions are binned into voxels.
+  Frame frame = Frame::kEndEffector;
+  /// Lower corner of the voxel grid in the base frame. Unit: \f$[m]\f$.
+  Eigen::Vector3d lower{-1.1, -1.1, -0.8};
+  /// Upper corner of the voxel grid in the base frame, rounded up to whole voxels.
+  /// Unit: \f$[m]\f$.
+  Eigen::Vector3d upper{1.1, 1.1, 1.4};
+  /// Edge length of the cubic voxels. Unit: \f$[m]\f$.
+  double resolution = 0.05;
+  /// Number of sampled joint positions.
+  std::uint64_t samples = 1000000;
+  /// Seed of the random number generator.
+  std::uint64_t seed = 0;
+  /// Lower joint position limits the samples are drawn within. Unit: \f$[rad]\f$.
+  Eigen::Matrix<double, 7, 1> q_min{
+      Eigen::Map<const Eigen::Matrix<double, 7, 1>>(kinematics::kJointPositionMin)};
+  /// Upper joint position limits the samples are drawn within. Unit: \f$[rad]\f$.
+  Eigen::Matrix<double, 7, 1> q_max{
+      Eigen::Map<const Eigen::Matrix<double, 7, 1>>(kinematics::kJointPositionMax)};
+};
+
+/**
+ * Voxel grid over the workspace that records, per voxel, how often uniformly sampled joint
+ * positions place a frame inside it and the manipulability of those joint positions.
+ *
+ * The manipulability of a joint position is \f$\sqrt{\det(J J^T)}\f$ and its condition number
+ * is \f$\sigma_{max} / \sigma_{min}\f$ for the zero Jacobian \f$J\f$ of the frame and its
+ * singular values \f$\sigma\f$. Both mix the translational and rotational rows of \f$J\f$
+ * without weighting. The condition number is infinite at singularities.
+ *
+ * Voxels are stored in C order of their (x, y, z) indices, so the statistics are arrays of
+ * shape() with z varying fastest. save() writes the grid and the statistics in single
+ * precision to a compact binary file in native byte order.
+ */
+class ReachabilityMap {
+ public:
+  /**
+   * Samples joint positions uniformly within the joint limits on a work-stealing thread pool
+   * and accumulates the statistics of the voxels their frame positions fall into. Every chunk
+   * of samples draws from its own generator seeded with the seed and the chunk's offset, so
+   * the samples only depend on the options and the grain size, not on the number of threads.
+   * The statistics of all voxels are updated lock-free with atomic operations. Samples outside
+   * the grid are dropped.
+   *
+   * @param[in] model Model to calculate the poses and Jacobians with.
+   * @param[in] options Sampling parameters.
+   * @param[in] num_threads Number of threads, zero selects the number of hardware threads.
+   * @param[in] grain_size Number of joint positions sampled per scheduled chunk.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   *
+   * @return Map of the sampled joint positions.
+   *
+   * @throw std::invalid_argument if the frame, the grid or the number of samples is invalid.
+   */
+  static ReachabilityMap generate(const Model& model,
+                                  const ReachabilityOptions& options = ReachabilityOptions(),
+                                  std::size_t num_threads = 0,
+                                  std::size_t grain_size = 1024,
+                                  const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                                  const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+  /**
+   * Reads a map written by save().
+   *
+   * @param[in] path Path of the map file.
+   *
+   * @return Map stored in the file.
+   *
+   * @throw std::runtime_error if the file cannot be read or is not a valid map.
+   */
+  static ReachabilityMap load(const std::string& path);
+
+  /**
+   * Writes the map to a file that can be read by load().
+   *
+   * @param[in] path Path of the map file, overwritten if it exists.
+   *
+   * @throw std::runtime_error if the file cannot be written.
+   */
+  void save(const std::string& path) const;
+
+  /**
+   * Gets the frame whose positions are binned.
+   *
+   * @return Binned frame.
+   */
+  Frame frame() const noexcept;
+
+  /**
+   * Gets the lower corner of the voxel grid.
+   *
+   * @return Lower corner in the base frame. Unit: \f$[m]\f$.
+   */
+  const Eigen::Vector3d& lower() const noexcept;
+
+  /**
+   * Gets the edge length of the voxels.
+   *
+   * @return Resolution. Unit: \f$[m]\f$.
+   */
+  double resolution() const noexcept;
+
+  /**
+   * Gets the number of voxels along the x, y and z axes.
+   *
+   * @return Shape of the grid.
+   */
+  const std::array<std::size_t, 3>& shape() const noexcept;
+
+  /**
+   * Gets the number of voxels.
+   *
+   * @return Number of voxels.
+   */
+  std::size_t size() const noexcept;
+
+  /**
+   * Gets the number of joint positions the map was generated from, including those outside the
+   * grid.
+   *
+   * @return Number of samples.
+   */
+  std::uint64_t samples() const noexcept;
+
+  /**
+   * Gets the voxel containing the given position.
+   *
+   * @param[in] position Position in the base frame. Unit: \f$[m]\f$.
+   *
+   * @return Index of the voxel, size() if the position is outside the grid.
+   */
+  std::size_t index(const Eigen::Vector3d& position) const noexcept;
+
+  /**
+   * Gets the center of the given voxel.
+   *
+   * @param[in] index Index of the voxel, less than size().
+   *
+   * @return Center in the base frame. Unit: \f$[m]\f$.
+   */
+  Eigen::Vector3d center(std::size_t index) const noexcept;
+
+  /**
+   * Gets the number of samples per voxel, zero for unreachable voxels.
+   *
+   * @return Counts of size() elements.
+   */
+  const std::vector<std::uint32_t>& counts() const noexcept;
+
+  /**
+   * Gets the mean manipulability of the samples per voxel, zero for unreachable voxels.
+   *
+   * @return Mean manipulabilities of size() elements.
+   */
+  const std::vector<float>& meanManipulability() const noexcept;
+
+  /**
+   * Gets the largest manipulability of the samples per voxel, zero for unreachable voxels.
+   *
+   * @return Maximum manipulabilities of size() elements.
+   */
+  const std::vector<float>& maxManipulability() const noexcept;
+
+  /**
+   * Gets the smallest condition number of the samples per voxel, infinite for unreachable
+   * voxels.
+   *
+   * @return Minimum condition numbers of size() elements.
+   */
+  const std::vector<float>& minCondition() const noexcept;
+
+ private:
+  ReachabilityMap(Frame frame,
+                  const Eigen::Vector3d& lower,
+                  double resolution,
+                  const std::array<std::size_t, 3>& shape,
+                  std::uint64_t samples);
+
+  Frame frame_;
+  Eigen::Vector3d lower_;
+  double resolution_;
+  std::array<std::size_t, 3> shape_;
+  std::uint64_t samples_;
+  std::vector<std::uint32_t> counts_;
+  std::vector<float> mean_manipulability_;
+  std::vector<float> max_manipulability_;
+  std::vector<float> min_condition_;
+};
+
+}  // namespace panda_model
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/model.h"
+#include "pandamodel/thread_pool.h"
+
+/**
+ * @file rollout.h
+ * Contains the parallel forward simulation of a Model.
+ */
+
+namespace panda_model {
+
+/**
+ * Enumerates the integration schemes of Rollout.
+ */
+enum class Integrator {
+  /// Semi-implicit (symplectic) Euler: velocity first, then position with the new velocity.
+  kSemiImplicitEuler,
+  /// Classical fourth order Runge-Kutta.
+  kRungeKutta4
+};
+
+/**
+ * Calculates the joint torques of one rollout step from the current joint state.
+ *
+ * Called as policy(rollout, step, q, dq, tau) with the index of the rollout, the index of the
+ * step, the joint position and velocity of 7 elements each, and the output torques of 7
+ * elements. The torques are held constant during the step. The policy is called concurrently
+ * from several threads for different rollouts.
+ */
+using Policy = std::function<void(std::size_t, std::size_t, const double*, const double*,
+                                  double*)>;
+
+/**
+ * Integrates the equations of motion \f$M(q) \ddot{q} = \tau - C(q, \dot{q}) \dot{q} - g(q)\f$
+ * of a Model for batches of initial states on a work-stealing thread pool.
+ *
+ * The dynamics are evaluated with Model::mass, Model::coriolis and Model::gravity, so the
+ * rollouts use the model library if the Model has one. Trajectories are written into
+ * caller-provided arrays of n consecutive rollouts, each with steps + 1 consecutive vectors
+ * of 7 elements, starting with the initial state. The Model must outlive the Rollout.
+ */
+class Rollout {
+ public:
+  /**
+   * Creates a rollout engine and starts its worker threads.
+   *
+   * @param[in] model Model to simulate.
+   * @param[in] num_threads Number of threads, zero selects the number of hardware threads.
+   * @param[in] grain_size Number of rollouts integrated per scheduled chunk.
+   */
+  explicit Rollout(const Model& model, std::size_t num_threads = 0, std::size_t grain_size = 1);
+
+  /**
+   * Gets the number of threads used for integration.
+   *
+   * @return Number of threads.
+   */
+  std::size_t numThreads() const noexcept;
+
+  /**
+   * Integrates rollouts driven by the given torque sequences.
+   *
+   * @param[in] q0 Initial joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq0 Initial joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] tau Joint torques, n consecutive sequences of steps vectors of 7 elements each.
+   * Unit: \f$[Nm]\f$.
+   * @param[in] n Number of rollouts.
+   * @param[in] steps Number of integration steps per rollout.
+   * @param[in] dt Step size. Unit: \f$[s]\f$.
+   * @param[out] q Joint position trajectories. Must hold 7 * (steps + 1) * n elements.
+   * @param[out] dq Joint velocity trajectories. Must hold 7 * (steps + 1) * n elements.
+   * @param[in] integrator Integration scheme.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   */
+  void run(const double* q0,
+           const double* dq0,
+           const double* tau,
+           std::size_t n,
+           std::size_t steps,
+           double dt,
+           double* q,
+           double* dq,
+           Integrator integrator = Integrator::kRungeKutta4,
+           const Eigen::Matrix3d& I_total = Defaults::I_total,
+           double m_total = Defaults::m_total,
+           const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+           const Eigen::Vector3d& gravity_earth = {0., 0., -9.81});
+
+  /**
+   * Integrates rollouts driven by the given policy, which is evaluated once at the beginning
+   * of every step.
+   *
+   * @param[in] q0 Initial joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] dq0 Initial joint velocities, n consecutive vectors of 7 elements each.
+   * @param[in] policy Calculates the joint torques of each step, see Policy.
+   * @param[in] n Number of rollouts.
+   * @param[in] steps Number of integration steps per rollout.
+   * @param[in] dt Step size. Unit: \f$[s]\f$.
+   * @param[out] q Joint position trajectories. Must hold 7 * (steps + 1) * n elements.
+   * @param[out] dq Joint velocity trajectories. Must hold 7 * (steps + 1) * n elements.
+   * @param[out] tau Receives the joint torques returned by the policy, n consecutive sequences
+   * of steps vectors of 7 elements each. May be null.
+   * @param[in] integrator Integration scheme.
+   * @param[in] I_total Inertia of the attached total load including end effector, relative to
+   * center of mass. Unit: \f$[kg \times m^2]\f$.
+   * @param[in] m_total Weight of the attached total load including end effector.
+   * Unit: \f$[kg]\f$.
+   * @param[in] F_x_Ctotal Translation from flange to center of mass of the attached total load.
+   * Unit: \f$[m]\f$.
+   * @param[in] gravity_earth Earth's gravity vector. Unit: \f$\frac{m}{s^2}\f$.
+   *
+   * @throw Rethrows the first exception thrown by the policy.
+   */
+  void run(const double* q0,
+           const double* dq0,
+           const Policy& policy,
+           std::size_t n,
+           std::size_t steps,
+           double dt,
+           double* q,
+           double* dq,
+           double* tau = nullptr,
+           Integrator integrator = Integrator::kRungeKutta4,
+           const Eigen::Matrix3d& I_total = Defaults::I_total,
+           double m_total = Defaults::m_total,
+           const Eigen::Vector3d& F_x_Ctotal = Defaults::F_x_Ctotal,
+           const Eigen::Vector3d& gravity_earth = {0., 0., -9.81});
+
+ private:
+  const Model& model_;
+  ThreadPool pool_;
+  std::size_t grain_size_;
+};
+
+}  // namespace panda_model
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "pandamodel/defaults.h"
+#include "pandamodel/model.h"
+#include "pandamodel/thread_pool.h"
+
+/**
+ * @file self_collision.h
+ * Contains self-collision distances of the robot approximated by capsules.
+ */
+
+namespace panda_model {
+
+/**
+ * Capsule rigidly attached to a frame: all points within the radius of the segment between
+ * two end points.
+ */
+struct Capsule {
+  /// Frame the capsule is attached to.
+  Frame frame;
+  /// First end point of the segment in the frame. Unit: \f$[m]\f$.
+  Eigen::Vector3d a;
+  /// Second end point of the segment in the frame. Unit: \f$[m]\f$.
+  Eigen::Vector3d b;
+  /// Radius around the segment. Unit: \f$[m]\f$.
+  double radius;
+};
+
+/**
+ * Pair of indices into the capsules of a SelfCollision whose distance is checked.
+ */
+using CapsulePair = std::pair<std::size_t, std::size_t>;
+
+/**
+ * Calculates the minimum distance between pairs of link capsules for batches of joint positions
+ * on a work-stealing thread pool.
+ *
+ * The poses of all frames are evaluated once per joint position with Model::poses, so the model
+ * library is used if the Model has one. The distance of two capsules is the distance of their
+ * segments minus both radii and is negative for penetrating capsules. Its gradient with respect
+ * to the joint position is \f$n^T (J_a - J_b)\f$ for the unit vector \f$n\f$ between the closest
+ * points and the translational zero Jacobians \f$J_a\f$ and \f$J_b\f$ of the closest points,
+ * which are built from the same poses. The Model must outlive the SelfCollision.
+ */
+class SelfCollision {
+ public:
+  /**
+   * Gets capsules that cover the links of the robot and the default hand, one per frame from
+   * Frame::kJoint1 to Frame::kFlange and a second one for the wrist of the fifth link.
+   *
+   * @return Default capsules.
+   */
+  static std::vector<Capsule> defaultCapsules();
+
+  /**
+   * Gets the pairs of defaultCapsules() whose frames are at least three joints apart. Closer
+   * capsules either overlap around their common joints by construction or cannot touch.
+   *
+   * @return Default pairs.
+   */
+  static std::vector<CapsulePair> defaultPairs();
+
+  /**
+   * Creates a self-collision checker and starts its worker threads.
+   *
+   * @param[in] model Model to calculate the frame poses with.
+   * @param[in] capsules Capsules attached to the frames.
+   * @param[in] pairs Pairs of capsules whose distances are checked.
+   * @param[in] num_threads Number of threads, zero selects the number of hardware threads.
+   * @param[in] grain_size Number of joint positions evaluated per scheduled chunk.
+   *
+   * @throw std::invalid_argument if a capsule has an invalid frame or a pair has an invalid
+   * index.
+   */
+  explicit SelfCollision(const Model& model,
+                         std::vector<Capsule> capsules = defaultCapsules(),
+                         std::vector<CapsulePair> pairs = defaultPairs(),
+                         std::size_t num_threads = 0,
+                         std::size_t grain_size = 16);
+
+  /**
+   * Gets the number of threads used for distance queries.
+   *
+   * @return Number of threads.
+   */
+  std::size_t numThreads() const noexcept;
+
+  /**
+   * Gets the capsules attached to the frames.
+   *
+   * @return Capsules.
+   */
+  const std::vector<Capsule>& capsules() const noexcept;
+
+  /**
+   * Gets the pairs of capsules whose distances are checked.
+   *
+   * @return Pairs of capsule indices.
+   */
+  const std::vector<CapsulePair>& pairs() const noexcept;
+
+  /**
+   * Calculates the minimum distance over all pairs for a batch of joint positions.
+   *
+   * @param[in] q Joint positions, n consecutive vectors of 7 elements each.
+   * @param[in] n Number of joint positions.
+   * @param[out] distances Minimum distances. Must hold n elements. Infinite if there are no
+   * pairs. Unit: \f$[m]\f$.
+   * @param[out] gradients Gradients of the minimum distances with respect to the joint
+   * positions. Must hold 7 * n elements, may be null.
+   * @param[out] closest Index into pairs() of the closest pair, the number of pairs if there
+   * are none. Must hold n elements, may be null.
+   * @param[in] F_T_EE End effector in flange frame.
+   * @param[in] EE_T_K Stiffness frame K in the end effector frame.
+   */
+  void distance(const double* q,
+                std::size_t n,
+                double* distances,
+                double* gradients = nullptr,
+                std::size_t* closest = nullptr,
+                const Eigen::Matrix4d& F_T_EE = Defaults::F_T_EE,
+                const Eigen::Matrix4d& EE_T_K = Defaults::EE_T_K);
+
+ private:
+  const Model& model_;
+  std::vector<Capsule> capsules_;
+  std::vector<CapsulePair> pairs_;
+  ThreadPool pool_;
+  std::size_t grain_size_;
+};
+
+}  // namespace panda_model
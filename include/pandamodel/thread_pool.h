@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+/**
+ * @file thread_pool.h
+ * Contains a work-stealing thread pool for batch evaluation.
+ */
+
+namespace panda_model {
+
+/**
+ * Fixed set of worker threads that cooperatively process index ranges.
+ *
+ * The range of a parallelFor() call is cut into chunks that are distributed evenly
+ * among the participating threads. A thread that runs out of chunks steals half of the
+ * remaining chunks of another thread, so uneven per-chunk cost does not leave cores idle.
+ * The calling thread participates in the work.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Starts the worker threads.
+   *
+   * @param[in] num_threads Number of threads to process work with, including the calling
+   * thread. Zero selects the number of hardware threads.
+   */
+  explicit ThreadPool(std::size_t num_threads = 0);
+
+  /**
+   * Stops and joins the worker threads.
+   */
+  ~ThreadPool() noexcept;
+
+  /**
+   * Gets the number of threads processing work, including the calling thread.
+   *
+   * @return Number of threads.
+   */
+  std::size_t size() const noexcept;
+
+  /**
+   * Calls the given function for consecutive chunks covering the range [0, n) and blocks
+   * until all chunks have been processed.
+   *
+   * Concurrent calls are serialized. Must not be called from within the given function.
+   *
+   * @param[in] n Size of the range.
+   * @param[in] grain_size Maximum number of elements per chunk.
+   * @param[in] function Called as function(begin, end) for each chunk.
+   *
+   * @throw Rethrows the first exception thrown by the given function.
+   */
+  void parallelFor(std::size_t n,
+                   std::size_t grain_size,
+                   const std::function<void(std::size_t, std::size_t)>& function);
+
+  /// @cond DO_NOT_DOCUMENT
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  /// @endcond
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace panda_model
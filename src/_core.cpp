@@ -1,14 +1,29 @@
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
 
 #include "library_downloader.h"
 #include "network.h"
+#include "pandamodel/bound_model.h"
 #include "pandamodel/defaults.h"
+#include "pandamodel/ik_seed_index.h"
+#include "pandamodel/inverse_kinematics.h"
+#include "pandamodel/kinematics_batch.h"
+#include "pandamodel/linearization.h"
+#include "pandamodel/mass_factorization.h"
 #include "pandamodel/model.h"
+#include "pandamodel/model_batch.h"
+#include "pandamodel/model_cache.h"
+#include "pandamodel/reachability_map.h"
+#include "pandamodel/rollout.h"
+#include "pandamodel/self_collision.h"
+#include "pandamodel/thread_pool.h"
 #include "service_types.h"
 
 using research_interface::robot::Connect;
@@ -51,6 +66,89 @@ std::string downloadLibrary(const std::string &hostname,
                            path + "\" exist?");
 }
 
+/// Contiguous row-major array, e.g. a batch of joint positions of shape (N,7).
+using BatchArray =
+    py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Checks that the given array is a batch of shape (N,7) and returns N.
+size_t batchSize(const BatchArray &array, const std::string &name) {
+  if (array.ndim() != 2 || array.shape(1) != 7) {
+    throw std::invalid_argument("Expected " + name +
+                                " to be an array of shape (N,7).");
+  }
+  return static_cast<size_t>(array.shape(0));
+}
+
+/// Allocates an array of shape (*leading,rows,cols) whose matrices are stored
+/// column-major, matching the memory layout of the model library.
+py::array_t<double> matrixStack(const std::vector<size_t> &leading,
+                                size_t rows, size_t cols) {
+  std::vector<py::ssize_t> shape(leading.begin(), leading.end());
+  shape.push_back(static_cast<py::ssize_t>(rows));
+  shape.push_back(static_cast<py::ssize_t>(cols));
+  std::vector<py::ssize_t> strides(shape.size());
+  strides[shape.size() - 2] = sizeof(double);
+  strides[shape.size() - 1] = static_cast<py::ssize_t>(rows * sizeof(double));
+  py::ssize_t stride = static_cast<py::ssize_t>(rows * cols * sizeof(double));
+  for (size_t i = leading.size(); i-- > 0;) {
+    strides[i] = stride;
+    stride *= shape[i];
+  }
+  return py::array_t<double>(shape, strides);
+}
+
+/// Allocates an (N,rows,cols) array of column-major matrices.
+py::array_t<double> matrixBatch(size_t n, size_t rows, size_t cols) {
+  return matrixStack({n}, rows, cols);
+}
+
+/// Allocates an (N,7) array.
+py::array_t<double> vectorBatch(size_t n) {
+  return py::array_t<double>(std::vector<py::ssize_t>{
+      static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(7)});
+}
+
+/// Returns the given (N,7) output array, e.g. a numpy.memmap, or allocates one
+/// if none is given. Given arrays are written in place, so they must be
+/// writable C-contiguous float64 arrays.
+py::array_t<double> vectorBatch(const py::object &out, size_t n) {
+  if (out.is_none()) {
+    return vectorBatch(n);
+  }
+  if (!py::isinstance<py::array_t<double>>(out)) {
+    throw std::invalid_argument("Expected out to be a float64 array.");
+  }
+  auto array = py::reinterpret_borrow<py::array_t<double>>(out);
+  if (array.ndim() != 2 || static_cast<size_t>(array.shape(0)) != n ||
+      array.shape(1) != 7) {
+    throw std::invalid_argument("Expected out to be an array of shape (N,7).");
+  }
+  if (!(array.flags() & py::array::c_style) || !array.writeable()) {
+    throw std::invalid_argument(
+        "Expected out to be a writable C-contiguous array.");
+  }
+  return array;
+}
+
+/// Allocates an (N,steps,7) array of joint trajectories.
+py::array_t<double> trajectoryBatch(size_t n, size_t steps) {
+  return py::array_t<double>(std::vector<py::ssize_t>{
+      static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(steps),
+      static_cast<py::ssize_t>(7)});
+}
+
+/// Copies per-voxel statistics of the given map into an array of its shape.
+template <typename T>
+py::array_t<T> voxelArray(const panda_model::ReachabilityMap &map,
+                          const std::vector<T> &values) {
+  const std::array<size_t, 3> &shape = map.shape();
+  return py::array_t<T>(
+      std::vector<py::ssize_t>{static_cast<py::ssize_t>(shape[0]),
+                               static_cast<py::ssize_t>(shape[1]),
+                               static_cast<py::ssize_t>(shape[2])},
+      values.data());
+}
+
 PYBIND11_MODULE(_core, m) {
   py::options options;
   options.disable_enum_members_docstring();
@@ -114,6 +212,96 @@ PYBIND11_MODULE(_core, m) {
       .value("kEndEffector", panda_model::Frame::kEndEffector)
       .value("kStiffness", panda_model::Frame::kStiffness);
 
+  py::enum_<panda_model::kinematics::InstructionSet>(
+      m, "InstructionSet",
+      "Enumerates the instruction sets the vectorized pose kernel is "
+      "implemented for.")
+      .value("kScalar", panda_model::kinematics::InstructionSet::kScalar)
+      .value("kAVX2", panda_model::kinematics::InstructionSet::kAVX2)
+      .value("kAVX512", panda_model::kinematics::InstructionSet::kAVX512);
+
+  m.def("best_instruction_set", &panda_model::kinematics::bestInstructionSet,
+        R"delim(
+        Gets the widest instruction set the vectorized pose kernel uses on this
+        processor. The kernel evaluates `Model.pose_batch` of a native `Model`.
+        )delim");
+
+  m.def("is_supported", &panda_model::kinematics::isSupported,
+        py::arg("instruction_set"), R"delim(
+        Checks whether the vectorized pose kernel can use the given instruction
+        set on this processor.
+        )delim");
+
+  py::class_<panda_model::DynamicsState>(
+      m, "DynamicsState",
+      "Kinematic and dynamic quantities of the robot in one state. The "
+      "attributes are views into buffers that are overwritten whenever the "
+      "state is passed to `Model.compute_state` again.")
+      .def(py::init<>())
+      .def_readonly("O_T_EE", &panda_model::DynamicsState::O_T_EE,
+                    "End effector pose in base frame.")
+      .def_readonly("O_Jac_EE", &panda_model::DynamicsState::O_Jac_EE,
+                    "End effector Jacobian relative to the base frame.")
+      .def_readonly("mass", &panda_model::DynamicsState::mass, "Mass matrix.")
+      .def_readonly("coriolis", &panda_model::DynamicsState::coriolis,
+                    "Coriolis force vector.")
+      .def_readonly("gravity", &panda_model::DynamicsState::gravity,
+                    "Gravity vector.");
+
+  py::class_<panda_model::OperationalSpaceState>(
+      m, "OperationalSpaceState",
+      "Operational space dynamics of one frame in one state. The attributes "
+      "are views into buffers that are overwritten whenever the state is "
+      "passed to `Model.operational_space` again.")
+      .def(py::init<>())
+      .def_readonly("Lambda", &panda_model::OperationalSpaceState::Lambda,
+                    "Operational space inertia matrix :math:`(J M^{-1} J^T)^{-1}`.")
+      .def_readonly("J_bar", &panda_model::OperationalSpaceState::J_bar,
+                    "Dynamically consistent generalized inverse "
+                    ":math:`M^{-1} J^T \\Lambda`.")
+      .def_readonly("mu", &panda_model::OperationalSpaceState::mu,
+                    "Task space Coriolis force "
+                    ":math:`\\bar{J}^T c - \\Lambda \\dot{J} \\dot{q}`.")
+      .def_readonly("p", &panda_model::OperationalSpaceState::p,
+                    "Task space gravity force :math:`\\bar{J}^T g`.")
+      .def_readonly("N", &panda_model::OperationalSpaceState::N,
+                    "Dynamically consistent null-space projector for joint "
+                    "torques :math:`I - J^T \\bar{J}^T`.");
+
+  py::class_<panda_model::MassFactorization>(
+      m, "MassFactorization",
+      "Factorization :math:`M = L D L^T` of a 7x7 mass matrix, which is "
+      "reused to solve for several right-hand sides.")
+      .def(py::init<const Eigen::Matrix<double, 7, 7> &>(), py::arg("mass"),
+           R"delim(
+      Factorize the given mass matrix.
+
+      Args:
+        mass: Positive definite 7x7 mass matrix.
+      )delim")
+      .def_property_readonly("L", &panda_model::MassFactorization::L,
+                             "Unit lower triangular factor.")
+      .def_property_readonly("D", &panda_model::MassFactorization::D,
+                             "Diagonal of the diagonal factor.")
+      .def("mass", &panda_model::MassFactorization::mass,
+           "Reconstructs the factorized mass matrix.")
+      .def("solve",
+           py::overload_cast<const Eigen::Matrix<double, 7, 1> &>(
+               &panda_model::MassFactorization::solve, py::const_),
+           py::arg("rhs"), R"delim(
+           Solves :math:`M x = b`.
+
+           Args:
+             rhs: Right-hand side :math:`b`.
+
+           Returns:
+             Solution :math:`x`.
+           )delim")
+      .def("inverse",
+           py::overload_cast<>(&panda_model::MassFactorization::inverse,
+                               py::const_),
+           "Calculates the inverse mass matrix.");
+
   py::class_<panda_model::Model>(
       m, "Model",
       "Calculates poses of joints and dynamic properties of the robot.")
@@ -125,6 +313,11 @@ PYBIND11_MODULE(_core, m) {
           The library must be compatible with the host system, i.e. in terms
           of processor architecture and operating system.
       )delim")
+      .def_static("native", &panda_model::Model::native, R"delim(
+      Create a `Model` that calculates poses, Jacobians and dynamics natively
+      from the published kinematic and identified inertial parameters of the
+      robot, without a shared library.
+      )delim")
       .def("pose",
            py::overload_cast<panda_model::Frame,
                              const Eigen::Matrix<double, 7, 1> &,
@@ -183,6 +376,56 @@ PYBIND11_MODULE(_core, m) {
            Returns:
              Vectorized 6x7 Jacobian, column-major.
            )delim")
+      .def("body_jacobian_dot",
+           py::overload_cast<panda_model::Frame,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 4, 4> &,
+                             const Eigen::Matrix<double, 4, 4> &>(
+               &panda_model::Model::bodyJacobianDot, py::const_),
+           py::arg("frame"), py::arg("q"), py::arg("dq"),
+           py::arg("F_T_EE") = Defaults::F_T_EE,
+           py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the time derivative of the 6x7 Jacobian for the given frame,
+           relative to that frame.
+           The derivative is calculated natively from the kinematic parameters,
+           independent of the shared library.
+
+           Args:
+             frame: The desired frame.
+             q: Joint position.
+             dq: Joint velocity.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Vectorized 6x7 Jacobian derivative, column-major.
+           )delim")
+      .def("zero_jacobian_dot",
+           py::overload_cast<panda_model::Frame,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 4, 4> &,
+                             const Eigen::Matrix<double, 4, 4> &>(
+               &panda_model::Model::zeroJacobianDot, py::const_),
+           py::arg("frame"), py::arg("q"), py::arg("dq"),
+           py::arg("F_T_EE") = Defaults::F_T_EE,
+           py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the time derivative of the 6x7 Jacobian for the given frame
+           relative to the base frame.
+           The derivative is calculated natively from the kinematic parameters,
+           independent of the shared library.
+
+           Args:
+             frame: The desired frame.
+             q: Joint position.
+             dq: Joint velocity.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Vectorized 6x7 Jacobian derivative, column-major.
+           )delim")
       .def("mass",
            py::overload_cast<const Eigen::Matrix<double, 7, 1> &,
                              const Eigen::Matrix3d &, double,
@@ -229,6 +472,93 @@ PYBIND11_MODULE(_core, m) {
            Returns:
              Coriolis force vector.
            )delim")
+      .def("coriolis_matrix",
+           py::overload_cast<const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix3d &, double,
+                             const Eigen::Vector3d &>(
+               &panda_model::Model::coriolisMatrix, py::const_),
+           py::arg("q"), py::arg("dq"), py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Calculates the 7x7 Coriolis matrix :math:`C(q, \dot{q})`, such that
+           :math:`C(q, \dot{q}) \dot{q}` is the Coriolis force vector of `coriolis`
+           and :math:`\dot{M}(q) - 2 C(q, \dot{q})` is skew-symmetric for the mass
+           matrix of `mass`.
+           A native model calculates the matrix from identified inertial
+           parameters. A model backed by the shared library sums the Christoffel
+           symbols of its `mass` instead, whose partial derivatives are taken by
+           central differences, so both properties hold up to the differencing
+           accuracy.
+
+           Args:
+             q: Joint position.
+             dq: Joint velocity.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Coriolis matrix.
+           )delim")
+      .def("mass_factorization", &panda_model::Model::massFactorization,
+           py::arg("q"), py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Factorizes the 7x7 mass matrix to solve for several right-hand sides.
+
+           Args:
+             q: Joint position.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             `MassFactorization` of the mass matrix.
+           )delim")
+      .def("inverse_mass", &panda_model::Model::inverseMass, py::arg("q"),
+           py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Calculates the inverse of the 7x7 mass matrix from its factorization.
+
+           Args:
+             q: Joint position.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Inverse mass matrix.
+           )delim")
+      .def("solve_mass", &panda_model::Model::solveMass, py::arg("q"),
+           py::arg("rhs"), py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Solves :math:`M(q) x = b` from the factorization of the mass matrix.
+
+           Args:
+             q: Joint position.
+             rhs: Right-hand side :math:`b`.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Solution :math:`x`.
+           )delim")
       .def("gravity",
            py::overload_cast<const Eigen::Matrix<double, 7, 1> &, double,
                              const Eigen::Vector3d &, const Eigen::Vector3d &>(
@@ -249,5 +579,2055 @@ PYBIND11_MODULE(_core, m) {
 
            Returns:
              Gravity vector.
-           )delim");
+           )delim")
+      .def("inverse_dynamics",
+           py::overload_cast<const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix3d &, double,
+                             const Eigen::Vector3d &, const Eigen::Vector3d &>(
+               &panda_model::Model::inverseDynamics, py::const_),
+           py::arg("q"), py::arg("dq"), py::arg("ddq"),
+           py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the joint torques for the given joint acceleration, i.e.
+           :math:`M(q) \ddot{q} + C(q, \dot{q}) \dot{q} + g(q)`.
+           Unit: :math:`[Nm]`. A native model calculates the torques from
+           identified inertial parameters. A model backed by the shared library
+           assembles them from its `mass`, `coriolis` and `gravity` instead.
+
+           Args:
+             q: Joint position.
+             dq: Joint velocity.
+             ddq: Joint acceleration.
+             I_total: Inertia of the attached total load including end effector, relative to center of mass. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Joint torques.
+           )delim")
+      .def("forward_dynamics",
+           py::overload_cast<const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const Eigen::Matrix3d &, double,
+                             const Eigen::Vector3d &, const Eigen::Vector3d &>(
+               &panda_model::Model::forwardDynamics, py::const_),
+           py::arg("q"), py::arg("dq"), py::arg("tau"),
+           py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the joint acceleration for the given joint torques, i.e.
+           :math:`M(q)^{-1} (\tau - C(q, \dot{q}) \dot{q} - g(q))`.
+           Unit: :math:`[\frac{rad}{s^2}]`. A native model calculates the
+           acceleration from identified inertial parameters without building or
+           inverting the mass matrix. A model backed by the shared library solves
+           its `mass` against its `coriolis` and `gravity` instead, like `Rollout`.
+
+           Args:
+             q: Joint position.
+             dq: Joint velocity.
+             tau: Joint torques. Unit: :math:`[Nm]`.
+             I_total: Inertia of the attached total load including end effector, relative to center of mass. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Joint acceleration.
+           )delim")
+      .def(
+          "poses",
+          [](const panda_model::Model &model,
+             const Eigen::Matrix<double, 7, 1> &q,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            py::array_t<double> output =
+                matrixStack({panda_model::kFrameCount}, 4, 4);
+            model.poses(q.data(), F_T_EE.data(), EE_T_K.data(),
+                        output.mutable_data());
+            return output;
+          },
+          py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 4x4 pose matrices of all frames in base frame.
+
+           Args:
+             q: Joint position.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Pose matrices of shape (10,4,4), indexed by `Frame`.
+           )delim")
+      .def(
+          "body_jacobians",
+          [](const panda_model::Model &model,
+             const Eigen::Matrix<double, 7, 1> &q,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            py::array_t<double> output =
+                matrixStack({panda_model::kFrameCount}, 6, 7);
+            model.bodyJacobians(q.data(), F_T_EE.data(), EE_T_K.data(),
+                                output.mutable_data());
+            return output;
+          },
+          py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians of all frames, each relative to its own frame.
+
+           Args:
+             q: Joint position.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (10,6,7), indexed by `Frame`.
+           )delim")
+      .def(
+          "zero_jacobians",
+          [](const panda_model::Model &model,
+             const Eigen::Matrix<double, 7, 1> &q,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            py::array_t<double> output =
+                matrixStack({panda_model::kFrameCount}, 6, 7);
+            model.zeroJacobians(q.data(), F_T_EE.data(), EE_T_K.data(),
+                                output.mutable_data());
+            return output;
+          },
+          py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians of all frames relative to the base frame.
+
+           Args:
+             q: Joint position.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (10,6,7), indexed by `Frame`.
+           )delim")
+      .def(
+          "compute_state",
+          [](const panda_model::Model &model,
+             const Eigen::Matrix<double, 7, 1> &q,
+             const Eigen::Matrix<double, 7, 1> &dq, py::object state,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix3d &I_total,
+             double m_total, const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            if (state.is_none()) {
+              state = py::cast(panda_model::DynamicsState());
+            }
+            auto &buffers = state.cast<panda_model::DynamicsState &>();
+            {
+              py::gil_scoped_release release;
+              model.computeState(q, dq, buffers, F_T_EE, I_total, m_total,
+                                 F_x_Ctotal, gravity_earth);
+            }
+            return state;
+          },
+          py::arg("q"), py::arg("dq"), py::arg("state") = py::none(),
+          py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates end effector pose, end effector zero Jacobian, mass
+           matrix, Coriolis and gravity vector for one state in a single call.
+
+           Args:
+             q: Joint position.
+             dq: Joint velocity.
+             state: `DynamicsState` whose buffers are reused for the result.
+               A new one is created if omitted.
+             F_T_EE: End effector in flange frame.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             The `DynamicsState` holding the results.
+           )delim")
+      .def(
+          "operational_space",
+          [](const panda_model::Model &model, panda_model::Frame frame,
+             const Eigen::Matrix<double, 7, 1> &q,
+             const Eigen::Matrix<double, 7, 1> &dq, py::object state,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            if (state.is_none()) {
+              state = py::cast(panda_model::OperationalSpaceState());
+            }
+            auto &buffers = state.cast<panda_model::OperationalSpaceState &>();
+            {
+              py::gil_scoped_release release;
+              model.operationalSpace(frame, q, dq, buffers, F_T_EE, EE_T_K,
+                                     I_total, m_total, F_x_Ctotal,
+                                     gravity_earth);
+            }
+            return state;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("dq"),
+          py::arg("state") = py::none(), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K,
+          py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the operational space inertia matrix, the dynamically
+           consistent generalized inverse, the task space Coriolis and gravity
+           forces and the null-space projector of the given frame for one
+           state in a single call. The Jacobian of the frame must have full
+           row rank.
+
+           Args:
+             frame: The desired frame.
+             q: Joint position.
+             dq: Joint velocity.
+             state: `OperationalSpaceState` whose buffers are reused for the
+               result. A new one is created if omitted.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             The `OperationalSpaceState` holding the results.
+           )delim")
+      .def(
+          "pose_batch",
+          [](const panda_model::Model &model, panda_model::Frame frame,
+             const BatchArray &q, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K,
+             panda_model::kinematics::InstructionSet instruction_set) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 4, 4);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.poseBatch(frame, q.data(), n, output_data, F_T_EE, EE_T_K,
+                              instruction_set);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K,
+          py::arg("instruction_set") =
+              panda_model::kinematics::bestInstructionSet(),
+          R"delim(
+           Gets the 4x4 pose matrices for the given frame in base frame for a
+           batch of joint positions.
+
+           For a native `Model` the poses are calculated by a vectorized
+           kernel, see `best_instruction_set`.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+             instruction_set: Instruction set of the kernel. Falls back to
+               `best_instruction_set` if not supported, see `is_supported`.
+               Ignored by a `Model` backed by the model library.
+
+           Returns:
+             Pose matrices of shape (N,4,4).
+           )delim")
+      .def(
+          "poses_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output =
+                matrixStack({n, panda_model::kFrameCount}, 4, 4);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.posesBatch(q.data(), n, output_data, F_T_EE, EE_T_K);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 4x4 pose matrices of all frames in base frame for a batch
+           of joint positions.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Pose matrices of shape (N,10,4,4), indexed by sample and `Frame`.
+           )delim")
+      .def(
+          "body_jacobian_batch",
+          [](const panda_model::Model &model, panda_model::Frame frame,
+             const BatchArray &q, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.bodyJacobianBatch(frame, q.data(), n, output_data, F_T_EE,
+                                      EE_T_K);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians for the given frame, relative to that frame,
+           for a batch of joint positions.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (N,6,7).
+           )delim")
+      .def(
+          "zero_jacobian_batch",
+          [](const panda_model::Model &model, panda_model::Frame frame,
+             const BatchArray &q, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.zeroJacobianBatch(frame, q.data(), n, output_data, F_T_EE,
+                                      EE_T_K);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians for the given frame relative to the base frame
+           for a batch of joint positions.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (N,6,7).
+           )delim")
+      .def(
+          "body_jacobian_dot_batch",
+          [](const panda_model::Model &model, panda_model::Frame frame,
+             const BatchArray &q, const BatchArray &dq,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n) {
+              throw std::invalid_argument(
+                  "Expected q and dq to have the same number of rows.");
+            }
+            py::array_t<double> output = matrixBatch(n, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.bodyJacobianDotBatch(frame, q.data(), dq.data(), n, output_data,
+                                         F_T_EE, EE_T_K);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("dq"),
+          py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the time derivatives of the 6x7 Jacobians for the given frame,
+           relative to that frame, for a batch of joint states.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobian derivatives of shape (N,6,7).
+           )delim")
+      .def(
+          "zero_jacobian_dot_batch",
+          [](const panda_model::Model &model, panda_model::Frame frame,
+             const BatchArray &q, const BatchArray &dq,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n) {
+              throw std::invalid_argument(
+                  "Expected q and dq to have the same number of rows.");
+            }
+            py::array_t<double> output = matrixBatch(n, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.zeroJacobianDotBatch(frame, q.data(), dq.data(), n, output_data,
+                                         F_T_EE, EE_T_K);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("dq"),
+          py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the time derivatives of the 6x7 Jacobians for the given frame
+           relative to the base frame for a batch of joint states.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobian derivatives of shape (N,6,7).
+           )delim")
+      .def(
+          "body_jacobians_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output =
+                matrixStack({n, panda_model::kFrameCount}, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.bodyJacobiansBatch(q.data(), n, output_data, F_T_EE,
+                                       EE_T_K);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians of all frames, each relative to its own
+           frame, for a batch of joint positions.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (N,10,6,7), indexed by sample and `Frame`.
+           )delim")
+      .def(
+          "zero_jacobians_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output =
+                matrixStack({n, panda_model::kFrameCount}, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.zeroJacobiansBatch(q.data(), n, output_data, F_T_EE,
+                                       EE_T_K);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians of all frames relative to the base frame for
+           a batch of joint positions.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (N,10,6,7), indexed by sample and `Frame`.
+           )delim")
+      .def(
+          "mass_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 7, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.massBatch(q.data(), n, output_data, I_total, m_total,
+                              F_x_Ctotal);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Calculates the 7x7 mass matrices for a batch of joint positions.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             I_total: Inertia of the attached total load including end effector, relative to
+                center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Mass matrices of shape (N,7,7).
+           )delim")
+      .def(
+          "inverse_mass_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 7, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.inverseMassBatch(q.data(), n, output_data, I_total, m_total,
+                                     F_x_Ctotal);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Calculates the inverse 7x7 mass matrices for a batch of joint positions.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             I_total: Inertia of the attached total load including end effector, relative to
+                center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Inverse mass matrices of shape (N,7,7).
+           )delim")
+      .def(
+          "solve_mass_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const BatchArray &rhs, const Eigen::Matrix3d &I_total,
+             double m_total, const Eigen::Vector3d &F_x_Ctotal) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(rhs, "rhs") != n) {
+              throw std::invalid_argument(
+                  "Expected q and rhs to have the same number of rows.");
+            }
+            py::array_t<double> output = vectorBatch(n);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.solveMassBatch(q.data(), rhs.data(), n, output_data, I_total,
+                                   m_total, F_x_Ctotal);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("rhs"), py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Solves :math:`M(q) x = b` for a batch of joint positions and
+           right-hand sides.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             rhs: Right-hand sides of shape (N,7).
+             I_total: Inertia of the attached total load including end effector, relative to
+                center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Solutions of shape (N,7).
+           )delim")
+      .def(
+          "coriolis_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const BatchArray &dq, const Eigen::Matrix3d &I_total,
+             double m_total, const Eigen::Vector3d &F_x_Ctotal) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n) {
+              throw std::invalid_argument(
+                  "Expected q and dq to have the same number of rows.");
+            }
+            py::array_t<double> output = vectorBatch(n);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.coriolisBatch(q.data(), dq.data(), n, output_data, I_total,
+                                  m_total, F_x_Ctotal);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("dq"), py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Calculates the Coriolis force vectors for a batch of joint states.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Coriolis force vectors of shape (N,7).
+           )delim")
+      .def(
+          "gravity_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             double m_total, const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = vectorBatch(n);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.gravityBatch(q.data(), n, output_data, m_total, F_x_Ctotal,
+                                 gravity_earth);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the gravity vectors for a batch of joint positions.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Gravity vectors of shape (N,7).
+           )delim")
+      .def(
+          "forward_dynamics_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const BatchArray &dq, const BatchArray &tau,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n || batchSize(tau, "tau") != n) {
+              throw std::invalid_argument(
+                  "Expected q, dq and tau to have the same number of rows.");
+            }
+            py::array_t<double> output = vectorBatch(n);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.forwardDynamicsBatch(q.data(), dq.data(), tau.data(), n,
+                                         output_data, I_total, m_total,
+                                         F_x_Ctotal, gravity_earth);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("dq"), py::arg("tau"),
+          py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the joint accelerations for a batch of joint states and
+           torques, see `forward_dynamics`.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             tau: Joint torques of shape (N,7). Unit: :math:`[Nm]`.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Joint accelerations of shape (N,7).
+           )delim")
+      .def(
+          "inverse_dynamics_batch",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const BatchArray &dq, const BatchArray &ddq, const py::object &out,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n || batchSize(ddq, "ddq") != n) {
+              throw std::invalid_argument(
+                  "Expected q, dq and ddq to have the same number of rows.");
+            }
+            py::array_t<double> output = vectorBatch(out, n);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              model.inverseDynamicsBatch(q.data(), dq.data(), ddq.data(), n,
+                                         output_data, I_total, m_total,
+                                         F_x_Ctotal, gravity_earth);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("dq"), py::arg("ddq"),
+          py::arg("out") = py::none(), py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the joint torques
+           :math:`M(q) \ddot{q} + C(q, \dot{q}) \dot{q} + g(q)` for a batch of joint
+           states and accelerations.
+
+           The torques are calculated like `inverse_dynamics`.
+
+           The samples are processed in a single pass, so memory-mapped
+           trajectories are streamed from and to disk. Float64 C-contiguous
+           inputs, e.g. a numpy.memmap, are read without a copy.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             ddq: Joint accelerations of shape (N,7).
+             out: Writable C-contiguous float64 array of shape (N,7) the
+               torques are written into, e.g. a numpy.memmap. Allocated if None.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Joint torques of shape (N,7), out if given. Unit: :math:`[Nm]`.
+           )delim")
+      .def(
+          "inverse_dynamics_trajectory",
+          [](const panda_model::Model &model, const BatchArray &q,
+             const BatchArray &dq, const BatchArray &ddq,
+             const py::function &sink, size_t chunk_size,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n || batchSize(ddq, "ddq") != n) {
+              throw std::invalid_argument(
+                  "Expected q, dq and ddq to have the same number of rows.");
+            }
+            // The GIL is only held while the sink runs. Each chunk is copied,
+            // since the native buffer is reused for the next one.
+            panda_model::TorqueSink callback = [&sink](size_t offset,
+                                                       size_t count,
+                                                       const double *tau) {
+              py::gil_scoped_acquire acquire;
+              py::array_t<double> chunk = vectorBatch(count);
+              std::copy(tau, tau + 7 * count, chunk.mutable_data());
+              sink(offset, chunk);
+            };
+            py::gil_scoped_release release;
+            model.inverseDynamicsTrajectory(q.data(), dq.data(), ddq.data(), n,
+                                            callback, chunk_size, I_total,
+                                            m_total, F_x_Ctotal, gravity_earth);
+          },
+          py::arg("q"), py::arg("dq"), py::arg("ddq"), py::arg("sink"),
+          py::arg("chunk_size") = 1024, py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Streams the joint torques along a trajectory to the given sink in
+           chunks, calculated like `inverse_dynamics_batch`.
+
+           Only one chunk of torques is held in memory at a time, so
+           memory-mapped trajectories of any length are evaluated with a
+           constant working set, e.g. to check logged torques against their
+           limits. The GIL is released while the chunks are computed.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             ddq: Joint accelerations of shape (N,7).
+             sink: Called as sink(offset, tau) in order with the index of the
+               first sample of each chunk and its joint torques of shape
+               (count,7). Exceptions abort the evaluation.
+             chunk_size: Maximum number of samples per chunk, at least one.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+           )delim");
+
+  py::class_<panda_model::BoundModel>(
+      m, "BoundModel",
+      "Model with a bound end effector, stiffness frame and load.")
+      .def(py::init<const panda_model::Model &, const Eigen::Matrix4d &,
+                    const Eigen::Matrix4d &, const Eigen::Matrix3d &, double,
+                    const Eigen::Vector3d &, const Eigen::Vector3d &>(),
+           py::arg("model"), py::arg("F_T_EE") = Defaults::F_T_EE,
+           py::arg("EE_T_K") = Defaults::EE_T_K,
+           py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           py::arg("gravity_earth") = Defaults::gravity_earth,
+           py::keep_alive<1, 2>(), R"delim(
+      Bind a `Model` to an end effector and load. The composed transformations
+      are precomputed once, so the queries only take the joint state.
+
+      Args:
+        model: The model to evaluate.
+        F_T_EE: End effector in flange frame.
+        EE_T_K: Stiffness frame K in the end effector frame.
+        I_total: Inertia of the attached total load including end effector, relative to
+          center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+        m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+        F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+          Unit: :math:`[m]`.
+        gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+      )delim")
+      .def("set_tool", &panda_model::BoundModel::setTool, py::arg("F_T_EE"),
+           py::arg("EE_T_K"), R"delim(
+           Atomically replaces the bound end effector and stiffness frame.
+
+           Args:
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+           )delim")
+      .def("set_payload", &panda_model::BoundModel::setPayload,
+           py::arg("I_total"), py::arg("m_total"), py::arg("F_x_Ctotal"),
+           R"delim(
+           Atomically replaces the bound load.
+
+           Args:
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+           )delim")
+      .def("pose", &panda_model::BoundModel::pose, py::arg("frame"),
+           py::arg("q"), R"delim(
+           Gets the 4x4 pose matrix for the given frame in base frame.
+
+           Args:
+             frame: The desired frame.
+             q: Joint position.
+
+           Returns:
+             4x4 pose matrix.
+           )delim")
+      .def("body_jacobian", &panda_model::BoundModel::bodyJacobian,
+           py::arg("frame"), py::arg("q"), R"delim(
+           Gets the 6x7 Jacobian for the given frame, relative to that frame.
+
+           Args:
+             frame: The desired frame.
+             q: Joint position.
+
+           Returns:
+             6x7 Jacobian.
+           )delim")
+      .def("zero_jacobian", &panda_model::BoundModel::zeroJacobian,
+           py::arg("frame"), py::arg("q"), R"delim(
+           Gets the 6x7 Jacobian for the given frame relative to the base frame.
+
+           Args:
+             frame: The desired frame.
+             q: Joint position.
+
+           Returns:
+             6x7 Jacobian.
+           )delim")
+      .def("mass", &panda_model::BoundModel::mass, py::arg("q"), R"delim(
+           Calculates the 7x7 mass matrix with the bound load.
+
+           Args:
+             q: Joint position.
+
+           Returns:
+             7x7 mass matrix.
+           )delim")
+      .def("coriolis", &panda_model::BoundModel::coriolis, py::arg("q"),
+           py::arg("dq"), R"delim(
+           Calculates the Coriolis force vector with the bound load.
+
+           Args:
+             q: Joint position.
+             dq: Joint velocity.
+
+           Returns:
+             Coriolis force vector.
+           )delim")
+      .def("gravity", &panda_model::BoundModel::gravity, py::arg("q"), R"delim(
+           Calculates the gravity vector with the bound load.
+
+           Args:
+             q: Joint position.
+
+           Returns:
+             Gravity vector.
+           )delim");
+
+  py::class_<panda_model::CacheStatistics>(
+      m, "CacheStatistics", "Hit and miss counters of a `ModelCache`.")
+      .def_readonly("hits", &panda_model::CacheStatistics::hits,
+                    "Number of queries answered from the cache.")
+      .def_readonly("misses", &panda_model::CacheStatistics::misses,
+                    "Number of queries that were evaluated by the model.");
+
+  py::class_<panda_model::ModelCache> model_cache(
+      m, "ModelCache",
+      "Remembers the last few results of each `Model` query. A query is "
+      "answered from the cache if all of its arguments are bitwise identical "
+      "to those of a remembered query.");
+
+  py::enum_<panda_model::ModelCache::Query>(model_cache, "Query",
+                                            "Enumerates the cached query types.")
+      .value("kPose", panda_model::ModelCache::Query::kPose)
+      .value("kBodyJacobian", panda_model::ModelCache::Query::kBodyJacobian)
+      .value("kZeroJacobian", panda_model::ModelCache::Query::kZeroJacobian)
+      .value("kMass", panda_model::ModelCache::Query::kMass)
+      .value("kCoriolis", panda_model::ModelCache::Query::kCoriolis)
+      .value("kGravity", panda_model::ModelCache::Query::kGravity)
+      .value("kMassFactorization",
+             panda_model::ModelCache::Query::kMassFactorization);
+
+  model_cache
+      .def(py::init<const panda_model::Model &, size_t>(), py::arg("model"),
+           py::arg("capacity") = 4, py::keep_alive<1, 2>(), R"delim(
+      Create an empty cache in front of the given `Model`.
+
+      Args:
+        model: The model to evaluate on a miss.
+        capacity: Number of results remembered per query type.
+      )delim")
+      .def("pose", &panda_model::ModelCache::pose, py::arg("frame"),
+           py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+           py::arg("EE_T_K") = Defaults::EE_T_K,
+           "Cached `Model.pose`.")
+      .def("body_jacobian", &panda_model::ModelCache::bodyJacobian,
+           py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+           py::arg("EE_T_K") = Defaults::EE_T_K,
+           "Cached `Model.body_jacobian`.")
+      .def("zero_jacobian", &panda_model::ModelCache::zeroJacobian,
+           py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+           py::arg("EE_T_K") = Defaults::EE_T_K,
+           "Cached `Model.zero_jacobian`.")
+      .def("mass", &panda_model::ModelCache::mass, py::arg("q"),
+           py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, "Cached `Model.mass`.")
+      .def("coriolis", &panda_model::ModelCache::coriolis, py::arg("q"),
+           py::arg("dq"), py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           "Cached `Model.coriolis`.")
+      .def("gravity", &panda_model::ModelCache::gravity, py::arg("q"),
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           py::arg("gravity_earth") = Defaults::gravity_earth,
+           "Cached `Model.gravity`.")
+      .def("mass_factorization", &panda_model::ModelCache::massFactorization,
+           py::arg("q"), py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           "Cached `Model.mass_factorization`.")
+      .def("inverse_mass", &panda_model::ModelCache::inverseMass, py::arg("q"),
+           py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           "`Model.inverse_mass` from the cached factorization.")
+      .def("solve_mass", &panda_model::ModelCache::solveMass, py::arg("q"),
+           py::arg("rhs"), py::arg("I_total") = Defaults::I_total,
+           py::arg("m_total") = Defaults::m_total,
+           py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+           "`Model.solve_mass` from the cached factorization.")
+      .def("statistics",
+           py::overload_cast<panda_model::ModelCache::Query>(
+               &panda_model::ModelCache::statistics, py::const_),
+           py::arg("query"), R"delim(
+           Gets the hit and miss counters of the given query type.
+
+           Args:
+             query: The query type.
+
+           Returns:
+             Counters since construction or the last call to `clear`.
+           )delim")
+      .def("statistics",
+           py::overload_cast<>(&panda_model::ModelCache::statistics, py::const_),
+           R"delim(
+           Gets the hit and miss counters summed over all query types.
+
+           Returns:
+             Counters since construction or the last call to `clear`.
+           )delim")
+      .def("clear", &panda_model::ModelCache::clear,
+           "Forgets all remembered results and resets the counters.");
+
+  py::class_<panda_model::ThreadPool>(
+      m, "ThreadPool",
+      "Fixed set of worker threads that cooperatively process index ranges, "
+      "stealing chunks from each other when they run out of work.")
+      .def(py::init<size_t>(), py::arg("num_threads") = 0, R"delim(
+      Start the worker threads.
+
+      Args:
+        num_threads: Number of threads including the calling thread, zero selects
+          the number of hardware threads.
+      )delim")
+      .def_property_readonly(
+          "size", &panda_model::ThreadPool::size,
+          "Number of threads processing work, including the calling thread.")
+      .def(
+          "parallel_for",
+          [](panda_model::ThreadPool &pool, size_t n, size_t grain_size,
+             const py::function &function) {
+            // The GIL is only held while the function runs.
+            std::function<void(size_t, size_t)> callback =
+                [&function](size_t begin, size_t end) {
+                  py::gil_scoped_acquire acquire;
+                  function(begin, end);
+                };
+            py::gil_scoped_release release;
+            pool.parallelFor(n, grain_size, callback);
+          },
+          py::arg("n"), py::arg("grain_size"), py::arg("function"), R"delim(
+           Calls the given function for consecutive chunks covering the range
+           [0, n) and blocks until all chunks have been processed. The GIL is
+           released while waiting and only acquired while the function runs.
+           Must not be called from within the given function.
+
+           Args:
+             n: Size of the range.
+             grain_size: Maximum number of elements per chunk.
+             function: Called as `function(begin, end)` for each chunk.
+
+           Raises:
+             The first exception raised by the given function.
+           )delim");
+
+  py::class_<panda_model::ModelBatch>(
+      m, "ModelBatch",
+      "Evaluates a `Model` for large batches of joint states in parallel.")
+      .def(py::init<const panda_model::Model &, size_t, size_t>(),
+           py::arg("model"), py::arg("num_threads") = 0,
+           py::arg("grain_size") = 256, py::keep_alive<1, 2>(), R"delim(
+      Create a batch evaluator and start its worker threads.
+
+      Args:
+        model: The model to evaluate.
+        num_threads: Number of threads, zero selects the number of hardware threads.
+        grain_size: Number of joint states evaluated per scheduled chunk.
+      )delim")
+      .def_property_readonly("num_threads",
+                             &panda_model::ModelBatch::numThreads,
+                             "Number of threads used for evaluation.")
+      .def(
+          "pose",
+          [](panda_model::ModelBatch &batch, panda_model::Frame frame,
+             const BatchArray &q, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 4, 4);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              batch.pose(frame, q.data(), n, output_data, F_T_EE, EE_T_K);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 4x4 pose matrices for the given frame in base frame, see
+           `Model.pose_batch`.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Pose matrices of shape (N,4,4).
+           )delim")
+      .def(
+          "body_jacobian",
+          [](panda_model::ModelBatch &batch, panda_model::Frame frame,
+             const BatchArray &q, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              batch.bodyJacobian(frame, q.data(), n, output_data, F_T_EE,
+                                 EE_T_K);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians for the given frame, relative to that frame,
+           see `Model.body_jacobian_batch`.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (N,6,7).
+           )delim")
+      .def(
+          "zero_jacobian",
+          [](panda_model::ModelBatch &batch, panda_model::Frame frame,
+             const BatchArray &q, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 6, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              batch.zeroJacobian(frame, q.data(), n, output_data, F_T_EE,
+                                 EE_T_K);
+            }
+            return output;
+          },
+          py::arg("frame"), py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Gets the 6x7 Jacobians for the given frame, relative to the base
+           frame, see `Model.zero_jacobian_batch`.
+
+           Args:
+             frame: The desired frame.
+             q: Joint positions of shape (N,7).
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Jacobians of shape (N,6,7).
+           )delim")
+      .def(
+          "mass",
+          [](panda_model::ModelBatch &batch, const BatchArray &q,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = matrixBatch(n, 7, 7);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              batch.mass(q.data(), n, output_data, I_total, m_total, F_x_Ctotal);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Calculates the 7x7 mass matrices, see `Model.mass_batch`.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Mass matrices of shape (N,7,7).
+           )delim")
+      .def(
+          "coriolis",
+          [](panda_model::ModelBatch &batch, const BatchArray &q,
+             const BatchArray &dq, const Eigen::Matrix3d &I_total,
+             double m_total, const Eigen::Vector3d &F_x_Ctotal) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n) {
+              throw std::invalid_argument(
+                  "Expected q and dq to have the same number of rows.");
+            }
+            py::array_t<double> output = vectorBatch(n);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              batch.coriolis(q.data(), dq.data(), n, output_data, I_total,
+                             m_total, F_x_Ctotal);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("dq"), py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal, R"delim(
+           Calculates the Coriolis force vectors, see `Model.coriolis_batch`.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+
+           Returns:
+             Coriolis force vectors of shape (N,7).
+           )delim")
+      .def(
+          "gravity",
+          [](panda_model::ModelBatch &batch, const BatchArray &q,
+             double m_total, const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> output = vectorBatch(n);
+            double *output_data = output.mutable_data();
+            {
+              py::gil_scoped_release release;
+              batch.gravity(q.data(), n, output_data, m_total, F_x_Ctotal,
+                            gravity_earth);
+            }
+            return output;
+          },
+          py::arg("q"), py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the gravity vectors, see `Model.gravity_batch`.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Gravity vectors of shape (N,7).
+           )delim");
+
+  py::enum_<panda_model::Integrator>(m, "Integrator",
+                                     "Enumerates the integration schemes of `Rollout`.")
+      .value("kSemiImplicitEuler", panda_model::Integrator::kSemiImplicitEuler)
+      .value("kRungeKutta4", panda_model::Integrator::kRungeKutta4);
+
+  py::class_<panda_model::Rollout>(
+      m, "Rollout",
+      "Integrates the equations of motion of a `Model` for batches of initial "
+      "states in parallel.")
+      .def(py::init<const panda_model::Model &, size_t, size_t>(),
+           py::arg("model"), py::arg("num_threads") = 0,
+           py::arg("grain_size") = 1, py::keep_alive<1, 2>(), R"delim(
+      Create a rollout engine and start its worker threads.
+
+      Args:
+        model: The model to simulate.
+        num_threads: Number of threads, zero selects the number of hardware threads.
+        grain_size: Number of rollouts integrated per scheduled chunk.
+      )delim")
+      .def_property_readonly("num_threads", &panda_model::Rollout::numThreads,
+                             "Number of threads used for integration.")
+      .def(
+          "run",
+          [](panda_model::Rollout &rollout, const BatchArray &q0,
+             const BatchArray &dq0, const BatchArray &tau, double dt,
+             panda_model::Integrator integrator, const Eigen::Matrix3d &I_total,
+             double m_total, const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q0, "q0");
+            if (batchSize(dq0, "dq0") != n) {
+              throw std::invalid_argument(
+                  "Expected q0 and dq0 to have the same number of rows.");
+            }
+            if (tau.ndim() != 3 || static_cast<size_t>(tau.shape(0)) != n ||
+                tau.shape(2) != 7) {
+              throw std::invalid_argument(
+                  "Expected tau to be an array of shape (N,steps,7).");
+            }
+            size_t steps = static_cast<size_t>(tau.shape(1));
+            py::array_t<double> q = trajectoryBatch(n, steps + 1);
+            py::array_t<double> dq = trajectoryBatch(n, steps + 1);
+            double *q_data = q.mutable_data();
+            double *dq_data = dq.mutable_data();
+            {
+              py::gil_scoped_release release;
+              rollout.run(q0.data(), dq0.data(), tau.data(), n, steps, dt, q_data,
+                          dq_data, integrator, I_total, m_total, F_x_Ctotal,
+                          gravity_earth);
+            }
+            return py::make_tuple(q, dq);
+          },
+          py::arg("q0"), py::arg("dq0"), py::arg("tau"), py::arg("dt"),
+          py::arg("integrator") = panda_model::Integrator::kRungeKutta4,
+          py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Integrates rollouts driven by the given torque sequences. The torques
+           are held constant during each step.
+
+           Args:
+             q0: Initial joint positions of shape (N,7).
+             dq0: Initial joint velocities of shape (N,7).
+             tau: Joint torques of shape (N,steps,7). Unit: :math:`[Nm]`.
+             dt: Step size. Unit: :math:`[s]`.
+             integrator: Integration scheme.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Tuple of joint position and velocity trajectories, each of shape
+             (N,steps+1,7) and starting with the initial state.
+           )delim")
+      .def(
+          "run_policy",
+          [](panda_model::Rollout &rollout, const BatchArray &q0,
+             const BatchArray &dq0, const py::function &policy, size_t steps,
+             double dt, panda_model::Integrator integrator,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q0, "q0");
+            if (batchSize(dq0, "dq0") != n) {
+              throw std::invalid_argument(
+                  "Expected q0 and dq0 to have the same number of rows.");
+            }
+            py::array_t<double> q = trajectoryBatch(n, steps + 1);
+            py::array_t<double> dq = trajectoryBatch(n, steps + 1);
+            py::array_t<double> tau = trajectoryBatch(n, steps);
+            double *q_data = q.mutable_data();
+            double *dq_data = dq.mutable_data();
+            double *tau_data = tau.mutable_data();
+            // The GIL is only held while the policy runs.
+            panda_model::Policy callback = [&policy](size_t index, size_t step,
+                                                     const double *q_step,
+                                                     const double *dq_step,
+                                                     double *tau_step) {
+              py::gil_scoped_acquire acquire;
+              Eigen::Matrix<double, 7, 1> position =
+                  Eigen::Map<const Eigen::Matrix<double, 7, 1>>(q_step);
+              Eigen::Matrix<double, 7, 1> velocity =
+                  Eigen::Map<const Eigen::Matrix<double, 7, 1>>(dq_step);
+              Eigen::Matrix<double, 7, 1> torque =
+                  policy(index, step, position, velocity)
+                      .cast<Eigen::Matrix<double, 7, 1>>();
+              Eigen::Map<Eigen::Matrix<double, 7, 1>>(tau_step) = torque;
+            };
+            {
+              py::gil_scoped_release release;
+              rollout.run(q0.data(), dq0.data(), callback, n, steps, dt, q_data,
+                          dq_data, tau_data, integrator, I_total, m_total,
+                          F_x_Ctotal, gravity_earth);
+            }
+            return py::make_tuple(q, dq, tau);
+          },
+          py::arg("q0"), py::arg("dq0"), py::arg("policy"), py::arg("steps"),
+          py::arg("dt"),
+          py::arg("integrator") = panda_model::Integrator::kRungeKutta4,
+          py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Integrates rollouts driven by the given policy, which is called once
+           at the beginning of every step. The GIL is released for the rollout
+           and only acquired while the policy runs.
+
+           Args:
+             q0: Initial joint positions of shape (N,7).
+             dq0: Initial joint velocities of shape (N,7).
+             policy: Called as `policy(rollout, step, q, dq)` and returns the
+               7 joint torques of the step. Unit: :math:`[Nm]`.
+             steps: Number of integration steps per rollout.
+             dt: Step size. Unit: :math:`[s]`.
+             integrator: Integration scheme.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Tuple of joint position and velocity trajectories, each of shape
+             (N,steps+1,7) and starting with the initial state, and the applied
+             joint torques of shape (N,steps,7).
+           )delim");
+
+  py::enum_<panda_model::Difference>(
+      m, "Difference", "Enumerates the finite difference schemes of `Linearization`.")
+      .value("kForward", panda_model::Difference::kForward)
+      .value("kCentral", panda_model::Difference::kCentral);
+
+  py::class_<panda_model::Linearization>(
+      m, "Linearization",
+      "Linearizes the equations of motion of a `Model` around batches of "
+      "knots in parallel.")
+      .def(py::init<const panda_model::Model &, size_t, size_t>(),
+           py::arg("model"), py::arg("num_threads") = 0,
+           py::arg("grain_size") = 4, py::keep_alive<1, 2>(), R"delim(
+      Create a linearization engine and start its worker threads.
+
+      Args:
+        model: The model to linearize.
+        num_threads: Number of threads, zero selects the number of hardware threads.
+        grain_size: Number of perturbations evaluated per scheduled chunk.
+      )delim")
+      .def_property_readonly("num_threads",
+                             &panda_model::Linearization::numThreads,
+                             "Number of threads used for linearization.")
+      .def(
+          "linearize",
+          [](panda_model::Linearization &linearization, const BatchArray &q,
+             const BatchArray &dq, const BatchArray &tau,
+             panda_model::Difference difference, double step,
+             const Eigen::Matrix3d &I_total, double m_total,
+             const Eigen::Vector3d &F_x_Ctotal,
+             const Eigen::Vector3d &gravity_earth) {
+            size_t n = batchSize(q, "q");
+            if (batchSize(dq, "dq") != n || batchSize(tau, "tau") != n) {
+              throw std::invalid_argument(
+                  "Expected q, dq and tau to have the same number of rows.");
+            }
+            py::array_t<double> A = matrixBatch(n, 14, 14);
+            py::array_t<double> B = matrixBatch(n, 14, 7);
+            double *A_data = A.mutable_data();
+            double *B_data = B.mutable_data();
+            {
+              py::gil_scoped_release release;
+              linearization.linearize(q.data(), dq.data(), tau.data(), n, A_data,
+                                      B_data, difference, step, I_total,
+                                      m_total, F_x_Ctotal, gravity_earth);
+            }
+            return py::make_tuple(A, B);
+          },
+          py::arg("q"), py::arg("dq"), py::arg("tau"),
+          py::arg("difference") = panda_model::Difference::kCentral,
+          py::arg("step") = 1e-6, py::arg("I_total") = Defaults::I_total,
+          py::arg("m_total") = Defaults::m_total,
+          py::arg("F_x_Ctotal") = Defaults::F_x_Ctotal,
+          py::arg("gravity_earth") = Defaults::gravity_earth, R"delim(
+           Calculates the continuous-time state space matrices of the
+           equations of motion for the state :math:`x = (q, \dot{q})`, i.e.
+           :math:`\dot{x} \approx A x + B \tau` around each knot. The
+           derivatives of the joint acceleration are approximated with finite
+           differences, the input matrix holds the exact inverse mass matrix.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             dq: Joint velocities of shape (N,7).
+             tau: Joint torques of shape (N,7). Unit: :math:`[Nm]`.
+             difference: Finite difference scheme.
+             step: Perturbation of each state coordinate.
+             I_total: Inertia of the attached total load including end effector, relative to
+               center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+             m_total: Weight of the attached total load including end effector.
+               Unit: :math:`[kg]`.
+             F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+               Unit: :math:`[m]`.
+             gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+           Returns:
+             Tuple of state matrices of shape (N,14,14) and input matrices of
+             shape (N,14,7).
+           )delim");
+
+  py::enum_<panda_model::IKStatus>(
+      m, "IKStatus", "Enumerates the outcomes of an `InverseKinematics` query.")
+      .value("kConverged", panda_model::IKStatus::kConverged)
+      .value("kMaxIterations", panda_model::IKStatus::kMaxIterations)
+      .value("kStalled", panda_model::IKStatus::kStalled);
+
+  py::class_<panda_model::IKOptions>(m, "IKOptions",
+                                     "Tuning parameters of `InverseKinematics`.")
+      .def(py::init<>())
+      .def_readwrite("max_iterations", &panda_model::IKOptions::max_iterations,
+                     "Maximum number of damped least squares steps.")
+      .def_readwrite("damping", &panda_model::IKOptions::damping,
+                     "Damping of the step :math:`J^T (J J^T + \\lambda^2 I)^{-1} e`.")
+      .def_readwrite("max_step", &panda_model::IKOptions::max_step,
+                     "Largest norm of one step, longer steps are shortened.")
+      .def_readwrite("min_step", &panda_model::IKOptions::min_step,
+                     "Norm of a step below which the query is stalled.")
+      .def_readwrite("position_tolerance",
+                     &panda_model::IKOptions::position_tolerance,
+                     "Accepted distance from the target position. Unit: :math:`[m]`.")
+      .def_readwrite("orientation_tolerance",
+                     &panda_model::IKOptions::orientation_tolerance,
+                     "Accepted rotation angle from the target orientation. "
+                     "Unit: :math:`[rad]`.")
+      .def_readwrite("q_min", &panda_model::IKOptions::q_min,
+                     "Lower joint position limits the solution is clamped to.")
+      .def_readwrite("q_max", &panda_model::IKOptions::q_max,
+                     "Upper joint position limits the solution is clamped to.");
+
+  py::class_<panda_model::IKSolution>(m, "IKSolution",
+                                      "Result of one `InverseKinematics` query.")
+      .def_readonly("q", &panda_model::IKSolution::q,
+                    "Joint position of the last iterate, within the joint limits.")
+      .def_readonly("status", &panda_model::IKSolution::status,
+                    "Outcome of the query.")
+      .def_readonly("iterations", &panda_model::IKSolution::iterations,
+                    "Number of steps taken.")
+      .def_readonly("position_error", &panda_model::IKSolution::position_error,
+                    "Distance from the target position at q. Unit: :math:`[m]`.")
+      .def_readonly("orientation_error",
+                    &panda_model::IKSolution::orientation_error,
+                    "Rotation angle from the target orientation at q. "
+                    "Unit: :math:`[rad]`.");
+
+  py::class_<panda_model::InverseKinematics>(
+      m, "InverseKinematics",
+      "Solves inverse kinematics of a `Model` for batches of target poses "
+      "with damped least squares in parallel.")
+      .def(py::init<const panda_model::Model &, size_t, size_t>(),
+           py::arg("model"), py::arg("num_threads") = 0,
+           py::arg("grain_size") = 4, py::keep_alive<1, 2>(), R"delim(
+      Create an inverse kinematics engine and start its worker threads.
+
+      Args:
+        model: The model to invert.
+        num_threads: Number of threads, zero selects the number of hardware threads.
+        grain_size: Number of queries solved per scheduled chunk.
+      )delim")
+      .def_property_readonly("num_threads",
+                             &panda_model::InverseKinematics::numThreads,
+                             "Number of threads used for solving.")
+      .def("solve",
+           py::overload_cast<panda_model::Frame, const Eigen::Matrix4d &,
+                             const Eigen::Matrix<double, 7, 1> &,
+                             const panda_model::IKOptions &,
+                             const Eigen::Matrix4d &, const Eigen::Matrix4d &>(
+               &panda_model::InverseKinematics::solve, py::const_),
+           py::arg("frame"), py::arg("target"), py::arg("seed"),
+           py::arg("options") = panda_model::IKOptions(),
+           py::arg("F_T_EE") = Defaults::F_T_EE,
+           py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Solves one query on the calling thread.
+
+           Args:
+             frame: The desired frame.
+             target: Desired pose of the frame relative to the base frame.
+             seed: Initial joint position, clamped to the joint limits.
+             options: Tuning parameters.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Solution of the query.
+           )delim")
+      .def(
+          "solve_batch",
+          [](panda_model::InverseKinematics &inverse_kinematics,
+             panda_model::Frame frame, const BatchArray &targets,
+             const BatchArray &seeds, const panda_model::IKOptions &options,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(seeds, "seeds");
+            if (targets.ndim() != 3 ||
+                static_cast<size_t>(targets.shape(0)) != n ||
+                targets.shape(1) != 4 || targets.shape(2) != 4) {
+              throw std::invalid_argument(
+                  "Expected targets to be an array of shape (N,4,4).");
+            }
+            py::array_t<double> q = vectorBatch(n);
+            py::array_t<uint8_t> status(static_cast<py::ssize_t>(n));
+            py::array_t<size_t> iterations(static_cast<py::ssize_t>(n));
+            double *q_data = q.mutable_data();
+            uint8_t *status_data = status.mutable_data();
+            size_t *iterations_data = iterations.mutable_data();
+            {
+              py::gil_scoped_release release;
+              // The targets arrive row-major, the solver expects column-major.
+              std::vector<double> poses(16 * n);
+              for (size_t i = 0; i < n; i++) {
+                Eigen::Map<Eigen::Matrix4d>(poses.data() + 16 * i) =
+                    Eigen::Map<
+                        const Eigen::Matrix<double, 4, 4, Eigen::RowMajor>>(
+                        targets.data() + 16 * i);
+              }
+              std::vector<panda_model::IKSolution> solutions(n);
+              inverse_kinematics.solve(frame, poses.data(), seeds.data(), n,
+                                       solutions.data(), options, F_T_EE,
+                                       EE_T_K);
+              for (size_t i = 0; i < n; i++) {
+                Eigen::Map<Eigen::Matrix<double, 7, 1>>(q_data + 7 * i) =
+                    solutions[i].q;
+                status_data[i] = static_cast<uint8_t>(solutions[i].status);
+                iterations_data[i] = solutions[i].iterations;
+              }
+            }
+            return py::make_tuple(q, status, iterations);
+          },
+          py::arg("frame"), py::arg("targets"), py::arg("seeds"),
+          py::arg("options") = panda_model::IKOptions(),
+          py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Solves a batch of queries in parallel, each warm started from its
+           own seed.
+
+           Args:
+             frame: The desired frame.
+             targets: Desired poses of the frame relative to the base frame of
+               shape (N,4,4).
+             seeds: Initial joint positions of shape (N,7), clamped to the
+               joint limits.
+             options: Tuning parameters shared by all queries.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Tuple of joint positions of shape (N,7), the values of
+             `IKStatus` of shape (N,) and the iteration counts of shape (N,).
+           )delim");
+
+  py::class_<panda_model::IKSeedIndex>(
+      m, "IKSeedIndex",
+      "Nearest neighbour index of precomputed poses of a frame, used to look "
+      "up seeds of `InverseKinematics`. The index is memory-mapped from disk "
+      "by `load`.")
+      .def_static(
+          "build",
+          [](const panda_model::Model &model, const BatchArray &q,
+             panda_model::Frame frame, double orientation_scale,
+             const Eigen::Matrix4d &F_T_EE, const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::gil_scoped_release release;
+            return panda_model::IKSeedIndex::build(model, q.data(), n, frame,
+                                                   orientation_scale, F_T_EE,
+                                                   EE_T_K);
+          },
+          py::arg("model"), py::arg("q"),
+          py::arg("frame") = panda_model::Frame::kEndEffector,
+          py::arg("orientation_scale") = 0.1,
+          py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Builds an index from the poses of the given joint positions, e.g. a
+           dense sample of the joint space within the joint limits. The
+           distance of two poses is
+           :math:`\sqrt{\|\Delta p\|^2 + s^2 (\|\Delta x\|^2 + \|\Delta y\|^2)}`
+           for their positions and x and y axes.
+
+           Args:
+             model: The model to calculate the poses with.
+             q: Joint positions of shape (N,7).
+             frame: The frame whose poses are indexed.
+             orientation_scale: Weight :math:`s` of the orientation in the
+               distance. Unit: :math:`[m]`.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Index of the poses.
+           )delim")
+      .def_static("load", &panda_model::IKSeedIndex::load, py::arg("path"),
+                  R"delim(
+           Memory-maps an index written by `save`.
+
+           Args:
+             path: Path of the index file.
+
+           Returns:
+             Index stored in the file.
+           )delim")
+      .def("save", &panda_model::IKSeedIndex::save, py::arg("path"), R"delim(
+           Writes the index to a file that can be memory-mapped by `load`.
+
+           Args:
+             path: Path of the index file, overwritten if it exists.
+           )delim")
+      .def("__len__", &panda_model::IKSeedIndex::size)
+      .def_property_readonly("frame", &panda_model::IKSeedIndex::frame,
+                             "The frame whose poses are indexed.")
+      .def_property_readonly("orientation_scale",
+                             &panda_model::IKSeedIndex::orientationScale,
+                             "Weight of the orientation in the distance.")
+      .def(
+          "nearest",
+          [](const panda_model::IKSeedIndex &index,
+             const Eigen::Matrix4d &target, size_t k) {
+            size_t count = std::min(k, index.size());
+            py::array_t<double> seeds = vectorBatch(count);
+            py::array_t<double> distances(static_cast<py::ssize_t>(count));
+            double *seeds_data = seeds.mutable_data();
+            double *distances_data = distances.mutable_data();
+            {
+              py::gil_scoped_release release;
+              index.nearest(target, k, seeds_data, distances_data);
+            }
+            return py::make_tuple(seeds, distances);
+          },
+          py::arg("target"), py::arg("k") = 1, R"delim(
+           Finds the joint positions whose poses are nearest to the given
+           target.
+
+           Args:
+             target: Target pose of the frame relative to the base frame.
+             k: Maximum number of seeds.
+
+           Returns:
+             Tuple of seeds of shape (K,7) by ascending distance and their
+             distances of shape (K,), with K the smaller of k and the size of
+             the index.
+           )delim")
+      .def(
+          "nearest_batch",
+          [](const panda_model::IKSeedIndex &index, const BatchArray &targets,
+             size_t k) {
+            if (targets.ndim() != 3 || targets.shape(1) != 4 ||
+                targets.shape(2) != 4) {
+              throw std::invalid_argument(
+                  "Expected targets to be an array of shape (N,4,4).");
+            }
+            size_t n = static_cast<size_t>(targets.shape(0));
+            size_t count = std::min(k, index.size());
+            py::array_t<double> seeds = trajectoryBatch(n, count);
+            py::array_t<double> distances(std::vector<py::ssize_t>{
+                static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(count)});
+            double *seeds_data = seeds.mutable_data();
+            double *distances_data = distances.mutable_data();
+            {
+              py::gil_scoped_release release;
+              // The targets arrive row-major, the index expects column-major.
+              std::vector<double> poses(16 * n);
+              for (size_t i = 0; i < n; i++) {
+                Eigen::Map<Eigen::Matrix4d>(poses.data() + 16 * i) =
+                    Eigen::Map<
+                        const Eigen::Matrix<double, 4, 4, Eigen::RowMajor>>(
+                        targets.data() + 16 * i);
+              }
+              index.nearest(poses.data(), n, k, seeds_data, distances_data);
+            }
+            return py::make_tuple(seeds, distances);
+          },
+          py::arg("targets"), py::arg("k") = 1, R"delim(
+           Finds the nearest joint positions for a batch of targets, see
+           `nearest`.
+
+           Args:
+             targets: Target poses of the frame relative to the base frame of
+               shape (N,4,4).
+             k: Maximum number of seeds per target.
+
+           Returns:
+             Tuple of seeds of shape (N,K,7) and their distances of shape
+             (N,K), with K the smaller of k and the size of the index.
+           )delim");
+
+  py::class_<panda_model::Capsule>(
+      m, "Capsule",
+      "Capsule rigidly attached to a frame: all points within the radius of "
+      "the segment between two end points.")
+      .def(py::init([](panda_model::Frame frame, const Eigen::Vector3d &a,
+                       const Eigen::Vector3d &b, double radius) {
+             return panda_model::Capsule{frame, a, b, radius};
+           }),
+           py::arg("frame"), py::arg("a"), py::arg("b"), py::arg("radius"))
+      .def_readwrite("frame", &panda_model::Capsule::frame,
+                     "Frame the capsule is attached to.")
+      .def_readwrite("a", &panda_model::Capsule::a,
+                     "First end point of the segment in the frame.")
+      .def_readwrite("b", &panda_model::Capsule::b,
+                     "Second end point of the segment in the frame.")
+      .def_readwrite("radius", &panda_model::Capsule::radius,
+                     "Radius around the segment.");
+
+  py::class_<panda_model::SelfCollision>(
+      m, "SelfCollision",
+      "Calculates the minimum distance between pairs of link capsules for "
+      "batches of joint positions in parallel.")
+      .def(py::init<const panda_model::Model &,
+                    std::vector<panda_model::Capsule>,
+                    std::vector<panda_model::CapsulePair>, size_t, size_t>(),
+           py::arg("model"),
+           py::arg("capsules") = panda_model::SelfCollision::defaultCapsules(),
+           py::arg("pairs") = panda_model::SelfCollision::defaultPairs(),
+           py::arg("num_threads") = 0, py::arg("grain_size") = 16,
+           py::keep_alive<1, 2>(), R"delim(
+      Create a self-collision checker and start its worker threads.
+
+      Args:
+        model: The model to calculate the frame poses with.
+        capsules: Capsules attached to the frames.
+        pairs: Pairs of indices into capsules whose distances are checked.
+        num_threads: Number of threads, zero selects the number of hardware threads.
+        grain_size: Number of joint positions evaluated per scheduled chunk.
+      )delim")
+      .def_static("default_capsules",
+                  &panda_model::SelfCollision::defaultCapsules,
+                  "Capsules that cover the links of the robot and the default "
+                  "hand.")
+      .def_static("default_pairs", &panda_model::SelfCollision::defaultPairs,
+                  "Pairs of the default capsules whose frames are at least "
+                  "three joints apart.")
+      .def_property_readonly("num_threads",
+                             &panda_model::SelfCollision::numThreads,
+                             "Number of threads used for distance queries.")
+      .def_property_readonly("capsules", &panda_model::SelfCollision::capsules,
+                             "Capsules attached to the frames.")
+      .def_property_readonly("pairs", &panda_model::SelfCollision::pairs,
+                             "Pairs of capsules whose distances are checked.")
+      .def(
+          "distance",
+          [](panda_model::SelfCollision &self_collision,
+             const Eigen::Matrix<double, 7, 1> &q, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            double distance;
+            size_t closest;
+            Eigen::Matrix<double, 7, 1> gradient;
+            {
+              py::gil_scoped_release release;
+              self_collision.distance(q.data(), 1, &distance, gradient.data(),
+                                      &closest, F_T_EE, EE_T_K);
+            }
+            return py::make_tuple(distance, closest, gradient);
+          },
+          py::arg("q"), py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Calculates the minimum distance over all pairs, negative if capsules
+           penetrate.
+
+           Args:
+             q: Joint position.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Tuple of the minimum distance, the index of the closest pair and
+             the gradient of the distance with respect to the joint position.
+           )delim")
+      .def(
+          "distance_batch",
+          [](panda_model::SelfCollision &self_collision, const BatchArray &q,
+             bool gradients, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            size_t n = batchSize(q, "q");
+            py::array_t<double> distances(static_cast<py::ssize_t>(n));
+            py::array_t<size_t> closest(static_cast<py::ssize_t>(n));
+            py::object gradient = py::none();
+            double *distances_data = distances.mutable_data();
+            size_t *closest_data = closest.mutable_data();
+            double *gradient_data = nullptr;
+            if (gradients) {
+              py::array_t<double> array = vectorBatch(n);
+              gradient_data = array.mutable_data();
+              gradient = array;
+            }
+            {
+              py::gil_scoped_release release;
+              self_collision.distance(q.data(), n, distances_data, gradient_data,
+                                      closest_data, F_T_EE, EE_T_K);
+            }
+            return py::make_tuple(distances, closest, gradient);
+          },
+          py::arg("q"), py::arg("gradients") = false,
+          py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Calculates the minimum distance over all pairs for a batch of joint
+           positions, see `distance`.
+
+           Args:
+             q: Joint positions of shape (N,7).
+             gradients: Whether to calculate the gradients of the distances.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Tuple of the minimum distances of shape (N,), the indices of the
+             closest pairs of shape (N,) and the gradients of shape (N,7), or
+             None if not requested.
+           )delim");
+
+  py::class_<panda_model::ReachabilityOptions>(
+      m, "ReachabilityOptions",
+      "Sampling parameters of `ReachabilityMap.generate`.")
+      .def(py::init<>())
+      .def_readwrite("frame", &panda_model::ReachabilityOptions::frame,
+                     "Frame whose positions are binned into voxels.")
+      .def_readwrite("lower", &panda_model::ReachabilityOptions::lower,
+                     "Lower corner of the voxel grid in the base frame. "
+                     "Unit: :math:`[m]`.")
+      .def_readwrite("upper", &panda_model::ReachabilityOptions::upper,
+                     "Upper corner of the voxel grid in the base frame, rounded "
+                     "up to whole voxels. Unit: :math:`[m]`.")
+      .def_readwrite("resolution", &panda_model::ReachabilityOptions::resolution,
+                     "Edge length of the cubic voxels. Unit: :math:`[m]`.")
+      .def_readwrite("samples", &panda_model::ReachabilityOptions::samples,
+                     "Number of sampled joint positions.")
+      .def_readwrite("seed", &panda_model::ReachabilityOptions::seed,
+                     "Seed of the random number generator.")
+      .def_readwrite("q_min", &panda_model::ReachabilityOptions::q_min,
+                     "Lower joint position limits the samples are drawn within.")
+      .def_readwrite("q_max", &panda_model::ReachabilityOptions::q_max,
+                     "Upper joint position limits the samples are drawn within.");
+
+  py::class_<panda_model::ReachabilityMap>(
+      m, "ReachabilityMap",
+      "Voxel grid over the workspace that records how often uniformly sampled "
+      "joint positions reach each voxel and their manipulability.")
+      .def_static(
+          "generate",
+          [](const panda_model::Model &model,
+             const panda_model::ReachabilityOptions &options, size_t num_threads,
+             size_t grain_size, const Eigen::Matrix4d &F_T_EE,
+             const Eigen::Matrix4d &EE_T_K) {
+            py::gil_scoped_release release;
+            return panda_model::ReachabilityMap::generate(
+                model, options, num_threads, grain_size, F_T_EE, EE_T_K);
+          },
+          py::arg("model"),
+          py::arg("options") = panda_model::ReachabilityOptions(),
+          py::arg("num_threads") = 0, py::arg("grain_size") = 1024,
+          py::arg("F_T_EE") = Defaults::F_T_EE,
+          py::arg("EE_T_K") = Defaults::EE_T_K, R"delim(
+           Samples joint positions uniformly within the joint limits in
+           parallel and accumulates the statistics of the voxels their frame
+           positions fall into. The manipulability of a joint position is
+           :math:`\sqrt{\det(J J^T)}` and its condition number is the ratio of
+           the largest to the smallest singular value of the zero Jacobian
+           :math:`J`. The samples only depend on the options and the grain
+           size, not on the number of threads.
+
+           Args:
+             model: The model to calculate the poses and Jacobians with.
+             options: Sampling parameters.
+             num_threads: Number of threads, zero selects the number of
+               hardware threads.
+             grain_size: Number of joint positions sampled per scheduled chunk.
+             F_T_EE: End effector in flange frame.
+             EE_T_K: Stiffness frame K in the end effector frame.
+
+           Returns:
+             Map of the sampled joint positions.
+           )delim")
+      .def_static("load", &panda_model::ReachabilityMap::load, py::arg("path"),
+                  R"delim(
+           Reads a map written by `save`.
+
+           Args:
+             path: Path of the map file.
+
+           Returns:
+             Map stored in the file.
+           )delim")
+      .def("save", &panda_model::ReachabilityMap::save, py::arg("path"),
+           R"delim(
+           Writes the map to a compact binary file that can be read by `load`.
+
+           Args:
+             path: Path of the map file, overwritten if it exists.
+           )delim")
+      .def("__len__", &panda_model::ReachabilityMap::size)
+      .def_property_readonly("frame", &panda_model::ReachabilityMap::frame,
+                             "The frame whose positions are binned.")
+      .def_property_readonly("lower", &panda_model::ReachabilityMap::lower,
+                             "Lower corner of the voxel grid in the base frame.")
+      .def_property_readonly("resolution",
+                             &panda_model::ReachabilityMap::resolution,
+                             "Edge length of the voxels.")
+      .def_property_readonly("shape", &panda_model::ReachabilityMap::shape,
+                             "Number of voxels along the x, y and z axes.")
+      .def_property_readonly("samples", &panda_model::ReachabilityMap::samples,
+                             "Number of joint positions the map was generated "
+                             "from, including those outside the grid.")
+      .def(
+          "index",
+          [](const panda_model::ReachabilityMap &map,
+             const Eigen::Vector3d &position) -> py::object {
+            size_t index = map.index(position);
+            if (index == map.size()) {
+              return py::none();
+            }
+            return py::int_(index);
+          },
+          py::arg("position"), R"delim(
+           Gets the voxel containing the given position.
+
+           Args:
+             position: Position in the base frame.
+
+           Returns:
+             Flat index of the voxel in C order, or None if the position is
+             outside the grid.
+           )delim")
+      .def(
+          "center",
+          [](const panda_model::ReachabilityMap &map, size_t index) {
+            if (index >= map.size()) {
+              throw py::index_error("Voxel index out of range.");
+            }
+            return map.center(index);
+          },
+          py::arg("index"), R"delim(
+           Gets the center of the given voxel.
+
+           Args:
+             index: Flat index of the voxel in C order.
+
+           Returns:
+             Center in the base frame.
+           )delim")
+      .def_property_readonly(
+          "counts",
+          [](const panda_model::ReachabilityMap &map) {
+            return voxelArray(map, map.counts());
+          },
+          "Number of samples per voxel of the grid's shape, zero for "
+          "unreachable voxels.")
+      .def_property_readonly(
+          "mean_manipulability",
+          [](const panda_model::ReachabilityMap &map) {
+            return voxelArray(map, map.meanManipulability());
+          },
+          "Mean manipulability of the samples per voxel, zero for unreachable "
+          "voxels.")
+      .def_property_readonly(
+          "max_manipulability",
+          [](const panda_model::ReachabilityMap &map) {
+            return voxelArray(map, map.maxManipulability());
+          },
+          "Largest manipulability of the samples per voxel, zero for "
+          "unreachable voxels.")
+      .def_property_readonly(
+          "min_condition",
+          [](const panda_model::ReachabilityMap &map) {
+            return voxelArray(map, map.minCondition());
+          },
+          "Smallest condition number of the samples per voxel, infinite for "
+          "unreachable voxels.");
 }
@@ -0,0 +1,196 @@
+#include "pandamodel/bound_model.h"
+
+#include <stdexcept>
+
+namespace panda_model {
+
+struct BoundModel::Parameters {
+  Eigen::Matrix4d F_T_EE;
+  Eigen::Matrix4d EE_T_K;
+  // Precomputed F_T_EE * EE_T_K, used in place of F_T_EE for the stiffness frame.
+  Eigen::Matrix4d F_T_K;
+  Eigen::Matrix3d I_total;
+  double m_total;
+  Eigen::Vector3d F_x_Ctotal;
+  Eigen::Vector3d gravity_earth;
+
+  // Calls visit(data, size) for all members in the order of their published values.
+  template <typename Self, typename Visit>
+  static void forEach(Self& parameters, Visit visit) noexcept {
+    visit(parameters.F_T_EE.data(), 16);
+    visit(parameters.EE_T_K.data(), 16);
+    visit(parameters.F_T_K.data(), 16);
+    visit(parameters.I_total.data(), 9);
+    visit(&parameters.m_total, 1);
+    visit(parameters.F_x_Ctotal.data(), 3);
+    visit(parameters.gravity_earth.data(), 3);
+  }
+
+  void load(const std::atomic<double>* values) noexcept {
+    forEach(*this, [&](double* data, std::size_t size) {
+      for (std::size_t i = 0; i < size; i++) {
+        data[i] = (values++)->load(std::memory_order_relaxed);
+      }
+    });
+  }
+
+  void store(std::atomic<double>* values) const noexcept {
+    forEach(*this, [&](const double* data, std::size_t size) {
+      for (std::size_t i = 0; i < size; i++) {
+        (values++)->store(data[i], std::memory_order_relaxed);
+      }
+    });
+  }
+
+  // Gets the frame to query the model for and the matching end effector transformation.
+  Frame resolve(Frame frame, const double** F_T_EE_data) const noexcept {
+    if (frame == Frame::kStiffness) {
+      *F_T_EE_data = F_T_K.data();
+      return Frame::kEndEffector;
+    }
+    *F_T_EE_data = F_T_EE.data();
+    return frame;
+  }
+};
+
+BoundModel::BoundModel(const Model& model,
+                       const Eigen::Matrix4d& F_T_EE,
+                       const Eigen::Matrix4d& EE_T_K,
+                       const Eigen::Matrix3d& I_total,
+                       double m_total,
+                       const Eigen::Vector3d& F_x_Ctotal,
+                       const Eigen::Vector3d& gravity_earth)
+    : model_(model) {
+  static_assert(sizeof(Parameters) == kParameterCount * sizeof(double),
+                "Parameters must consist of kParameterCount values.");
+  Parameters parameters;
+  parameters.F_T_EE = F_T_EE;
+  parameters.EE_T_K = EE_T_K;
+  parameters.F_T_K = F_T_EE * EE_T_K;
+  parameters.I_total = I_total;
+  parameters.m_total = m_total;
+  parameters.F_x_Ctotal = F_x_Ctotal;
+  parameters.gravity_earth = gravity_earth;
+  parameters.store(values_[0]);
+  parameters.store(values_[1]);
+}
+
+BoundModel::Parameters BoundModel::parameters() const noexcept {
+  // Retries only if a replacement switched copies while this one was read, never waits for it.
+  Parameters parameters;
+  while (true) {
+    const std::uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    parameters.load(values_[sequence & 1]);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) == sequence) {
+      return parameters;
+    }
+  }
+}
+
+void BoundModel::publish(const Parameters& parameters) noexcept {
+  // Moves the readers to the other copy before writing each one.
+  std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  for (int copy = 0; copy < 2; copy++) {
+    sequence_.store(++sequence, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    parameters.store(values_[(sequence + 1) & 1]);
+  }
+}
+
+void BoundModel::setTool(const Eigen::Matrix4d& F_T_EE, const Eigen::Matrix4d& EE_T_K) {
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  Parameters parameters = this->parameters();
+  parameters.F_T_EE = F_T_EE;
+  parameters.EE_T_K = EE_T_K;
+  parameters.F_T_K = F_T_EE * EE_T_K;
+  publish(parameters);
+}
+
+void BoundModel::setPayload(const Eigen::Matrix3d& I_total,
+                            double m_total,
+                            const Eigen::Vector3d& F_x_Ctotal) {
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  Parameters parameters = this->parameters();
+  parameters.I_total = I_total;
+  parameters.m_total = m_total;
+  parameters.F_x_Ctotal = F_x_Ctotal;
+  publish(parameters);
+}
+
+Eigen::Matrix4d BoundModel::pose(Frame frame, const Eigen::Matrix<double, 7, 1>& q) const {
+  const Parameters parameters = this->parameters();
+  const double* F_T_EE;
+  Frame resolved = parameters.resolve(frame, &F_T_EE);
+  Eigen::Matrix4d output;
+  if (!model_.pose(resolved, q.data(), F_T_EE, parameters.EE_T_K.data(), output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+Eigen::Matrix<double, 6, 7> BoundModel::bodyJacobian(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q) const {
+  const Parameters parameters = this->parameters();
+  const double* F_T_EE;
+  Frame resolved = parameters.resolve(frame, &F_T_EE);
+  Eigen::Matrix<double, 6, 7> output;
+  if (!model_.bodyJacobian(resolved, q.data(), F_T_EE, parameters.EE_T_K.data(),
+                           output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+Eigen::Matrix<double, 6, 7> BoundModel::zeroJacobian(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q) const {
+  const Parameters parameters = this->parameters();
+  const double* F_T_EE;
+  Frame resolved = parameters.resolve(frame, &F_T_EE);
+  Eigen::Matrix<double, 6, 7> output;
+  if (!model_.zeroJacobian(resolved, q.data(), F_T_EE, parameters.EE_T_K.data(),
+                           output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+Eigen::Matrix<double, 7, 7> BoundModel::mass(
+    const Eigen::Matrix<double, 7, 1>& q) const noexcept {
+  const Parameters parameters = this->parameters();
+  Eigen::Matrix<double, 7, 7> output;
+  model_.mass(q.data(), parameters.I_total.data(), parameters.m_total,
+              parameters.F_x_Ctotal.data(), output.data());
+  return output;
+}
+
+Eigen::Matrix<double, 7, 1> BoundModel::coriolis(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq) const noexcept {
+  const Parameters parameters = this->parameters();
+  Eigen::Matrix<double, 7, 1> output;
+  model_.coriolis(q.data(), dq.data(), parameters.I_total.data(), parameters.m_total,
+                  parameters.F_x_Ctotal.data(), output.data());
+  return output;
+}
+
+Eigen::Matrix<double, 7, 1> BoundModel::gravity(
+    const Eigen::Matrix<double, 7, 1>& q) const noexcept {
+  const Parameters parameters = this->parameters();
+  Eigen::Matrix<double, 7, 1> output;
+  model_.gravity(q.data(), parameters.m_total, parameters.F_x_Ctotal.data(),
+                 parameters.gravity_earth.data(), output.data());
+  return output;
+}
+
+void BoundModel::computeState(const Eigen::Matrix<double, 7, 1>& q,
+                              const Eigen::Matrix<double, 7, 1>& dq,
+                              DynamicsState& state) const noexcept {
+  const Parameters parameters = this->parameters();
+  model_.computeState(q, dq, state, parameters.F_T_EE, parameters.I_total,
+                      parameters.m_total, parameters.F_x_Ctotal, parameters.gravity_earth);
+}
+
+}  // namespace panda_model
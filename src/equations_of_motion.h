@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Eigen/Core>
+
+#include "pandamodel/mass_factorization.h"
+#include "pandamodel/model.h"
+
+// Forward dynamics shared by the Rollout and Linearization engines.
+
+namespace panda_model {
+namespace detail {
+
+/**
+ * Equations of motion of a Model with a fixed load.
+ */
+struct Dynamics {
+  using Vector7d = Eigen::Matrix<double, 7, 1>;
+
+  const Model& model;
+  const Eigen::Matrix3d& I_total;
+  double m_total;
+  const Eigen::Vector3d& F_x_Ctotal;
+  const Eigen::Vector3d& gravity_earth;
+
+  /**
+   * Calculates the joint acceleration and leaves the factorized mass matrix in the given
+   * factorization.
+   */
+  Vector7d acceleration(const Vector7d& q,
+                        const Vector7d& dq,
+                        const Vector7d& tau,
+                        MassFactorization& mass) const {
+    Vector7d coriolis, gravity;
+    model.mass(q.data(), I_total.data(), m_total, F_x_Ctotal.data(), mass.data());
+    mass.computeInPlace();
+    model.coriolis(q.data(), dq.data(), I_total.data(), m_total, F_x_Ctotal.data(),
+                   coriolis.data());
+    model.gravity(q.data(), m_total, F_x_Ctotal.data(), gravity_earth.data(), gravity.data());
+    return mass.solve(tau - coriolis - gravity);
+  }
+
+  Vector7d acceleration(const Vector7d& q, const Vector7d& dq, const Vector7d& tau) const {
+    MassFactorization mass;
+    return acceleration(q, dq, tau, mass);
+  }
+};
+
+}  // namespace detail
+}  // namespace panda_model
@@ -0,0 +1,281 @@
+#include "pandamodel/ik_seed_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/SharedMemory.h>
+
+using namespace std::string_literals;  // NOLINT(google-build-using-namespace)
+
+namespace panda_model {
+
+namespace {
+
+// Position followed by the scaled x and y axes of the frame.
+constexpr std::size_t kFeatureSize = 9;
+
+constexpr char kMagic[8] = {'P', 'M', 'S', 'E', 'E', 'D', 'S', '\0'};
+constexpr std::uint32_t kVersion = 1;
+
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t frame;
+  std::uint64_t size;
+  double orientation_scale;
+};
+
+/**
+ * Byte offsets of the sections of an index with the given number of poses. Sections start on
+ * cache line boundaries.
+ */
+struct Layout {
+  explicit Layout(std::size_t size)
+      : features(align(sizeof(Header))),
+        q(align(features + sizeof(float) * kFeatureSize * size)),
+        split(align(q + sizeof(float) * 7 * size)),
+        bytes(split + size) {}
+
+  static std::size_t align(std::size_t offset) { return (offset + 63) & ~std::size_t{63}; }
+
+  std::size_t features;
+  std::size_t q;
+  std::size_t split;
+  std::size_t bytes;
+};
+
+void computeFeature(const double* pose, double orientation_scale, float* output) {
+  const Eigen::Map<const Eigen::Matrix4d> O_T_F(pose);
+  for (Eigen::Index row = 0; row < 3; row++) {
+    output[row] = static_cast<float>(O_T_F(row, 3));
+    output[3 + row] = static_cast<float>(orientation_scale * O_T_F(row, 0));
+    output[6 + row] = static_cast<float>(orientation_scale * O_T_F(row, 1));
+  }
+}
+
+/**
+ * Orders the given range so that every subrange's median splits it along the dimension of its
+ * largest spread, which is recorded at the median.
+ */
+void buildTree(const std::vector<float>& features,
+               std::size_t* order,
+               std::uint8_t* split,
+               std::size_t begin,
+               std::size_t end) {
+  if (begin >= end) {
+    return;
+  }
+  float lower[kFeatureSize], upper[kFeatureSize];
+  std::fill(lower, lower + kFeatureSize, std::numeric_limits<float>::infinity());
+  std::fill(upper, upper + kFeatureSize, -std::numeric_limits<float>::infinity());
+  for (std::size_t i = begin; i < end; i++) {
+    const float* feature = features.data() + kFeatureSize * order[i];
+    for (std::size_t dim = 0; dim < kFeatureSize; dim++) {
+      lower[dim] = std::min(lower[dim], feature[dim]);
+      upper[dim] = std::max(upper[dim], feature[dim]);
+    }
+  }
+  std::size_t dim = 0;
+  for (std::size_t candidate = 1; candidate < kFeatureSize; candidate++) {
+    if (upper[candidate] - lower[candidate] > upper[dim] - lower[dim]) {
+      dim = candidate;
+    }
+  }
+  const std::size_t median = begin + (end - begin) / 2;
+  std::nth_element(order + begin, order + median, order + end,
+                   [&features, dim](std::size_t a, std::size_t b) {
+                     return features[kFeatureSize * a + dim] < features[kFeatureSize * b + dim];
+                   });
+  split[median] = static_cast<std::uint8_t>(dim);
+  buildTree(features, order, split, begin, median);
+  buildTree(features, order, split, median + 1, end);
+}
+
+/**
+ * Branch and bound search for the k nearest features, kept in a max-heap of squared
+ * distances.
+ */
+struct Search {
+  const float* features;
+  const std::uint8_t* split;
+  const float* target;
+  std::size_t k;
+  std::vector<std::pair<float, std::size_t>> heap;
+
+  void visit(std::size_t begin, std::size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    const std::size_t median = begin + (end - begin) / 2;
+    const float* feature = features + kFeatureSize * median;
+    float distance = 0.f;
+    for (std::size_t dim = 0; dim < kFeatureSize; dim++) {
+      const float difference = target[dim] - feature[dim];
+      distance += difference * difference;
+    }
+    if (heap.size() < k) {
+      heap.emplace_back(distance, median);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (distance < heap.front().first) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = {distance, median};
+      std::push_heap(heap.begin(), heap.end());
+    }
+
+    const float offset = target[split[median]] - feature[split[median]];
+    const bool left_first = offset < 0.f;
+    visit(left_first ? begin : median + 1, left_first ? median : end);
+    if (heap.size() < k || offset * offset < heap.front().first) {
+      visit(left_first ? median + 1 : begin, left_first ? end : median);
+    }
+  }
+};
+
+}  // anonymous namespace
+
+IKSeedIndex::IKSeedIndex(std::shared_ptr<const char> data, std::size_t bytes)
+    : data_(std::move(data)), bytes_(bytes) {
+  Header header;
+  if (bytes_ < sizeof(Header)) {
+    throw std::runtime_error("Invalid IK seed index: file is truncated.");
+  }
+  std::memcpy(&header, data_.get(), sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+    throw std::runtime_error("Invalid IK seed index: unknown format.");
+  }
+  if (header.frame >= kFrameCount) {
+    throw std::runtime_error("Invalid IK seed index: invalid frame.");
+  }
+  // Every pose takes more than one byte, which also rules out overflowing sizes.
+  const Layout layout(header.size);
+  if (header.size > bytes_ || bytes_ < layout.bytes) {
+    throw std::runtime_error("Invalid IK seed index: file is truncated.");
+  }
+  const std::uint8_t* split = reinterpret_cast<const std::uint8_t*>(data_.get() + layout.split);
+  if (std::any_of(split, split + header.size,
+                  [](std::uint8_t dim) { return dim >= kFeatureSize; })) {
+    throw std::runtime_error("Invalid IK seed index: invalid split dimension.");
+  }
+  size_ = header.size;
+  frame_ = static_cast<Frame>(header.frame);
+  orientation_scale_ = header.orientation_scale;
+  features_ = reinterpret_cast<const float*>(data_.get() + layout.features);
+  q_ = reinterpret_cast<const float*>(data_.get() + layout.q);
+  split_ = split;
+}
+
+IKSeedIndex IKSeedIndex::build(const Model& model,
+                               const double* q,
+                               std::size_t n,
+                               Frame frame,
+                               double orientation_scale,
+                               const Eigen::Matrix4d& F_T_EE,
+                               const Eigen::Matrix4d& EE_T_K) {
+  std::vector<double> poses(16 * n);
+  model.poseBatch(frame, q, n, poses.data(), F_T_EE, EE_T_K);
+  std::vector<float> features(kFeatureSize * n);
+  for (std::size_t i = 0; i < n; i++) {
+    computeFeature(poses.data() + 16 * i, orientation_scale, features.data() + kFeatureSize * i);
+  }
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::vector<std::uint8_t> split(n);
+  buildTree(features, order.data(), split.data(), 0, n);
+
+  const Layout layout(n);
+  auto buffer = std::make_shared<std::vector<char>>(layout.bytes);
+  char* data = buffer->data();
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.frame = static_cast<std::uint32_t>(frame);
+  header.size = n;
+  header.orientation_scale = orientation_scale;
+  std::memcpy(data, &header, sizeof(Header));
+  float* sorted_features = reinterpret_cast<float*>(data + layout.features);
+  float* sorted_q = reinterpret_cast<float*>(data + layout.q);
+  for (std::size_t i = 0; i < n; i++) {
+    std::copy_n(features.data() + kFeatureSize * order[i], kFeatureSize,
+                sorted_features + kFeatureSize * i);
+    std::transform(q + 7 * order[i], q + 7 * order[i] + 7, sorted_q + 7 * i,
+                   [](double value) { return static_cast<float>(value); });
+  }
+  std::copy(split.begin(), split.end(), data + layout.split);
+  return IKSeedIndex(std::shared_ptr<const char>(buffer, data), layout.bytes);
+}
+
+IKSeedIndex IKSeedIndex::load(const std::string& path) try {
+  auto mapping =
+      std::make_shared<Poco::SharedMemory>(Poco::File(path), Poco::SharedMemory::AM_READ);
+  const std::size_t bytes = static_cast<std::size_t>(mapping->end() - mapping->begin());
+  return IKSeedIndex(std::shared_ptr<const char>(mapping, mapping->begin()), bytes);
+} catch (const Poco::Exception& e) {
+  throw std::runtime_error("Cannot map IK seed index: "s + e.displayText());
+}
+
+void IKSeedIndex::save(const std::string& path) const {
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  stream.write(data_.get(), static_cast<std::streamsize>(bytes_));
+  if (!stream) {
+    throw std::runtime_error("Cannot write IK seed index: "s + path);
+  }
+}
+
+std::size_t IKSeedIndex::size() const noexcept {
+  return size_;
+}
+
+Frame IKSeedIndex::frame() const noexcept {
+  return frame_;
+}
+
+double IKSeedIndex::orientationScale() const noexcept {
+  return orientation_scale_;
+}
+
+std::size_t IKSeedIndex::nearest(const Eigen::Matrix4d& target,
+                                 std::size_t k,
+                                 double* seeds,
+                                 double* distances) const {
+  // The search compares against the farthest of the k nearest, so it needs k > 0.
+  if (k == 0 || size_ == 0) {
+    return 0;
+  }
+  float feature[kFeatureSize];
+  computeFeature(target.data(), orientation_scale_, feature);
+  Search search{features_, split_, feature, std::min(k, size_), {}};
+  search.heap.reserve(search.k);
+  search.visit(0, size_);
+  std::sort_heap(search.heap.begin(), search.heap.end());
+  for (std::size_t i = 0; i < search.heap.size(); i++) {
+    const std::size_t index = search.heap[i].second;
+    std::copy_n(q_ + 7 * index, 7, seeds + 7 * i);
+    if (distances != nullptr) {
+      distances[i] = std::sqrt(static_cast<double>(search.heap[i].first));
+    }
+  }
+  return search.heap.size();
+}
+
+void IKSeedIndex::nearest(const double* targets,
+                          std::size_t n,
+                          std::size_t k,
+                          double* seeds,
+                          double* distances) const {
+  const std::size_t count = std::min(k, size_);
+  for (std::size_t i = 0; i < n; i++) {
+    nearest(Eigen::Map<const Eigen::Matrix4d>(targets + 16 * i), k, seeds + 7 * count * i,
+            distances != nullptr ? distances + count * i : nullptr);
+  }
+}
+
+}  // namespace panda_model
@@ -0,0 +1,121 @@
+#include "pandamodel/inverse_kinematics.h"
+
+#include <stdexcept>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Geometry>
+
+namespace panda_model {
+
+namespace {
+
+using Vector6d = Eigen::Matrix<double, 6, 1>;
+using Vector7d = Eigen::Matrix<double, 7, 1>;
+
+/**
+ * Pose error of a frame: translation followed by the rotation vector, both relative to the
+ * base frame.
+ */
+Vector6d poseError(const Eigen::Matrix4d& pose, const Eigen::Matrix4d& target) {
+  Vector6d error;
+  error.head<3>() = target.topRightCorner<3, 1>() - pose.topRightCorner<3, 1>();
+  const Eigen::AngleAxisd rotation(target.topLeftCorner<3, 3>() *
+                                   pose.topLeftCorner<3, 3>().transpose());
+  error.tail<3>() = rotation.angle() * rotation.axis();
+  return error;
+}
+
+IKSolution solveQuery(const Model& model,
+                      Frame frame,
+                      const Eigen::Matrix4d& target,
+                      const double* seed,
+                      const IKOptions& options,
+                      const Eigen::Matrix4d& F_T_EE,
+                      const Eigen::Matrix4d& EE_T_K) {
+  IKSolution solution;
+  Vector7d& q = solution.q;
+  q = Eigen::Map<const Vector7d>(seed).cwiseMax(options.q_min).cwiseMin(options.q_max);
+  solution.status = IKStatus::kMaxIterations;
+  solution.iterations = 0;
+
+  const double damping = options.damping * options.damping;
+  Eigen::Matrix4d pose;
+  Eigen::Matrix<double, 6, 7> jacobian;
+  while (true) {
+    model.pose(frame, q.data(), F_T_EE.data(), EE_T_K.data(), pose.data());
+    const Vector6d error = poseError(pose, target);
+    solution.position_error = error.head<3>().norm();
+    solution.orientation_error = error.tail<3>().norm();
+    if (solution.position_error <= options.position_tolerance &&
+        solution.orientation_error <= options.orientation_tolerance) {
+      solution.status = IKStatus::kConverged;
+      break;
+    }
+    if (solution.iterations == options.max_iterations) {
+      break;
+    }
+
+    model.zeroJacobian(frame, q.data(), F_T_EE.data(), EE_T_K.data(), jacobian.data());
+    Eigen::Matrix<double, 6, 6> JJt = jacobian * jacobian.transpose();
+    JJt.diagonal().array() += damping;
+    Vector7d step = jacobian.transpose() * JJt.ldlt().solve(error);
+    const double norm = step.norm();
+    if (norm > options.max_step) {
+      step *= options.max_step / norm;
+    }
+    const Vector7d next = (q + step).cwiseMax(options.q_min).cwiseMin(options.q_max);
+    solution.iterations++;
+    if ((next - q).norm() < options.min_step) {
+      solution.status = IKStatus::kStalled;
+      break;
+    }
+    q = next;
+  }
+  return solution;
+}
+
+void checkFrame(Frame frame) {
+  if (static_cast<std::size_t>(frame) >= kFrameCount) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+}
+
+}  // anonymous namespace
+
+InverseKinematics::InverseKinematics(const Model& model,
+                                     std::size_t num_threads,
+                                     std::size_t grain_size)
+    : model_(model), pool_(num_threads), grain_size_(grain_size) {}
+
+std::size_t InverseKinematics::numThreads() const noexcept {
+  return pool_.size();
+}
+
+IKSolution InverseKinematics::solve(Frame frame,
+                                    const Eigen::Matrix4d& target,
+                                    const Eigen::Matrix<double, 7, 1>& seed,
+                                    const IKOptions& options,
+                                    const Eigen::Matrix4d& F_T_EE,
+                                    const Eigen::Matrix4d& EE_T_K) const {
+  checkFrame(frame);
+  return solveQuery(model_, frame, target, seed.data(), options, F_T_EE, EE_T_K);
+}
+
+void InverseKinematics::solve(Frame frame,
+                              const double* targets,
+                              const double* seeds,
+                              std::size_t n,
+                              IKSolution* output,
+                              const IKOptions& options,
+                              const Eigen::Matrix4d& F_T_EE,
+                              const Eigen::Matrix4d& EE_T_K) {
+  checkFrame(frame);
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) {
+      output[i] = solveQuery(model_, frame, Eigen::Map<const Eigen::Matrix4d>(targets + 16 * i),
+                             seeds + 7 * i, options, F_T_EE, EE_T_K);
+    }
+  });
+}
+
+}  // namespace panda_model
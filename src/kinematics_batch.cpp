@@ -0,0 +1,80 @@
+#include "pandamodel/kinematics_batch.h"
+
+#include <Eigen/Core>
+
+#include "pandamodel/kinematics.h"
+#include "pose_kernel.h"
+
+namespace panda_model {
+namespace kinematics {
+
+namespace {
+
+bool cpuSupports(InstructionSet instruction_set) noexcept {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  switch (instruction_set) {
+    case InstructionSet::kAVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case InstructionSet::kAVX512:
+      return __builtin_cpu_supports("avx512f");
+    default:
+      return true;
+  }
+#else
+  return instruction_set == InstructionSet::kScalar;
+#endif
+}
+
+detail::PoseKernel kernel(InstructionSet instruction_set) noexcept {
+  switch (instruction_set) {
+    case InstructionSet::kAVX2:
+      return detail::avx2PoseKernel();
+    case InstructionSet::kAVX512:
+      return detail::avx512PoseKernel();
+    default:
+      return &detail::poseKernel<double>;
+  }
+}
+
+}  // anonymous namespace
+
+bool isSupported(InstructionSet instruction_set) noexcept {
+  return kernel(instruction_set) != nullptr && cpuSupports(instruction_set);
+}
+
+InstructionSet bestInstructionSet() noexcept {
+  static const InstructionSet best = isSupported(InstructionSet::kAVX512) ? InstructionSet::kAVX512
+                                     : isSupported(InstructionSet::kAVX2) ? InstructionSet::kAVX2
+                                                                          : InstructionSet::kScalar;
+  return best;
+}
+
+bool poseBatch(
+    Frame frame,
+    const double* q,
+    std::size_t n,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output,
+    InstructionSet instruction_set) noexcept {
+  if (!detail::isValid(frame)) {
+    return false;
+  }
+  if (!isSupported(instruction_set)) {
+    instruction_set = bestInstructionSet();
+  }
+  const detail::PoseKernel pose_kernel = kernel(instruction_set);
+  if (frame == Frame::kEndEffector) {
+    pose_kernel(kLinkCount, q, n, F_T_EE, output);
+  } else if (frame == Frame::kStiffness) {
+    const Eigen::Matrix4d F_T_K =
+        Eigen::Map<const Eigen::Matrix4d>(F_T_EE) * Eigen::Map<const Eigen::Matrix4d>(EE_T_K);
+    pose_kernel(kLinkCount, q, n, F_T_K.data(), output);
+  } else {
+    pose_kernel(detail::linkCount(frame), q, n, nullptr, output);
+  }
+  return true;
+}
+
+}  // namespace kinematics
+}  // namespace panda_model
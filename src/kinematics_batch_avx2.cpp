@@ -0,0 +1,26 @@
+// Built with AVX2 and FMA enabled on x86, see CMakeLists.txt.
+#include "pose_kernel.h"
+
+namespace panda_model {
+namespace kinematics {
+namespace detail {
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+typedef double Pack4 __attribute__((vector_size(4 * sizeof(double))));
+
+PoseKernel avx2PoseKernel() noexcept {
+  return &poseKernel<Pack4>;
+}
+
+#else
+
+PoseKernel avx2PoseKernel() noexcept {
+  return nullptr;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace kinematics
+}  // namespace panda_model
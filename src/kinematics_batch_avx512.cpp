@@ -0,0 +1,26 @@
+// Built with AVX-512 enabled on x86, see CMakeLists.txt.
+#include "pose_kernel.h"
+
+namespace panda_model {
+namespace kinematics {
+namespace detail {
+
+#if defined(__AVX512F__)
+
+typedef double Pack8 __attribute__((vector_size(8 * sizeof(double))));
+
+PoseKernel avx512PoseKernel() noexcept {
+  return &poseKernel<Pack8>;
+}
+
+#else
+
+PoseKernel avx512PoseKernel() noexcept {
+  return nullptr;
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace kinematics
+}  // namespace panda_model
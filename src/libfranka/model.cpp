@@ -3,12 +3,21 @@
 // #include <franka/model.h>
 #include "pandamodel/model.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
-#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
+#include <Eigen/Cholesky>
 #include <Eigen/Core>
 
 #include "model_library.h"
+#include "pandamodel/dynamics.h"
+#include "pandamodel/kinematics.h"
+#include "pandamodel/kinematics_batch.h"
 #include "service_types.h"
 
 using namespace std::string_literals;  // NOLINT(google-build-using-namespace)
@@ -23,151 +32,411 @@ Frame operator++(Frame& frame, int /* dummy */) noexcept {
 
 Model::Model(const std::string &path) : library_{new ModelLibrary(path)} {}
 
+Model::Model(std::unique_ptr<ModelLibrary> library) noexcept : library_{std::move(library)} {}
+
+Model Model::native() {
+  return Model(std::make_unique<ModelLibrary>());
+}
+
 // Has to be declared here, as the ModelLibrary type is incomplete in the header
 Model::~Model() noexcept = default;
 Model::Model(Model&&) noexcept = default;
 Model& Model::operator=(Model&&) noexcept = default;
 
-Eigen::Matrix4d Model::pose(
+bool Model::pose(
     Frame frame,
-    const Eigen::Matrix<double, 7, 1>& q,
-    const Eigen::Matrix4d& F_T_EE,
-    const Eigen::Matrix4d& EE_T_K)
-    const {
-  std::array<double, 16> output;
+    const double* q,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
   switch (frame) {
     case Frame::kJoint1:
-      library_->joint1(q.data(), output.data());
+      library_->joint1(q, output);
       break;
     case Frame::kJoint2:
-      library_->joint2(q.data(), output.data());
+      library_->joint2(q, output);
       break;
     case Frame::kJoint3:
-      library_->joint3(q.data(), output.data());
+      library_->joint3(q, output);
       break;
     case Frame::kJoint4:
-      library_->joint4(q.data(), output.data());
+      library_->joint4(q, output);
       break;
     case Frame::kJoint5:
-      library_->joint5(q.data(), output.data());
+      library_->joint5(q, output);
       break;
     case Frame::kJoint6:
-      library_->joint6(q.data(), output.data());
+      library_->joint6(q, output);
       break;
     case Frame::kJoint7:
-      library_->joint7(q.data(), output.data());
+      library_->joint7(q, output);
       break;
     case Frame::kFlange:
-      library_->flange(q.data(), output.data());
+      library_->flange(q, output);
       break;
     case Frame::kEndEffector:
-      library_->ee(q.data(), F_T_EE.data(), output.data());
+      library_->ee(q, F_T_EE, output);
       break;
-    case Frame::kStiffness:
-      library_->ee(
-          q.data(),
-          Eigen::Matrix4d(Eigen::Matrix4d(F_T_EE.data()) * Eigen::Matrix4d(EE_T_K.data())).data(),
-          output.data());
+    case Frame::kStiffness: {
+      const Eigen::Matrix4d F_T_K =
+          Eigen::Map<const Eigen::Matrix4d>(F_T_EE) * Eigen::Map<const Eigen::Matrix4d>(EE_T_K);
+      library_->ee(q, F_T_K.data(), output);
       break;
+    }
     default:
-      throw std::invalid_argument("Invalid frame given.");
+      return false;
   }
-  return Eigen::Map<const Eigen::Matrix4d>(output.data());
+  return true;
 }
 
-Eigen::Matrix<double, 6, 7> Model::bodyJacobian(
+bool Model::pose(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K,
+    Eigen::Ref<Eigen::Matrix4d, 0, Eigen::OuterStride<4>> output)
+    const noexcept {
+  return pose(frame, q.data(), F_T_EE.data(), EE_T_K.data(), output.data());
+}
+
+Eigen::Matrix4d Model::pose(
     Frame frame,
     const Eigen::Matrix<double, 7, 1>& q,
     const Eigen::Matrix4d& F_T_EE,
     const Eigen::Matrix4d& EE_T_K)
     const {
-  std::array<double, 42> output;
+  Eigen::Matrix4d output;
+  if (!pose(frame, q.data(), F_T_EE.data(), EE_T_K.data(), output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+bool Model::bodyJacobian(
+    Frame frame,
+    const double* q,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
   switch (frame) {
     case Frame::kJoint1:
-      library_->body_jacobian_joint1(output.data());
+      library_->body_jacobian_joint1(output);
       break;
     case Frame::kJoint2:
-      library_->body_jacobian_joint2(q.data(), output.data());
+      library_->body_jacobian_joint2(q, output);
       break;
     case Frame::kJoint3:
-      library_->body_jacobian_joint3(q.data(), output.data());
+      library_->body_jacobian_joint3(q, output);
       break;
     case Frame::kJoint4:
-      library_->body_jacobian_joint4(q.data(), output.data());
+      library_->body_jacobian_joint4(q, output);
       break;
     case Frame::kJoint5:
-      library_->body_jacobian_joint5(q.data(), output.data());
+      library_->body_jacobian_joint5(q, output);
       break;
     case Frame::kJoint6:
-      library_->body_jacobian_joint6(q.data(), output.data());
+      library_->body_jacobian_joint6(q, output);
       break;
     case Frame::kJoint7:
-      library_->body_jacobian_joint7(q.data(), output.data());
+      library_->body_jacobian_joint7(q, output);
       break;
     case Frame::kFlange:
-      library_->body_jacobian_flange(q.data(), output.data());
+      library_->body_jacobian_flange(q, output);
       break;
     case Frame::kEndEffector:
-      library_->body_jacobian_ee(q.data(), F_T_EE.data(), output.data());
+      library_->body_jacobian_ee(q, F_T_EE, output);
       break;
-    case Frame::kStiffness:
-      library_->body_jacobian_ee(
-          q.data(),
-          Eigen::Matrix4d(Eigen::Matrix4d(F_T_EE.data()) * Eigen::Matrix4d(EE_T_K.data())).data(),
-          output.data());
+    case Frame::kStiffness: {
+      const Eigen::Matrix4d F_T_K =
+          Eigen::Map<const Eigen::Matrix4d>(F_T_EE) * Eigen::Map<const Eigen::Matrix4d>(EE_T_K);
+      library_->body_jacobian_ee(q, F_T_K.data(), output);
       break;
+    }
     default:
-      throw std::invalid_argument("Invalid frame given.");
+      return false;
   }
-  return Eigen::Map<const Eigen::Matrix<double, 6, 7>>(output.data());
+  return true;
 }
 
-Eigen::Matrix<double, 6, 7> Model::zeroJacobian(
+bool Model::bodyJacobian(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K,
+    Eigen::Ref<Eigen::Matrix<double, 6, 7>, 0, Eigen::OuterStride<6>> output)
+    const noexcept {
+  return bodyJacobian(frame, q.data(), F_T_EE.data(), EE_T_K.data(), output.data());
+}
+
+Eigen::Matrix<double, 6, 7> Model::bodyJacobian(
     Frame frame,
     const Eigen::Matrix<double, 7, 1>& q,
     const Eigen::Matrix4d& F_T_EE,
     const Eigen::Matrix4d& EE_T_K)
     const {
-  std::array<double, 42> output;
+  Eigen::Matrix<double, 6, 7> output;
+  if (!bodyJacobian(frame, q.data(), F_T_EE.data(), EE_T_K.data(), output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+bool Model::zeroJacobian(
+    Frame frame,
+    const double* q,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
   switch (frame) {
     case Frame::kJoint1:
-      library_->zero_jacobian_joint1(output.data());
+      library_->zero_jacobian_joint1(output);
       break;
     case Frame::kJoint2:
-      library_->zero_jacobian_joint2(q.data(), output.data());
+      library_->zero_jacobian_joint2(q, output);
       break;
     case Frame::kJoint3:
-      library_->zero_jacobian_joint3(q.data(), output.data());
+      library_->zero_jacobian_joint3(q, output);
       break;
     case Frame::kJoint4:
-      library_->zero_jacobian_joint4(q.data(), output.data());
+      library_->zero_jacobian_joint4(q, output);
       break;
     case Frame::kJoint5:
-      library_->zero_jacobian_joint5(q.data(), output.data());
+      library_->zero_jacobian_joint5(q, output);
       break;
     case Frame::kJoint6:
-      library_->zero_jacobian_joint6(q.data(), output.data());
+      library_->zero_jacobian_joint6(q, output);
       break;
     case Frame::kJoint7:
-      library_->zero_jacobian_joint7(q.data(), output.data());
+      library_->zero_jacobian_joint7(q, output);
       break;
     case Frame::kFlange:
-      library_->zero_jacobian_flange(q.data(), output.data());
+      library_->zero_jacobian_flange(q, output);
       break;
     case Frame::kEndEffector:
-      library_->zero_jacobian_ee(q.data(), F_T_EE.data(), output.data());
+      library_->zero_jacobian_ee(q, F_T_EE, output);
       break;
-    case Frame::kStiffness:
-      library_->zero_jacobian_ee(
-          q.data(),
-          Eigen::Matrix4d(Eigen::Matrix4d(F_T_EE.data()) * Eigen::Matrix4d(EE_T_K.data())).data(),
-          output.data());
+    case Frame::kStiffness: {
+      const Eigen::Matrix4d F_T_K =
+          Eigen::Map<const Eigen::Matrix4d>(F_T_EE) * Eigen::Map<const Eigen::Matrix4d>(EE_T_K);
+      library_->zero_jacobian_ee(q, F_T_K.data(), output);
       break;
+    }
     default:
-      throw std::invalid_argument("Invalid frame given.");
+      return false;
   }
-  std::cout << F_T_EE << std::endl;
-  return Eigen::Map<const Eigen::Matrix<double, 6, 7>>(output.data());
+  return true;
+}
+
+bool Model::zeroJacobian(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K,
+    Eigen::Ref<Eigen::Matrix<double, 6, 7>, 0, Eigen::OuterStride<6>> output)
+    const noexcept {
+  return zeroJacobian(frame, q.data(), F_T_EE.data(), EE_T_K.data(), output.data());
+}
+
+Eigen::Matrix<double, 6, 7> Model::zeroJacobian(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  Eigen::Matrix<double, 6, 7> output;
+  if (!zeroJacobian(frame, q.data(), F_T_EE.data(), EE_T_K.data(), output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+bool Model::bodyJacobianDot(
+    Frame frame,
+    const double* q,
+    const double* dq,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
+  return kinematics::bodyJacobianDot(frame, q, dq, F_T_EE, EE_T_K, output);
+}
+
+bool Model::zeroJacobianDot(
+    Frame frame,
+    const double* q,
+    const double* dq,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
+  return kinematics::zeroJacobianDot(frame, q, dq, F_T_EE, EE_T_K, output);
+}
+
+Eigen::Matrix<double, 6, 7> Model::bodyJacobianDot(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  Eigen::Matrix<double, 6, 7> output;
+  if (!bodyJacobianDot(frame, q.data(), dq.data(), F_T_EE.data(), EE_T_K.data(),
+                       output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+Eigen::Matrix<double, 6, 7> Model::zeroJacobianDot(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  Eigen::Matrix<double, 6, 7> output;
+  if (!zeroJacobianDot(frame, q.data(), dq.data(), F_T_EE.data(), EE_T_K.data(),
+                       output.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+namespace {
+
+// Model library functions of the frames up to the flange, indexed by Frame.
+constexpr decltype(&ModelLibrary::joint1) kPoseFunctions[] = {
+    &ModelLibrary::joint1, &ModelLibrary::joint2, &ModelLibrary::joint3,
+    &ModelLibrary::joint4, &ModelLibrary::joint5, &ModelLibrary::joint6,
+    &ModelLibrary::joint7, &ModelLibrary::flange};
+constexpr decltype(&ModelLibrary::body_jacobian_joint2) kBodyJacobianFunctions[] = {
+    nullptr,
+    &ModelLibrary::body_jacobian_joint2,
+    &ModelLibrary::body_jacobian_joint3,
+    &ModelLibrary::body_jacobian_joint4,
+    &ModelLibrary::body_jacobian_joint5,
+    &ModelLibrary::body_jacobian_joint6,
+    &ModelLibrary::body_jacobian_joint7,
+    &ModelLibrary::body_jacobian_flange};
+constexpr decltype(&ModelLibrary::zero_jacobian_joint2) kZeroJacobianFunctions[] = {
+    nullptr,
+    &ModelLibrary::zero_jacobian_joint2,
+    &ModelLibrary::zero_jacobian_joint3,
+    &ModelLibrary::zero_jacobian_joint4,
+    &ModelLibrary::zero_jacobian_joint5,
+    &ModelLibrary::zero_jacobian_joint6,
+    &ModelLibrary::zero_jacobian_joint7,
+    &ModelLibrary::zero_jacobian_flange};
+
+constexpr std::size_t index(Frame frame) {
+  return static_cast<std::size_t>(frame);
+}
+
+}  // anonymous namespace
+
+template <Frame frame>
+Eigen::Matrix4d Model::pose(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  Eigen::Matrix4d output;
+  if constexpr (frame == Frame::kEndEffector) {
+    library_->ee(q.data(), F_T_EE.data(), output.data());
+  } else if constexpr (frame == Frame::kStiffness) {
+    const Eigen::Matrix4d F_T_K = F_T_EE * EE_T_K;
+    library_->ee(q.data(), F_T_K.data(), output.data());
+  } else {
+    (library_.get()->*kPoseFunctions[index(frame)])(q.data(), output.data());
+  }
+  return output;
+}
+
+template <Frame frame>
+Eigen::Matrix<double, 6, 7> Model::bodyJacobian(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  Eigen::Matrix<double, 6, 7> output;
+  if constexpr (frame == Frame::kJoint1) {
+    library_->body_jacobian_joint1(output.data());
+  } else if constexpr (frame == Frame::kEndEffector) {
+    library_->body_jacobian_ee(q.data(), F_T_EE.data(), output.data());
+  } else if constexpr (frame == Frame::kStiffness) {
+    const Eigen::Matrix4d F_T_K = F_T_EE * EE_T_K;
+    library_->body_jacobian_ee(q.data(), F_T_K.data(), output.data());
+  } else {
+    (library_.get()->*kBodyJacobianFunctions[index(frame)])(q.data(), output.data());
+  }
+  return output;
+}
+
+template <Frame frame>
+Eigen::Matrix<double, 6, 7> Model::zeroJacobian(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  Eigen::Matrix<double, 6, 7> output;
+  if constexpr (frame == Frame::kJoint1) {
+    library_->zero_jacobian_joint1(output.data());
+  } else if constexpr (frame == Frame::kEndEffector) {
+    library_->zero_jacobian_ee(q.data(), F_T_EE.data(), output.data());
+  } else if constexpr (frame == Frame::kStiffness) {
+    const Eigen::Matrix4d F_T_K = F_T_EE * EE_T_K;
+    library_->zero_jacobian_ee(q.data(), F_T_K.data(), output.data());
+  } else {
+    (library_.get()->*kZeroJacobianFunctions[index(frame)])(q.data(), output.data());
+  }
+  return output;
+}
+
+#define PANDA_MODEL_INSTANTIATE_FRAME(frame)                                      \
+  template Eigen::Matrix4d Model::pose<frame>(                                    \
+      const Eigen::Matrix<double, 7, 1>&, const Eigen::Matrix4d&,                 \
+      const Eigen::Matrix4d&) const noexcept;                                     \
+  template Eigen::Matrix<double, 6, 7> Model::bodyJacobian<frame>(                \
+      const Eigen::Matrix<double, 7, 1>&, const Eigen::Matrix4d&,                 \
+      const Eigen::Matrix4d&) const noexcept;                                     \
+  template Eigen::Matrix<double, 6, 7> Model::zeroJacobian<frame>(                \
+      const Eigen::Matrix<double, 7, 1>&, const Eigen::Matrix4d&,                 \
+      const Eigen::Matrix4d&) const noexcept;
+
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kJoint1)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kJoint2)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kJoint3)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kJoint4)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kJoint5)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kJoint6)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kJoint7)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kFlange)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kEndEffector)
+PANDA_MODEL_INSTANTIATE_FRAME(Frame::kStiffness)
+
+#undef PANDA_MODEL_INSTANTIATE_FRAME
+
+void Model::mass(
+    const double* q,
+    const double* I_total,
+    double m_total,
+    const double* F_x_Ctotal,
+    double* output)
+    const noexcept {
+  library_->mass(q, I_total, m_total, F_x_Ctotal, output);
+}
+
+void Model::mass(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    Eigen::Ref<Eigen::Matrix<double, 7, 7>, 0, Eigen::OuterStride<7>> output)
+    const noexcept {
+  library_->mass(q.data(), I_total.data(), m_total, F_x_Ctotal.data(), output.data());
 }
 
 Eigen::Matrix<double, 7, 7> Model::mass(
@@ -176,9 +445,32 @@ Eigen::Matrix<double, 7, 7> Model::mass(
     double m_total,
     const Eigen::Vector3d& F_x_Ctotal)
     const noexcept {
-  std::array<double, 49> output;
+  Eigen::Matrix<double, 7, 7> output;
   library_->mass(q.data(), I_total.data(), m_total, F_x_Ctotal.data(), output.data());
-  return Eigen::Map<const Eigen::Matrix<double, 7, 7>>(output.data());
+  return output;
+}
+
+void Model::coriolis(
+    const double* q,
+    const double* dq,
+    const double* I_total,
+    double m_total,
+    const double* F_x_Ctotal,
+    double* output)
+    const noexcept {
+  library_->coriolis(q, dq, I_total, m_total, F_x_Ctotal, output);
+}
+
+void Model::coriolis(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    Eigen::Ref<Eigen::Matrix<double, 7, 1>> output)
+    const noexcept {
+  library_->coriolis(q.data(), dq.data(), I_total.data(), m_total, F_x_Ctotal.data(),
+                     output.data());
 }
 
 Eigen::Matrix<double, 7, 1> Model::coriolis(
@@ -188,10 +480,30 @@ Eigen::Matrix<double, 7, 1> Model::coriolis(
     double m_total,
     const Eigen::Vector3d& F_x_Ctotal)
     const noexcept {
-  std::array<double, 7> output;
+  Eigen::Matrix<double, 7, 1> output;
   library_->coriolis(q.data(), dq.data(), I_total.data(), m_total, F_x_Ctotal.data(),
                      output.data());
-  return Eigen::Map<const Eigen::Matrix<double, 7, 1>>(output.data());
+  return output;
+}
+
+void Model::gravity(
+    const double* q,
+    double m_total,
+    const double* F_x_Ctotal,
+    const double* gravity_earth,
+    double* output)
+    const noexcept {
+  library_->gravity(q, gravity_earth, m_total, F_x_Ctotal, output);
+}
+
+void Model::gravity(
+    const Eigen::Matrix<double, 7, 1>& q,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth,
+    Eigen::Ref<Eigen::Matrix<double, 7, 1>> output)
+    const noexcept {
+  library_->gravity(q.data(), gravity_earth.data(), m_total, F_x_Ctotal.data(), output.data());
 }
 
 Eigen::Matrix<double, 7, 1> Model::gravity(
@@ -199,9 +511,750 @@ Eigen::Matrix<double, 7, 1> Model::gravity(
     double m_total,
   const Eigen::Vector3d& F_x_Ctotal,
   const Eigen::Vector3d& gravity_earth) const noexcept {
-  std::array<double, 7> output;
+  Eigen::Matrix<double, 7, 1> output;
   library_->gravity(q.data(), gravity_earth.data(), m_total, F_x_Ctotal.data(), output.data());
-  return Eigen::Map<const Eigen::Matrix<double, 7, 1>>(output.data());
+  return output;
+}
+
+void Model::poses(
+    const double* q,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
+  library_->joint1(q, output);
+  library_->joint2(q, output + 16);
+  library_->joint3(q, output + 32);
+  library_->joint4(q, output + 48);
+  library_->joint5(q, output + 64);
+  library_->joint6(q, output + 80);
+  library_->joint7(q, output + 96);
+  library_->flange(q, output + 112);
+  Eigen::Map<const Eigen::Matrix4d> O_T_F(output + 112);
+  Eigen::Map<Eigen::Matrix4d> O_T_EE(output + 128);
+  O_T_EE.noalias() = O_T_F * Eigen::Map<const Eigen::Matrix4d>(F_T_EE);
+  Eigen::Map<Eigen::Matrix4d>(output + 144).noalias() =
+      O_T_EE * Eigen::Map<const Eigen::Matrix4d>(EE_T_K);
+}
+
+static_assert(sizeof(std::array<Eigen::Matrix4d, kFrameCount>) ==
+                  16 * kFrameCount * sizeof(double),
+              "Poses of all frames must be stored contiguously.");
+
+std::array<Eigen::Matrix4d, kFrameCount> Model::poses(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  std::array<Eigen::Matrix4d, kFrameCount> output;
+  poses(q.data(), F_T_EE.data(), EE_T_K.data(), output[0].data());
+  return output;
+}
+
+static_assert(sizeof(std::array<Eigen::Matrix<double, 6, 7>, kFrameCount>) ==
+                  42 * kFrameCount * sizeof(double),
+              "Jacobians of all frames must be stored contiguously.");
+
+void Model::bodyJacobians(
+    const double* q,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
+  const Eigen::Matrix4d F_T_K =
+      Eigen::Map<const Eigen::Matrix4d>(F_T_EE) * Eigen::Map<const Eigen::Matrix4d>(EE_T_K);
+  library_->body_jacobian_joint1(output);
+  library_->body_jacobian_joint2(q, output + 42);
+  library_->body_jacobian_joint3(q, output + 84);
+  library_->body_jacobian_joint4(q, output + 126);
+  library_->body_jacobian_joint5(q, output + 168);
+  library_->body_jacobian_joint6(q, output + 210);
+  library_->body_jacobian_joint7(q, output + 252);
+  library_->body_jacobian_flange(q, output + 294);
+  library_->body_jacobian_ee(q, F_T_EE, output + 336);
+  library_->body_jacobian_ee(q, F_T_K.data(), output + 378);
+}
+
+std::array<Eigen::Matrix<double, 6, 7>, kFrameCount> Model::bodyJacobians(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  std::array<Eigen::Matrix<double, 6, 7>, kFrameCount> output;
+  bodyJacobians(q.data(), F_T_EE.data(), EE_T_K.data(), output[0].data());
+  return output;
+}
+
+void Model::zeroJacobians(
+    const double* q,
+    const double* F_T_EE,
+    const double* EE_T_K,
+    double* output)
+    const noexcept {
+  const Eigen::Matrix4d F_T_K =
+      Eigen::Map<const Eigen::Matrix4d>(F_T_EE) * Eigen::Map<const Eigen::Matrix4d>(EE_T_K);
+  library_->zero_jacobian_joint1(output);
+  library_->zero_jacobian_joint2(q, output + 42);
+  library_->zero_jacobian_joint3(q, output + 84);
+  library_->zero_jacobian_joint4(q, output + 126);
+  library_->zero_jacobian_joint5(q, output + 168);
+  library_->zero_jacobian_joint6(q, output + 210);
+  library_->zero_jacobian_joint7(q, output + 252);
+  library_->zero_jacobian_flange(q, output + 294);
+  library_->zero_jacobian_ee(q, F_T_EE, output + 336);
+  library_->zero_jacobian_ee(q, F_T_K.data(), output + 378);
+}
+
+std::array<Eigen::Matrix<double, 6, 7>, kFrameCount> Model::zeroJacobians(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  std::array<Eigen::Matrix<double, 6, 7>, kFrameCount> output;
+  zeroJacobians(q.data(), F_T_EE.data(), EE_T_K.data(), output[0].data());
+  return output;
+}
+
+void Model::computeState(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    DynamicsState& state,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth) const noexcept {
+  library_->ee(q.data(), F_T_EE.data(), state.O_T_EE.data());
+  library_->zero_jacobian_ee(q.data(), F_T_EE.data(), state.O_Jac_EE.data());
+  library_->mass(q.data(), I_total.data(), m_total, F_x_Ctotal.data(), state.mass.data());
+  library_->coriolis(q.data(), dq.data(), I_total.data(), m_total, F_x_Ctotal.data(),
+                     state.coriolis.data());
+  library_->gravity(q.data(), gravity_earth.data(), m_total, F_x_Ctotal.data(),
+                    state.gravity.data());
+}
+
+void Model::operationalSpace(
+    Frame frame,
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    OperationalSpaceState& state,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth) const {
+  Eigen::Matrix<double, 6, 7> jacobian, jacobian_dot;
+  if (!zeroJacobian(frame, q.data(), F_T_EE.data(), EE_T_K.data(), jacobian.data()) ||
+      !kinematics::zeroJacobianDot(frame, q.data(), dq.data(), F_T_EE.data(), EE_T_K.data(),
+                                   jacobian_dot.data())) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  MassFactorization mass;
+  Eigen::Matrix<double, 7, 1> coriolis, gravity;
+  library_->mass(q.data(), I_total.data(), m_total, F_x_Ctotal.data(), mass.data());
+  mass.computeInPlace();
+  library_->coriolis(q.data(), dq.data(), I_total.data(), m_total, F_x_Ctotal.data(),
+                     coriolis.data());
+  library_->gravity(q.data(), gravity_earth.data(), m_total, F_x_Ctotal.data(), gravity.data());
+
+  // M^-1 J^T is shared by Lambda and the generalized inverse.
+  Eigen::Matrix<double, 7, 6> inverse_mass_jacobian = jacobian.transpose();
+  for (Eigen::Index column = 0; column < 6; column++) {
+    mass.solve(inverse_mass_jacobian.col(column).data(),
+               inverse_mass_jacobian.col(column).data());
+  }
+  state.Lambda = Eigen::LDLT<Eigen::Matrix<double, 6, 6>>(jacobian * inverse_mass_jacobian)
+                     .solve(Eigen::Matrix<double, 6, 6>::Identity());
+  state.J_bar.noalias() = inverse_mass_jacobian * state.Lambda;
+  state.mu.noalias() = state.J_bar.transpose() * coriolis;
+  state.mu.noalias() -= state.Lambda * (jacobian_dot * dq);
+  state.p.noalias() = state.J_bar.transpose() * gravity;
+  state.N.setIdentity();
+  state.N.noalias() -= jacobian.transpose() * state.J_bar.transpose();
+}
+
+void Model::inverseDynamics(
+    const double* q,
+    const double* dq,
+    const double* ddq,
+    const double* I_total,
+    double m_total,
+    const double* F_x_Ctotal,
+    const double* gravity_earth,
+    double* output)
+    const noexcept {
+  if (library_->native()) {
+    dynamics::inverseDynamics(q, dq, ddq, I_total, m_total, F_x_Ctotal, gravity_earth, output);
+    return;
+  }
+  // The library's inertial parameters differ from the native ones, so the torques are assembled
+  // from its own terms to stay consistent with mass(), coriolis() and gravity().
+  Eigen::Matrix<double, 7, 7> mass;
+  Eigen::Matrix<double, 7, 1> coriolis, gravity;
+  library_->mass(q, I_total, m_total, F_x_Ctotal, mass.data());
+  library_->coriolis(q, dq, I_total, m_total, F_x_Ctotal, coriolis.data());
+  library_->gravity(q, gravity_earth, m_total, F_x_Ctotal, gravity.data());
+  Eigen::Map<Eigen::Matrix<double, 7, 1>> tau(output);
+  tau.noalias() = mass * Eigen::Map<const Eigen::Matrix<double, 7, 1>>(ddq) + coriolis + gravity;
+}
+
+Eigen::Matrix<double, 7, 1> Model::inverseDynamics(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    const Eigen::Matrix<double, 7, 1>& ddq,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth)
+    const noexcept {
+  Eigen::Matrix<double, 7, 1> output;
+  inverseDynamics(q.data(), dq.data(), ddq.data(), I_total.data(), m_total, F_x_Ctotal.data(),
+                  gravity_earth.data(), output.data());
+  return output;
+}
+
+void Model::forwardDynamics(
+    const double* q,
+    const double* dq,
+    const double* tau,
+    const double* I_total,
+    double m_total,
+    const double* F_x_Ctotal,
+    const double* gravity_earth,
+    double* output)
+    const noexcept {
+  if (library_->native()) {
+    dynamics::forwardDynamics(q, dq, tau, I_total, m_total, F_x_Ctotal, gravity_earth, output);
+    return;
+  }
+  // Solves with the library's own terms, like the equations of motion of Rollout.
+  MassFactorization mass;
+  Eigen::Matrix<double, 7, 1> coriolis, gravity;
+  library_->mass(q, I_total, m_total, F_x_Ctotal, mass.data());
+  mass.computeInPlace();
+  library_->coriolis(q, dq, I_total, m_total, F_x_Ctotal, coriolis.data());
+  library_->gravity(q, gravity_earth, m_total, F_x_Ctotal, gravity.data());
+  const Eigen::Matrix<double, 7, 1> rhs =
+      Eigen::Map<const Eigen::Matrix<double, 7, 1>>(tau) - coriolis - gravity;
+  mass.solve(rhs.data(), output);
+}
+
+Eigen::Matrix<double, 7, 1> Model::forwardDynamics(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    const Eigen::Matrix<double, 7, 1>& tau,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth)
+    const noexcept {
+  Eigen::Matrix<double, 7, 1> output;
+  forwardDynamics(q.data(), dq.data(), tau.data(), I_total.data(), m_total, F_x_Ctotal.data(),
+                  gravity_earth.data(), output.data());
+  return output;
+}
+
+void Model::coriolisMatrix(
+    const double* q,
+    const double* dq,
+    const double* I_total,
+    double m_total,
+    const double* F_x_Ctotal,
+    double* output)
+    const noexcept {
+  if (library_->native()) {
+    dynamics::coriolisMatrix(q, dq, I_total, m_total, F_x_Ctotal, output);
+    return;
+  }
+  // The Christoffel symbols of the library's mass matrix, with its partial derivatives taken by
+  // central differences. With W = [dM/dq_1 dq, ..., dM/dq_7 dq] they sum to
+  // C = (dM/dt + W - W^T) / 2, so dM/dt - 2C = W^T - W is skew-symmetric.
+  const double step = std::cbrt(std::numeric_limits<double>::epsilon());
+  Eigen::Map<const Eigen::Matrix<double, 7, 1>> velocity(dq);
+  Eigen::Matrix<double, 7, 1> q_step = Eigen::Map<const Eigen::Matrix<double, 7, 1>>(q);
+  Eigen::Matrix<double, 7, 7> mass_forward, mass_backward, mass_dot, W;
+  mass_dot.setZero();
+  for (Eigen::Index joint = 0; joint < 7; joint++) {
+    const double position = q_step[joint];
+    q_step[joint] = position + step;
+    library_->mass(q_step.data(), I_total, m_total, F_x_Ctotal, mass_forward.data());
+    q_step[joint] = position - step;
+    library_->mass(q_step.data(), I_total, m_total, F_x_Ctotal, mass_backward.data());
+    q_step[joint] = position;
+    const Eigen::Matrix<double, 7, 7> mass_derivative =
+        (mass_forward - mass_backward) / (2. * step);
+    mass_dot += mass_derivative * velocity[joint];
+    W.col(joint).noalias() = mass_derivative * velocity;
+  }
+  Eigen::Map<Eigen::Matrix<double, 7, 7>> C(output);
+  C = 0.5 * (mass_dot + W - W.transpose());
+}
+
+Eigen::Matrix<double, 7, 7> Model::coriolisMatrix(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& dq,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  Eigen::Matrix<double, 7, 7> output;
+  coriolisMatrix(q.data(), dq.data(), I_total.data(), m_total, F_x_Ctotal.data(),
+                 output.data());
+  return output;
+}
+
+MassFactorization Model::massFactorization(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  MassFactorization factorization;
+  library_->mass(q.data(), I_total.data(), m_total, F_x_Ctotal.data(), factorization.data());
+  factorization.computeInPlace();
+  return factorization;
+}
+
+Eigen::Matrix<double, 7, 7> Model::inverseMass(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  return massFactorization(q, I_total, m_total, F_x_Ctotal).inverse();
+}
+
+Eigen::Matrix<double, 7, 1> Model::solveMass(
+    const Eigen::Matrix<double, 7, 1>& q,
+    const Eigen::Matrix<double, 7, 1>& rhs,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  return massFactorization(q, I_total, m_total, F_x_Ctotal).solve(rhs);
+}
+
+void Model::poseBatch(
+    Frame frame,
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  poseBatch(frame, q, n, output, F_T_EE, EE_T_K, kinematics::bestInstructionSet());
+}
+
+void Model::poseBatch(
+    Frame frame,
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K,
+    kinematics::InstructionSet instruction_set)
+    const {
+  if (library_->native()) {
+    if (!kinematics::poseBatch(frame, q, n, F_T_EE.data(), EE_T_K.data(), output,
+                               instruction_set)) {
+      throw std::invalid_argument("Invalid frame given.");
+    }
+    return;
+  }
+  decltype(&O_T_J1) joint_pose;
+  switch (frame) {
+    case Frame::kJoint1:
+      joint_pose = library_->joint1;
+      break;
+    case Frame::kJoint2:
+      joint_pose = library_->joint2;
+      break;
+    case Frame::kJoint3:
+      joint_pose = library_->joint3;
+      break;
+    case Frame::kJoint4:
+      joint_pose = library_->joint4;
+      break;
+    case Frame::kJoint5:
+      joint_pose = library_->joint5;
+      break;
+    case Frame::kJoint6:
+      joint_pose = library_->joint6;
+      break;
+    case Frame::kJoint7:
+      joint_pose = library_->joint7;
+      break;
+    case Frame::kFlange:
+      joint_pose = library_->flange;
+      break;
+    case Frame::kEndEffector:
+      for (std::size_t i = 0; i < n; i++) {
+        library_->ee(q + 7 * i, F_T_EE.data(), output + 16 * i);
+      }
+      return;
+    case Frame::kStiffness: {
+      const Eigen::Matrix4d F_T_K = F_T_EE * EE_T_K;
+      for (std::size_t i = 0; i < n; i++) {
+        library_->ee(q + 7 * i, F_T_K.data(), output + 16 * i);
+      }
+      return;
+    }
+    default:
+      throw std::invalid_argument("Invalid frame given.");
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    joint_pose(q + 7 * i, output + 16 * i);
+  }
+}
+
+void Model::posesBatch(
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    poses(q + 7 * i, F_T_EE.data(), EE_T_K.data(), output + 16 * kFrameCount * i);
+  }
+}
+
+void Model::bodyJacobianBatch(
+    Frame frame,
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  decltype(&O_J_J2) joint_jacobian;
+  switch (frame) {
+    case Frame::kJoint1:
+      // The Jacobian of the first joint does not depend on the joint position.
+      for (std::size_t i = 0; i < n; i++) {
+        library_->body_jacobian_joint1(output + 42 * i);
+      }
+      return;
+    case Frame::kJoint2:
+      joint_jacobian = library_->body_jacobian_joint2;
+      break;
+    case Frame::kJoint3:
+      joint_jacobian = library_->body_jacobian_joint3;
+      break;
+    case Frame::kJoint4:
+      joint_jacobian = library_->body_jacobian_joint4;
+      break;
+    case Frame::kJoint5:
+      joint_jacobian = library_->body_jacobian_joint5;
+      break;
+    case Frame::kJoint6:
+      joint_jacobian = library_->body_jacobian_joint6;
+      break;
+    case Frame::kJoint7:
+      joint_jacobian = library_->body_jacobian_joint7;
+      break;
+    case Frame::kFlange:
+      joint_jacobian = library_->body_jacobian_flange;
+      break;
+    case Frame::kEndEffector:
+      for (std::size_t i = 0; i < n; i++) {
+        library_->body_jacobian_ee(q + 7 * i, F_T_EE.data(), output + 42 * i);
+      }
+      return;
+    case Frame::kStiffness: {
+      const Eigen::Matrix4d F_T_K = F_T_EE * EE_T_K;
+      for (std::size_t i = 0; i < n; i++) {
+        library_->body_jacobian_ee(q + 7 * i, F_T_K.data(), output + 42 * i);
+      }
+      return;
+    }
+    default:
+      throw std::invalid_argument("Invalid frame given.");
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    joint_jacobian(q + 7 * i, output + 42 * i);
+  }
+}
+
+void Model::zeroJacobianBatch(
+    Frame frame,
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  decltype(&O_J_J2) joint_jacobian;
+  switch (frame) {
+    case Frame::kJoint1:
+      // The Jacobian of the first joint does not depend on the joint position.
+      for (std::size_t i = 0; i < n; i++) {
+        library_->zero_jacobian_joint1(output + 42 * i);
+      }
+      return;
+    case Frame::kJoint2:
+      joint_jacobian = library_->zero_jacobian_joint2;
+      break;
+    case Frame::kJoint3:
+      joint_jacobian = library_->zero_jacobian_joint3;
+      break;
+    case Frame::kJoint4:
+      joint_jacobian = library_->zero_jacobian_joint4;
+      break;
+    case Frame::kJoint5:
+      joint_jacobian = library_->zero_jacobian_joint5;
+      break;
+    case Frame::kJoint6:
+      joint_jacobian = library_->zero_jacobian_joint6;
+      break;
+    case Frame::kJoint7:
+      joint_jacobian = library_->zero_jacobian_joint7;
+      break;
+    case Frame::kFlange:
+      joint_jacobian = library_->zero_jacobian_flange;
+      break;
+    case Frame::kEndEffector:
+      for (std::size_t i = 0; i < n; i++) {
+        library_->zero_jacobian_ee(q + 7 * i, F_T_EE.data(), output + 42 * i);
+      }
+      return;
+    case Frame::kStiffness: {
+      const Eigen::Matrix4d F_T_K = F_T_EE * EE_T_K;
+      for (std::size_t i = 0; i < n; i++) {
+        library_->zero_jacobian_ee(q + 7 * i, F_T_K.data(), output + 42 * i);
+      }
+      return;
+    }
+    default:
+      throw std::invalid_argument("Invalid frame given.");
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    joint_jacobian(q + 7 * i, output + 42 * i);
+  }
+}
+
+void Model::bodyJacobianDotBatch(
+    Frame frame,
+    const double* q,
+    const double* dq,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  if (!kinematics::detail::isValid(frame)) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    kinematics::bodyJacobianDot(frame, q + 7 * i, dq + 7 * i, F_T_EE.data(), EE_T_K.data(),
+                                output + 42 * i);
+  }
+}
+
+void Model::zeroJacobianDotBatch(
+    Frame frame,
+    const double* q,
+    const double* dq,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const {
+  if (!kinematics::detail::isValid(frame)) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    kinematics::zeroJacobianDot(frame, q + 7 * i, dq + 7 * i, F_T_EE.data(), EE_T_K.data(),
+                                output + 42 * i);
+  }
+}
+
+void Model::bodyJacobiansBatch(
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    bodyJacobians(q + 7 * i, F_T_EE.data(), EE_T_K.data(), output + 42 * kFrameCount * i);
+  }
+}
+
+void Model::zeroJacobiansBatch(
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix4d& F_T_EE,
+    const Eigen::Matrix4d& EE_T_K)
+    const noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    zeroJacobians(q + 7 * i, F_T_EE.data(), EE_T_K.data(), output + 42 * kFrameCount * i);
+  }
+}
+
+void Model::massBatch(
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    library_->mass(q + 7 * i, I_total.data(), m_total, F_x_Ctotal.data(), output + 49 * i);
+  }
+}
+
+void Model::coriolisBatch(
+    const double* q,
+    const double* dq,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    library_->coriolis(q + 7 * i, dq + 7 * i, I_total.data(), m_total, F_x_Ctotal.data(),
+                       output + 7 * i);
+  }
+}
+
+void Model::gravityBatch(
+    const double* q,
+    std::size_t n,
+    double* output,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth) const noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    library_->gravity(q + 7 * i, gravity_earth.data(), m_total, F_x_Ctotal.data(),
+                      output + 7 * i);
+  }
+}
+
+void Model::forwardDynamicsBatch(
+    const double* q,
+    const double* dq,
+    const double* tau,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth) const noexcept {
+  if (library_->native()) {
+    // The load only changes once per batch, so the bodies are shared by all states.
+    dynamics::RigidBody<double> bodies[dynamics::kJointCount];
+    dynamics::rigidBodies(I_total.data(), m_total, F_x_Ctotal.data(), bodies);
+    for (std::size_t i = 0; i < n; i++) {
+      dynamics::forwardDynamics(bodies, q + 7 * i, dq + 7 * i, tau + 7 * i,
+                                gravity_earth.data(), output + 7 * i);
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    forwardDynamics(q + 7 * i, dq + 7 * i, tau + 7 * i, I_total.data(), m_total,
+                    F_x_Ctotal.data(), gravity_earth.data(), output + 7 * i);
+  }
+}
+
+void Model::inverseDynamicsBatch(
+    const double* q,
+    const double* dq,
+    const double* ddq,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth) const noexcept {
+  if (library_->native()) {
+    dynamics::RigidBody<double> bodies[dynamics::kJointCount];
+    dynamics::rigidBodies(I_total.data(), m_total, F_x_Ctotal.data(), bodies);
+    for (std::size_t i = 0; i < n; i++) {
+      dynamics::inverseDynamics(bodies, q + 7 * i, dq + 7 * i, ddq + 7 * i,
+                                gravity_earth.data(), output + 7 * i);
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    inverseDynamics(q + 7 * i, dq + 7 * i, ddq + 7 * i, I_total.data(), m_total,
+                    F_x_Ctotal.data(), gravity_earth.data(), output + 7 * i);
+  }
+}
+
+void Model::inverseDynamicsTrajectory(
+    const double* q,
+    const double* dq,
+    const double* ddq,
+    std::size_t n,
+    const TorqueSink& sink,
+    std::size_t chunk_size,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal,
+    const Eigen::Vector3d& gravity_earth) const {
+  if (chunk_size == 0) {
+    throw std::invalid_argument("Chunk size must be positive.");
+  }
+  // The buffer is the only storage that grows with the chunk, never with the trajectory.
+  std::vector<double> buffer(7 * std::min(chunk_size, n));
+  for (std::size_t offset = 0; offset < n; offset += chunk_size) {
+    const std::size_t count = std::min(chunk_size, n - offset);
+    inverseDynamicsBatch(q + 7 * offset, dq + 7 * offset, ddq + 7 * offset, count, buffer.data(),
+                         I_total, m_total, F_x_Ctotal, gravity_earth);
+    sink(offset, count, buffer.data());
+  }
+}
+
+void Model::massFactorizationBatch(
+    const double* q,
+    std::size_t n,
+    MassFactorization* output,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    library_->mass(q + 7 * i, I_total.data(), m_total, F_x_Ctotal.data(), output[i].data());
+    output[i].computeInPlace();
+  }
+}
+
+void Model::inverseMassBatch(
+    const double* q,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  MassFactorization factorization;
+  for (std::size_t i = 0; i < n; i++) {
+    library_->mass(q + 7 * i, I_total.data(), m_total, F_x_Ctotal.data(), factorization.data());
+    factorization.computeInPlace();
+    factorization.inverse(output + 49 * i);
+  }
+}
+
+void Model::solveMassBatch(
+    const double* q,
+    const double* rhs,
+    std::size_t n,
+    double* output,
+    const Eigen::Matrix3d& I_total,
+    double m_total,
+    const Eigen::Vector3d& F_x_Ctotal)
+    const noexcept {
+  MassFactorization factorization;
+  for (std::size_t i = 0; i < n; i++) {
+    library_->mass(q + 7 * i, I_total.data(), m_total, F_x_Ctotal.data(), factorization.data());
+    factorization.computeInPlace();
+    factorization.solve(rhs + 7 * i, output + 7 * i);
+  }
 }
 
 }  // namespace panda_model
@@ -2,41 +2,120 @@
 // Use of this source code is governed by the Apache-2.0 license, see LICENSE
 #include "model_library.h"
 
+#include "pandamodel/dynamics.h"
+#include "pandamodel/kinematics.h"
+
 // #include "library_downloader.h"
 
 namespace panda_model {
 
+namespace {
+
+// Adapters from the library ABI to the native kinematics.
+
+const double kIdentity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+const double kZero[7] = {};
+
+template <Frame frame>
+void nativePose(const double q[7], double output[16]) {
+  kinematics::pose(frame, q, kIdentity, kIdentity, output);
+}
+
+void nativeEndEffectorPose(const double q[7], const double F_T_EE[16], double output[16]) {
+  kinematics::pose(Frame::kEndEffector, q, F_T_EE, kIdentity, output);
+}
+
+template <Frame frame>
+void nativeBodyJacobian(const double q[7], double output[42]) {
+  kinematics::bodyJacobian(frame, q, kIdentity, kIdentity, output);
+}
+
+void nativeBodyJacobianJoint1(double output[42]) {
+  kinematics::bodyJacobian(Frame::kJoint1, kZero, kIdentity, kIdentity, output);
+}
+
+void nativeBodyJacobianEndEffector(const double q[7], const double F_T_EE[16], double output[42]) {
+  kinematics::bodyJacobian(Frame::kEndEffector, q, F_T_EE, kIdentity, output);
+}
+
+template <Frame frame>
+void nativeZeroJacobian(const double q[7], double output[42]) {
+  kinematics::zeroJacobian(frame, q, kIdentity, kIdentity, output);
+}
+
+void nativeZeroJacobianJoint1(double output[42]) {
+  kinematics::zeroJacobian(Frame::kJoint1, kZero, kIdentity, kIdentity, output);
+}
+
+void nativeZeroJacobianEndEffector(const double q[7], const double F_T_EE[16], double output[42]) {
+  kinematics::zeroJacobian(Frame::kEndEffector, q, F_T_EE, kIdentity, output);
+}
+
+}  // anonymous namespace
+
 ModelLibrary::ModelLibrary(const std::string &path)
-    : loader_(path),
-      body_jacobian_joint1{reinterpret_cast<decltype(&Ji_J_J1)>(loader_.getSymbol("Ji_J_J1"))},
-      body_jacobian_joint2{reinterpret_cast<decltype(&Ji_J_J2)>(loader_.getSymbol("Ji_J_J2"))},
-      body_jacobian_joint3{reinterpret_cast<decltype(&Ji_J_J3)>(loader_.getSymbol("Ji_J_J3"))},
-      body_jacobian_joint4{reinterpret_cast<decltype(&Ji_J_J4)>(loader_.getSymbol("Ji_J_J4"))},
-      body_jacobian_joint5{reinterpret_cast<decltype(&Ji_J_J5)>(loader_.getSymbol("Ji_J_J5"))},
-      body_jacobian_joint6{reinterpret_cast<decltype(&Ji_J_J6)>(loader_.getSymbol("Ji_J_J6"))},
-      body_jacobian_joint7{reinterpret_cast<decltype(&Ji_J_J7)>(loader_.getSymbol("Ji_J_J7"))},
-      body_jacobian_flange{reinterpret_cast<decltype(&Ji_J_J8)>(loader_.getSymbol("Ji_J_J8"))},
-      body_jacobian_ee{reinterpret_cast<decltype(&Ji_J_J9)>(loader_.getSymbol("Ji_J_J9"))},
-      mass{reinterpret_cast<decltype(&M_NE)>(loader_.getSymbol("M_NE"))},
-      zero_jacobian_joint1{reinterpret_cast<decltype(&O_J_J1)>(loader_.getSymbol("O_J_J1"))},
-      zero_jacobian_joint2{reinterpret_cast<decltype(&O_J_J2)>(loader_.getSymbol("O_J_J2"))},
-      zero_jacobian_joint3{reinterpret_cast<decltype(&O_J_J3)>(loader_.getSymbol("O_J_J3"))},
-      zero_jacobian_joint4{reinterpret_cast<decltype(&O_J_J4)>(loader_.getSymbol("O_J_J4"))},
-      zero_jacobian_joint5{reinterpret_cast<decltype(&O_J_J5)>(loader_.getSymbol("O_J_J5"))},
-      zero_jacobian_joint6{reinterpret_cast<decltype(&O_J_J6)>(loader_.getSymbol("O_J_J6"))},
-      zero_jacobian_joint7{reinterpret_cast<decltype(&O_J_J7)>(loader_.getSymbol("O_J_J7"))},
-      zero_jacobian_flange{reinterpret_cast<decltype(&O_J_J8)>(loader_.getSymbol("O_J_J8"))},
-      zero_jacobian_ee{reinterpret_cast<decltype(&O_J_J9)>(loader_.getSymbol("O_J_J9"))},
-      joint1{reinterpret_cast<decltype(&O_T_J1)>(loader_.getSymbol("O_T_J1"))},
-      joint2{reinterpret_cast<decltype(&O_T_J2)>(loader_.getSymbol("O_T_J2"))},
-      joint3{reinterpret_cast<decltype(&O_T_J3)>(loader_.getSymbol("O_T_J3"))},
-      joint4{reinterpret_cast<decltype(&O_T_J4)>(loader_.getSymbol("O_T_J4"))},
-      joint5{reinterpret_cast<decltype(&O_T_J5)>(loader_.getSymbol("O_T_J5"))},
-      joint6{reinterpret_cast<decltype(&O_T_J6)>(loader_.getSymbol("O_T_J6"))},
-      joint7{reinterpret_cast<decltype(&O_T_J7)>(loader_.getSymbol("O_T_J7"))},
-      flange{reinterpret_cast<decltype(&O_T_J8)>(loader_.getSymbol("O_T_J8"))},
-      ee{reinterpret_cast<decltype(&O_T_J9)>(loader_.getSymbol("O_T_J9"))},
-      coriolis{reinterpret_cast<decltype(&c_NE)>(loader_.getSymbol("c_NE"))},
-      gravity{reinterpret_cast<decltype(&g_NE)>(loader_.getSymbol("g_NE"))} {}
+    : loader_(new LibraryLoader(path)),
+      body_jacobian_joint1{reinterpret_cast<decltype(&Ji_J_J1)>(loader_->getSymbol("Ji_J_J1"))},
+      body_jacobian_joint2{reinterpret_cast<decltype(&Ji_J_J2)>(loader_->getSymbol("Ji_J_J2"))},
+      body_jacobian_joint3{reinterpret_cast<decltype(&Ji_J_J3)>(loader_->getSymbol("Ji_J_J3"))},
+      body_jacobian_joint4{reinterpret_cast<decltype(&Ji_J_J4)>(loader_->getSymbol("Ji_J_J4"))},
+      body_jacobian_joint5{reinterpret_cast<decltype(&Ji_J_J5)>(loader_->getSymbol("Ji_J_J5"))},
+      body_jacobian_joint6{reinterpret_cast<decltype(&Ji_J_J6)>(loader_->getSymbol("Ji_J_J6"))},
+      body_jacobian_joint7{reinterpret_cast<decltype(&Ji_J_J7)>(loader_->getSymbol("Ji_J_J7"))},
+      body_jacobian_flange{reinterpret_cast<decltype(&Ji_J_J8)>(loader_->getSymbol("Ji_J_J8"))},
+      body_jacobian_ee{reinterpret_cast<decltype(&Ji_J_J9)>(loader_->getSymbol("Ji_J_J9"))},
+      mass{reinterpret_cast<decltype(&M_NE)>(loader_->getSymbol("M_NE"))},
+      zero_jacobian_joint1{reinterpret_cast<decltype(&O_J_J1)>(loader_->getSymbol("O_J_J1"))},
+      zero_jacobian_joint2{reinterpret_cast<decltype(&O_J_J2)>(loader_->getSymbol("O_J_J2"))},
+      zero_jacobian_joint3{reinterpret_cast<decltype(&O_J_J3)>(loader_->getSymbol("O_J_J3"))},
+      zero_jacobian_joint4{reinterpret_cast<decltype(&O_J_J4)>(loader_->getSymbol("O_J_J4"))},
+      zero_jacobian_joint5{reinterpret_cast<decltype(&O_J_J5)>(loader_->getSymbol("O_J_J5"))},
+      zero_jacobian_joint6{reinterpret_cast<decltype(&O_J_J6)>(loader_->getSymbol("O_J_J6"))},
+      zero_jacobian_joint7{reinterpret_cast<decltype(&O_J_J7)>(loader_->getSymbol("O_J_J7"))},
+      zero_jacobian_flange{reinterpret_cast<decltype(&O_J_J8)>(loader_->getSymbol("O_J_J8"))},
+      zero_jacobian_ee{reinterpret_cast<decltype(&O_J_J9)>(loader_->getSymbol("O_J_J9"))},
+      joint1{reinterpret_cast<decltype(&O_T_J1)>(loader_->getSymbol("O_T_J1"))},
+      joint2{reinterpret_cast<decltype(&O_T_J2)>(loader_->getSymbol("O_T_J2"))},
+      joint3{reinterpret_cast<decltype(&O_T_J3)>(loader_->getSymbol("O_T_J3"))},
+      joint4{reinterpret_cast<decltype(&O_T_J4)>(loader_->getSymbol("O_T_J4"))},
+      joint5{reinterpret_cast<decltype(&O_T_J5)>(loader_->getSymbol("O_T_J5"))},
+      joint6{reinterpret_cast<decltype(&O_T_J6)>(loader_->getSymbol("O_T_J6"))},
+      joint7{reinterpret_cast<decltype(&O_T_J7)>(loader_->getSymbol("O_T_J7"))},
+      flange{reinterpret_cast<decltype(&O_T_J8)>(loader_->getSymbol("O_T_J8"))},
+      ee{reinterpret_cast<decltype(&O_T_J9)>(loader_->getSymbol("O_T_J9"))},
+      coriolis{reinterpret_cast<decltype(&c_NE)>(loader_->getSymbol("c_NE"))},
+      gravity{reinterpret_cast<decltype(&g_NE)>(loader_->getSymbol("g_NE"))} {}
+
+ModelLibrary::ModelLibrary()
+    : body_jacobian_joint1{&nativeBodyJacobianJoint1},
+      body_jacobian_joint2{&nativeBodyJacobian<Frame::kJoint2>},
+      body_jacobian_joint3{&nativeBodyJacobian<Frame::kJoint3>},
+      body_jacobian_joint4{&nativeBodyJacobian<Frame::kJoint4>},
+      body_jacobian_joint5{&nativeBodyJacobian<Frame::kJoint5>},
+      body_jacobian_joint6{&nativeBodyJacobian<Frame::kJoint6>},
+      body_jacobian_joint7{&nativeBodyJacobian<Frame::kJoint7>},
+      body_jacobian_flange{&nativeBodyJacobian<Frame::kFlange>},
+      body_jacobian_ee{&nativeBodyJacobianEndEffector},
+      mass{&dynamics::mass<double>},
+      zero_jacobian_joint1{&nativeZeroJacobianJoint1},
+      zero_jacobian_joint2{&nativeZeroJacobian<Frame::kJoint2>},
+      zero_jacobian_joint3{&nativeZeroJacobian<Frame::kJoint3>},
+      zero_jacobian_joint4{&nativeZeroJacobian<Frame::kJoint4>},
+      zero_jacobian_joint5{&nativeZeroJacobian<Frame::kJoint5>},
+      zero_jacobian_joint6{&nativeZeroJacobian<Frame::kJoint6>},
+      zero_jacobian_joint7{&nativeZeroJacobian<Frame::kJoint7>},
+      zero_jacobian_flange{&nativeZeroJacobian<Frame::kFlange>},
+      zero_jacobian_ee{&nativeZeroJacobianEndEffector},
+      joint1{&nativePose<Frame::kJoint1>},
+      joint2{&nativePose<Frame::kJoint2>},
+      joint3{&nativePose<Frame::kJoint3>},
+      joint4{&nativePose<Frame::kJoint4>},
+      joint5{&nativePose<Frame::kJoint5>},
+      joint6{&nativePose<Frame::kJoint6>},
+      joint7{&nativePose<Frame::kJoint7>},
+      flange{&nativePose<Frame::kFlange>},
+      ee{&nativeEndEffectorPose},
+      coriolis{&dynamics::coriolis<double>},
+      gravity{&dynamics::gravity<double>} {}
 
 }  // namespace panda_model
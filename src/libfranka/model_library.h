@@ -2,7 +2,8 @@
 // Use of this source code is governed by the Apache-2.0 license, see LICENSE
 #pragma once
 
-#include <functional>
+#include <memory>
+#include <string>
 
 #include "libfcimodels.h"
 #include "library_loader.h"
@@ -15,44 +16,53 @@ class ModelLibrary {
   // ModelLibrary(Network& network);
   ModelLibrary(const std::string &path);
 
+  // Uses the native implementation in pandamodel/kinematics.h and pandamodel/dynamics.h instead
+  // of a loaded library.
+  ModelLibrary();
+
+  // Whether this is the native implementation.
+  bool native() const noexcept { return !loader_; }
+
  private:
-  LibraryLoader loader_;
+  // Empty for the native implementation.
+  std::unique_ptr<LibraryLoader> loader_;
 
  public:
-  const std::function<decltype(Ji_J_J1)> body_jacobian_joint1;
-  const std::function<decltype(Ji_J_J2)> body_jacobian_joint2;
-  const std::function<decltype(Ji_J_J3)> body_jacobian_joint3;
-  const std::function<decltype(Ji_J_J4)> body_jacobian_joint4;
-  const std::function<decltype(Ji_J_J5)> body_jacobian_joint5;
-  const std::function<decltype(Ji_J_J6)> body_jacobian_joint6;
-  const std::function<decltype(Ji_J_J7)> body_jacobian_joint7;
-  const std::function<decltype(Ji_J_J8)> body_jacobian_flange;
-  const std::function<decltype(Ji_J_J9)> body_jacobian_ee;
-
-  const std::function<decltype(M_NE)> mass;
-
-  const std::function<decltype(O_J_J1)> zero_jacobian_joint1;
-  const std::function<decltype(O_J_J2)> zero_jacobian_joint2;
-  const std::function<decltype(O_J_J3)> zero_jacobian_joint3;
-  const std::function<decltype(O_J_J4)> zero_jacobian_joint4;
-  const std::function<decltype(O_J_J5)> zero_jacobian_joint5;
-  const std::function<decltype(O_J_J6)> zero_jacobian_joint6;
-  const std::function<decltype(O_J_J7)> zero_jacobian_joint7;
-  const std::function<decltype(O_J_J8)> zero_jacobian_flange;
-  const std::function<decltype(O_J_J9)> zero_jacobian_ee;
-
-  const std::function<decltype(O_T_J1)> joint1;
-  const std::function<decltype(O_T_J2)> joint2;
-  const std::function<decltype(O_T_J3)> joint3;
-  const std::function<decltype(O_T_J4)> joint4;
-  const std::function<decltype(O_T_J5)> joint5;
-  const std::function<decltype(O_T_J6)> joint6;
-  const std::function<decltype(O_T_J7)> joint7;
-  const std::function<decltype(O_T_J8)> flange;
-  const std::function<decltype(O_T_J9)> ee;
-
-  const std::function<decltype(c_NE)> coriolis;
-  const std::function<decltype(g_NE)> gravity;
+  // Plain function pointers, so calls are not routed through a type-erased wrapper.
+  decltype(&Ji_J_J1) const body_jacobian_joint1;
+  decltype(&Ji_J_J2) const body_jacobian_joint2;
+  decltype(&Ji_J_J3) const body_jacobian_joint3;
+  decltype(&Ji_J_J4) const body_jacobian_joint4;
+  decltype(&Ji_J_J5) const body_jacobian_joint5;
+  decltype(&Ji_J_J6) const body_jacobian_joint6;
+  decltype(&Ji_J_J7) const body_jacobian_joint7;
+  decltype(&Ji_J_J8) const body_jacobian_flange;
+  decltype(&Ji_J_J9) const body_jacobian_ee;
+
+  decltype(&M_NE) const mass;
+
+  decltype(&O_J_J1) const zero_jacobian_joint1;
+  decltype(&O_J_J2) const zero_jacobian_joint2;
+  decltype(&O_J_J3) const zero_jacobian_joint3;
+  decltype(&O_J_J4) const zero_jacobian_joint4;
+  decltype(&O_J_J5) const zero_jacobian_joint5;
+  decltype(&O_J_J6) const zero_jacobian_joint6;
+  decltype(&O_J_J7) const zero_jacobian_joint7;
+  decltype(&O_J_J8) const zero_jacobian_flange;
+  decltype(&O_J_J9) const zero_jacobian_ee;
+
+  decltype(&O_T_J1) const joint1;
+  decltype(&O_T_J2) const joint2;
+  decltype(&O_T_J3) const joint3;
+  decltype(&O_T_J4) const joint4;
+  decltype(&O_T_J5) const joint5;
+  decltype(&O_T_J6) const joint6;
+  decltype(&O_T_J7) const joint7;
+  decltype(&O_T_J8) const flange;
+  decltype(&O_T_J9) const ee;
+
+  decltype(&c_NE) const coriolis;
+  decltype(&g_NE) const gravity;
 };
 
 }  // namespace panda_model
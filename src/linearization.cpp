@@ -0,0 +1,92 @@
+#include "pandamodel/linearization.h"
+
+#include <vector>
+
+#include "pandamodel/mass_factorization.h"
+
+#include "equations_of_motion.h"
+
+namespace panda_model {
+
+namespace {
+
+using Vector7d = Eigen::Matrix<double, 7, 1>;
+
+// Number of state coordinates, joint positions followed by joint velocities.
+constexpr std::size_t kStateSize = 14;
+
+using detail::Dynamics;
+
+}  // anonymous namespace
+
+Linearization::Linearization(const Model& model, std::size_t num_threads, std::size_t grain_size)
+    : model_(model), pool_(num_threads), grain_size_(grain_size) {}
+
+std::size_t Linearization::numThreads() const noexcept {
+  return pool_.size();
+}
+
+void Linearization::linearize(const double* q,
+                              const double* dq,
+                              const double* tau,
+                              std::size_t n,
+                              double* A,
+                              double* B,
+                              Difference difference,
+                              double step,
+                              const Eigen::Matrix3d& I_total,
+                              double m_total,
+                              const Eigen::Vector3d& F_x_Ctotal,
+                              const Eigen::Vector3d& gravity_earth) {
+  using StateMatrix = Eigen::Matrix<double, kStateSize, kStateSize>;
+  using InputMatrix = Eigen::Matrix<double, kStateSize, 7>;
+  const Dynamics dynamics{model_, I_total, m_total, F_x_Ctotal, gravity_earth};
+
+  // Nominal knots: the exact input matrix, the known blocks of the state matrix and, for
+  // forward differences, the nominal acceleration.
+  std::vector<double> nominal(difference == Difference::kForward ? 7 * n : 0);
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t knot = begin; knot < end; knot++) {
+      Eigen::Map<StateMatrix> A_knot(A + kStateSize * kStateSize * knot);
+      Eigen::Map<InputMatrix> B_knot(B + kStateSize * 7 * knot);
+      MassFactorization mass;
+      const Vector7d acceleration = dynamics.acceleration(
+          Eigen::Map<const Vector7d>(q + 7 * knot), Eigen::Map<const Vector7d>(dq + 7 * knot),
+          Eigen::Map<const Vector7d>(tau + 7 * knot), mass);
+      if (difference == Difference::kForward) {
+        Eigen::Map<Vector7d>(nominal.data() + 7 * knot) = acceleration;
+      }
+      A_knot.topRows<7>().setZero();
+      A_knot.topRightCorner<7, 7>().setIdentity();
+      B_knot.topRows<7>().setZero();
+      B_knot.bottomRows<7>() = mass.inverse();
+    }
+  });
+
+  // Perturbations of all knots, one task per state coordinate and knot.
+  pool_.parallelFor(kStateSize * n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t task = begin; task < end; task++) {
+      const std::size_t knot = task / kStateSize;
+      const std::size_t coordinate = task % kStateSize;
+      Eigen::Map<StateMatrix> A_knot(A + kStateSize * kStateSize * knot);
+      const Eigen::Map<const Vector7d> torque(tau + 7 * knot);
+      Vector7d position = Eigen::Map<const Vector7d>(q + 7 * knot);
+      Vector7d velocity = Eigen::Map<const Vector7d>(dq + 7 * knot);
+      double& perturbed = coordinate < 7 ? position[coordinate] : velocity[coordinate - 7];
+      const double value = perturbed;
+
+      perturbed = value + step;
+      const Vector7d plus = dynamics.acceleration(position, velocity, torque);
+      if (difference == Difference::kCentral) {
+        perturbed = value - step;
+        const Vector7d minus = dynamics.acceleration(position, velocity, torque);
+        A_knot.block<7, 1>(7, coordinate) = (plus - minus) / (2. * step);
+      } else {
+        A_knot.block<7, 1>(7, coordinate) =
+            (plus - Eigen::Map<const Vector7d>(nominal.data() + 7 * knot)) / step;
+      }
+    }
+  });
+}
+
+}  // namespace panda_model
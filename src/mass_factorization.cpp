@@ -0,0 +1,95 @@
+#include "pandamodel/mass_factorization.h"
+
+#include <algorithm>
+
+namespace panda_model {
+
+namespace {
+
+using Vector7d = Eigen::Matrix<double, 7, 1>;
+using Matrix7d = Eigen::Matrix<double, 7, 7>;
+
+}  // anonymous namespace
+
+MassFactorization::MassFactorization() noexcept : factors_(Matrix7d::Identity()) {}
+
+MassFactorization::MassFactorization(const Matrix7d& mass) noexcept {
+  compute(mass.data());
+}
+
+void MassFactorization::compute(const double* mass) noexcept {
+  std::copy(mass, mass + 49, factors_.data());
+  computeInPlace();
+}
+
+void MassFactorization::computeInPlace() noexcept {
+  // Column-wise LDL^T without pivoting, only the lower triangle is read.
+  for (Eigen::Index j = 0; j < 7; j++) {
+    double d = factors_(j, j);
+    for (Eigen::Index k = 0; k < j; k++) {
+      d -= factors_(j, k) * factors_(j, k) * factors_(k, k);
+    }
+    factors_(j, j) = d;
+    for (Eigen::Index i = j + 1; i < 7; i++) {
+      double l = factors_(i, j);
+      for (Eigen::Index k = 0; k < j; k++) {
+        l -= factors_(i, k) * factors_(j, k) * factors_(k, k);
+      }
+      factors_(i, j) = l / d;
+    }
+  }
+  factors_.triangularView<Eigen::StrictlyUpper>().setZero();
+}
+
+const double* MassFactorization::data() const noexcept {
+  return factors_.data();
+}
+
+double* MassFactorization::data() noexcept {
+  return factors_.data();
+}
+
+Matrix7d MassFactorization::L() const noexcept {
+  Matrix7d L = factors_.triangularView<Eigen::StrictlyLower>();
+  L.diagonal().setOnes();
+  return L;
+}
+
+Vector7d MassFactorization::D() const noexcept {
+  return factors_.diagonal();
+}
+
+Matrix7d MassFactorization::mass() const noexcept {
+  const Matrix7d L = this->L();
+  return L * factors_.diagonal().asDiagonal() * L.transpose();
+}
+
+void MassFactorization::solve(const double* rhs, double* output) const noexcept {
+  Eigen::Map<Vector7d> x(output);
+  x = Eigen::Map<const Vector7d>(rhs);
+  factors_.triangularView<Eigen::UnitLower>().solveInPlace(x);
+  x.array() /= factors_.diagonal().array();
+  factors_.triangularView<Eigen::UnitLower>().transpose().solveInPlace(x);
+}
+
+Vector7d MassFactorization::solve(const Vector7d& rhs) const noexcept {
+  Vector7d output;
+  solve(rhs.data(), output.data());
+  return output;
+}
+
+void MassFactorization::inverse(double* output) const noexcept {
+  Eigen::Map<Matrix7d> x(output);
+  x.setIdentity();
+  factors_.triangularView<Eigen::UnitLower>().solveInPlace(x);
+  x = factors_.diagonal().cwiseInverse().asDiagonal() * x;
+  factors_.triangularView<Eigen::UnitLower>().transpose().solveInPlace(x);
+}
+
+Matrix7d MassFactorization::inverse() const noexcept {
+  Matrix7d output;
+  inverse(output.data());
+  return output;
+}
+
+}  // namespace panda_model
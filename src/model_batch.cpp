@@ -0,0 +1,84 @@
+#include "pandamodel/model_batch.h"
+
+namespace panda_model {
+
+ModelBatch::ModelBatch(const Model& model, std::size_t num_threads, std::size_t grain_size)
+    : model_(model), pool_(num_threads), grain_size_(grain_size) {}
+
+std::size_t ModelBatch::numThreads() const noexcept {
+  return pool_.size();
+}
+
+void ModelBatch::pose(Frame frame,
+                      const double* q,
+                      std::size_t n,
+                      double* output,
+                      const Eigen::Matrix4d& F_T_EE,
+                      const Eigen::Matrix4d& EE_T_K) {
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    model_.poseBatch(frame, q + 7 * begin, end - begin, output + 16 * begin, F_T_EE, EE_T_K);
+  });
+}
+
+void ModelBatch::bodyJacobian(Frame frame,
+                              const double* q,
+                              std::size_t n,
+                              double* output,
+                              const Eigen::Matrix4d& F_T_EE,
+                              const Eigen::Matrix4d& EE_T_K) {
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    model_.bodyJacobianBatch(frame, q + 7 * begin, end - begin, output + 42 * begin, F_T_EE,
+                             EE_T_K);
+  });
+}
+
+void ModelBatch::zeroJacobian(Frame frame,
+                              const double* q,
+                              std::size_t n,
+                              double* output,
+                              const Eigen::Matrix4d& F_T_EE,
+                              const Eigen::Matrix4d& EE_T_K) {
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    model_.zeroJacobianBatch(frame, q + 7 * begin, end - begin, output + 42 * begin, F_T_EE,
+                             EE_T_K);
+  });
+}
+
+void ModelBatch::mass(const double* q,
+                      std::size_t n,
+                      double* output,
+                      const Eigen::Matrix3d& I_total,
+                      double m_total,
+                      const Eigen::Vector3d& F_x_Ctotal) {
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    model_.massBatch(q + 7 * begin, end - begin, output + 49 * begin, I_total, m_total,
+                     F_x_Ctotal);
+  });
+}
+
+void ModelBatch::coriolis(const double* q,
+                          const double* dq,
+                          std::size_t n,
+                          double* output,
+                          const Eigen::Matrix3d& I_total,
+                          double m_total,
+                          const Eigen::Vector3d& F_x_Ctotal) {
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    model_.coriolisBatch(q + 7 * begin, dq + 7 * begin, end - begin, output + 7 * begin,
+                         I_total, m_total, F_x_Ctotal);
+  });
+}
+
+void ModelBatch::gravity(const double* q,
+                         std::size_t n,
+                         double* output,
+                         double m_total,
+                         const Eigen::Vector3d& F_x_Ctotal,
+                         const Eigen::Vector3d& gravity_earth) {
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    model_.gravityBatch(q + 7 * begin, end - begin, output + 7 * begin, m_total, F_x_Ctotal,
+                        gravity_earth);
+  });
+}
+
+}  // namespace panda_model
@@ -0,0 +1,292 @@
+#include "pandamodel/model_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace panda_model {
+
+namespace {
+
+/**
+ * Ring of the last results of one query type, keyed on the bitwise value of the arguments.
+ */
+template <std::size_t KeySize, std::size_t ValueSize>
+class ResultRing {
+ public:
+  using Key = std::array<double, KeySize>;
+
+  explicit ResultRing(std::size_t capacity) : entries_(std::max<std::size_t>(capacity, 1)) {}
+
+  // Copies the remembered result for the given key into output. On a miss, evaluate(value) is
+  // called to fill a new entry and must return false if the arguments are invalid.
+  template <typename Evaluate>
+  bool get(const Key& key, double* output, Evaluate&& evaluate) {
+    for (const Entry& entry : entries_) {
+      if (entry.valid && std::memcmp(entry.key.data(), key.data(), sizeof(Key)) == 0) {
+        std::copy(entry.value.begin(), entry.value.end(), output);
+        statistics.hits++;
+        return true;
+      }
+    }
+    statistics.misses++;
+    Entry& entry = entries_[next_];
+    entry.valid = false;
+    if (!evaluate(entry.value.data())) {
+      return false;
+    }
+    entry.key = key;
+    entry.valid = true;
+    next_ = (next_ + 1) % entries_.size();
+    std::copy(entry.value.begin(), entry.value.end(), output);
+    return true;
+  }
+
+  void clear() noexcept {
+    for (Entry& entry : entries_) {
+      entry.valid = false;
+    }
+    statistics = CacheStatistics();
+  }
+
+  CacheStatistics statistics;
+
+ private:
+  struct Entry {
+    Key key;
+    std::array<double, ValueSize> value;
+    bool valid = false;
+  };
+
+  std::vector<Entry> entries_;
+  std::size_t next_ = 0;
+};
+
+// Concatenates the given arguments into a cache key.
+template <std::size_t KeySize>
+class KeyBuilder {
+ public:
+  KeyBuilder& add(const double* data, std::size_t size) {
+    std::copy(data, data + size, key_.begin() + size_);
+    size_ += size;
+    return *this;
+  }
+
+  KeyBuilder& add(double value) { return add(&value, 1); }
+
+  const std::array<double, KeySize>& key() const noexcept { return key_; }
+
+ private:
+  std::array<double, KeySize> key_;
+  std::size_t size_ = 0;
+};
+
+// Frame, q, F_T_EE and EE_T_K.
+constexpr std::size_t kKinematicsKeySize = 1 + 7 + 16 + 16;
+
+KeyBuilder<kKinematicsKeySize> kinematicsKey(Frame frame,
+                                             const Eigen::Matrix<double, 7, 1>& q,
+                                             const Eigen::Matrix4d& F_T_EE,
+                                             const Eigen::Matrix4d& EE_T_K) {
+  KeyBuilder<kKinematicsKeySize> builder;
+  builder.add(static_cast<double>(frame)).add(q.data(), 7).add(F_T_EE.data(), 16).add(
+      EE_T_K.data(), 16);
+  return builder;
+}
+
+}  // anonymous namespace
+
+struct ModelCache::Entries {
+  explicit Entries(std::size_t capacity)
+      : pose(capacity),
+        body_jacobian(capacity),
+        zero_jacobian(capacity),
+        mass(capacity),
+        coriolis(capacity),
+        gravity(capacity),
+        mass_factorization(capacity) {}
+
+  ResultRing<kKinematicsKeySize, 16> pose;
+  ResultRing<kKinematicsKeySize, 42> body_jacobian;
+  ResultRing<kKinematicsKeySize, 42> zero_jacobian;
+  // q, I_total, m_total and F_x_Ctotal.
+  ResultRing<7 + 9 + 1 + 3, 49> mass;
+  // q, dq, I_total, m_total and F_x_Ctotal.
+  ResultRing<7 + 7 + 9 + 1 + 3, 7> coriolis;
+  // q, m_total, F_x_Ctotal and gravity_earth.
+  ResultRing<7 + 1 + 3 + 3, 7> gravity;
+  // q, I_total, m_total and F_x_Ctotal.
+  ResultRing<7 + 9 + 1 + 3, 49> mass_factorization;
+};
+
+ModelCache::ModelCache(const Model& model, std::size_t capacity)
+    : model_(model), entries_{new Entries(capacity)} {}
+
+ModelCache::~ModelCache() noexcept = default;
+
+Eigen::Matrix4d ModelCache::pose(Frame frame,
+                                 const Eigen::Matrix<double, 7, 1>& q,
+                                 const Eigen::Matrix4d& F_T_EE,
+                                 const Eigen::Matrix4d& EE_T_K) {
+  Eigen::Matrix4d output;
+  if (!entries_->pose.get(kinematicsKey(frame, q, F_T_EE, EE_T_K).key(), output.data(),
+                          [&](double* value) {
+                            return model_.pose(frame, q.data(), F_T_EE.data(), EE_T_K.data(),
+                                               value);
+                          })) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+Eigen::Matrix<double, 6, 7> ModelCache::bodyJacobian(Frame frame,
+                                                     const Eigen::Matrix<double, 7, 1>& q,
+                                                     const Eigen::Matrix4d& F_T_EE,
+                                                     const Eigen::Matrix4d& EE_T_K) {
+  Eigen::Matrix<double, 6, 7> output;
+  if (!entries_->body_jacobian.get(kinematicsKey(frame, q, F_T_EE, EE_T_K).key(),
+                                   output.data(), [&](double* value) {
+                                     return model_.bodyJacobian(frame, q.data(), F_T_EE.data(),
+                                                                EE_T_K.data(), value);
+                                   })) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+Eigen::Matrix<double, 6, 7> ModelCache::zeroJacobian(Frame frame,
+                                                     const Eigen::Matrix<double, 7, 1>& q,
+                                                     const Eigen::Matrix4d& F_T_EE,
+                                                     const Eigen::Matrix4d& EE_T_K) {
+  Eigen::Matrix<double, 6, 7> output;
+  if (!entries_->zero_jacobian.get(kinematicsKey(frame, q, F_T_EE, EE_T_K).key(),
+                                   output.data(), [&](double* value) {
+                                     return model_.zeroJacobian(frame, q.data(), F_T_EE.data(),
+                                                                EE_T_K.data(), value);
+                                   })) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  return output;
+}
+
+Eigen::Matrix<double, 7, 7> ModelCache::mass(const Eigen::Matrix<double, 7, 1>& q,
+                                             const Eigen::Matrix3d& I_total,
+                                             double m_total,
+                                             const Eigen::Vector3d& F_x_Ctotal) {
+  KeyBuilder<7 + 9 + 1 + 3> builder;
+  builder.add(q.data(), 7).add(I_total.data(), 9).add(m_total).add(F_x_Ctotal.data(), 3);
+  Eigen::Matrix<double, 7, 7> output;
+  entries_->mass.get(builder.key(), output.data(), [&](double* value) {
+    model_.mass(q.data(), I_total.data(), m_total, F_x_Ctotal.data(), value);
+    return true;
+  });
+  return output;
+}
+
+MassFactorization ModelCache::massFactorization(const Eigen::Matrix<double, 7, 1>& q,
+                                                const Eigen::Matrix3d& I_total,
+                                                double m_total,
+                                                const Eigen::Vector3d& F_x_Ctotal) {
+  KeyBuilder<7 + 9 + 1 + 3> builder;
+  builder.add(q.data(), 7).add(I_total.data(), 9).add(m_total).add(F_x_Ctotal.data(), 3);
+  MassFactorization output;
+  entries_->mass_factorization.get(builder.key(), output.data(), [&](double* value) {
+    MassFactorization factorization = model_.massFactorization(q, I_total, m_total, F_x_Ctotal);
+    std::copy(factorization.data(), factorization.data() + 49, value);
+    return true;
+  });
+  return output;
+}
+
+Eigen::Matrix<double, 7, 7> ModelCache::inverseMass(const Eigen::Matrix<double, 7, 1>& q,
+                                                    const Eigen::Matrix3d& I_total,
+                                                    double m_total,
+                                                    const Eigen::Vector3d& F_x_Ctotal) {
+  return massFactorization(q, I_total, m_total, F_x_Ctotal).inverse();
+}
+
+Eigen::Matrix<double, 7, 1> ModelCache::solveMass(const Eigen::Matrix<double, 7, 1>& q,
+                                                  const Eigen::Matrix<double, 7, 1>& rhs,
+                                                  const Eigen::Matrix3d& I_total,
+                                                  double m_total,
+                                                  const Eigen::Vector3d& F_x_Ctotal) {
+  return massFactorization(q, I_total, m_total, F_x_Ctotal).solve(rhs);
+}
+
+Eigen::Matrix<double, 7, 1> ModelCache::coriolis(const Eigen::Matrix<double, 7, 1>& q,
+                                                 const Eigen::Matrix<double, 7, 1>& dq,
+                                                 const Eigen::Matrix3d& I_total,
+                                                 double m_total,
+                                                 const Eigen::Vector3d& F_x_Ctotal) {
+  KeyBuilder<7 + 7 + 9 + 1 + 3> builder;
+  builder.add(q.data(), 7).add(dq.data(), 7).add(I_total.data(), 9).add(m_total).add(
+      F_x_Ctotal.data(), 3);
+  Eigen::Matrix<double, 7, 1> output;
+  entries_->coriolis.get(builder.key(), output.data(), [&](double* value) {
+    model_.coriolis(q.data(), dq.data(), I_total.data(), m_total, F_x_Ctotal.data(), value);
+    return true;
+  });
+  return output;
+}
+
+Eigen::Matrix<double, 7, 1> ModelCache::gravity(const Eigen::Matrix<double, 7, 1>& q,
+                                                double m_total,
+                                                const Eigen::Vector3d& F_x_Ctotal,
+                                                const Eigen::Vector3d& gravity_earth) {
+  KeyBuilder<7 + 1 + 3 + 3> builder;
+  builder.add(q.data(), 7).add(m_total).add(F_x_Ctotal.data(), 3).add(gravity_earth.data(), 3);
+  Eigen::Matrix<double, 7, 1> output;
+  entries_->gravity.get(builder.key(), output.data(), [&](double* value) {
+    model_.gravity(q.data(), m_total, F_x_Ctotal.data(), gravity_earth.data(), value);
+    return true;
+  });
+  return output;
+}
+
+CacheStatistics ModelCache::statistics(Query query) const noexcept {
+  switch (query) {
+    case Query::kPose:
+      return entries_->pose.statistics;
+    case Query::kBodyJacobian:
+      return entries_->body_jacobian.statistics;
+    case Query::kZeroJacobian:
+      return entries_->zero_jacobian.statistics;
+    case Query::kMass:
+      return entries_->mass.statistics;
+    case Query::kCoriolis:
+      return entries_->coriolis.statistics;
+    case Query::kGravity:
+      return entries_->gravity.statistics;
+    case Query::kMassFactorization:
+      return entries_->mass_factorization.statistics;
+    default:
+      return CacheStatistics();
+  }
+}
+
+CacheStatistics ModelCache::statistics() const noexcept {
+  CacheStatistics total;
+  for (const CacheStatistics& statistics :
+       {entries_->pose.statistics, entries_->body_jacobian.statistics,
+        entries_->zero_jacobian.statistics, entries_->mass.statistics,
+        entries_->coriolis.statistics, entries_->gravity.statistics,
+        entries_->mass_factorization.statistics}) {
+    total.hits += statistics.hits;
+    total.misses += statistics.misses;
+  }
+  return total;
+}
+
+void ModelCache::clear() noexcept {
+  entries_->pose.clear();
+  entries_->body_jacobian.clear();
+  entries_->zero_jacobian.clear();
+  entries_->mass.clear();
+  entries_->coriolis.clear();
+  entries_->gravity.clear();
+  entries_->mass_factorization.clear();
+}
+
+}  // namespace panda_model
@@ -63,14 +63,45 @@ simply run:
 """
 import numpy as np
 
-from ._core import (Architecture, Defaults, Frame, Model, OperatingSystem,
-                    download_library)
+from ._core import (Architecture, BoundModel, CacheStatistics, Capsule,
+                    Defaults, Difference, DynamicsState, Frame, IKOptions,
+                    IKSeedIndex, IKSolution, IKStatus, InstructionSet,
+                    Integrator, InverseKinematics, Linearization,
+                    MassFactorization, Model, ModelBatch, ModelCache,
+                    OperatingSystem, OperationalSpaceState, ReachabilityMap,
+                    ReachabilityOptions, Rollout, SelfCollision, ThreadPool,
+                    best_instruction_set, download_library,
+                    is_supported)
 
 __all__ = [
     "download_library",
     "Model",
+    "BoundModel",
+    "ModelBatch",
+    "ThreadPool",
+    "ModelCache",
+    "CacheStatistics",
+    "MassFactorization",
+    "Rollout",
+    "Integrator",
+    "Linearization",
+    "Difference",
+    "InverseKinematics",
+    "IKOptions",
+    "IKSolution",
+    "IKStatus",
+    "IKSeedIndex",
+    "SelfCollision",
+    "Capsule",
+    "ReachabilityMap",
+    "ReachabilityOptions",
     "Frame",
     "Defaults",
+    "DynamicsState",
+    "OperationalSpaceState",
+    "InstructionSet",
+    "best_instruction_set",
+    "is_supported",
     "Architecture",
     "OperatingSystem",
 ]
@@ -6,11 +6,35 @@ _Shape = typing.Tuple[int, ...]
 
 __all__ = [
     "Architecture",
+    "BoundModel",
+    "CacheStatistics",
+    "Capsule",
     "Defaults",
+    "Difference",
+    "DynamicsState",
     "Frame",
+    "IKOptions",
+    "IKSeedIndex",
+    "IKSolution",
+    "IKStatus",
+    "InstructionSet",
+    "Integrator",
+    "InverseKinematics",
+    "Linearization",
+    "MassFactorization",
     "Model",
+    "ModelBatch",
+    "ModelCache",
     "OperatingSystem",
-    "download_library"
+    "OperationalSpaceState",
+    "ReachabilityMap",
+    "ReachabilityOptions",
+    "Rollout",
+    "SelfCollision",
+    "ThreadPool",
+    "best_instruction_set",
+    "download_library",
+    "is_supported"
 ]
 
 
@@ -53,6 +77,101 @@ class Architecture():
     x64: panda_model._core.Architecture # value = <Architecture.x64: 0>
     x86: panda_model._core.Architecture # value = <Architecture.x86: 1>
     pass
+class BoundModel():
+    """
+    Model with a bound end effector, stiffness frame and load.
+    """
+    def __init__(self, model: Model, F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4), I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> None:
+        """
+        Bind a `Model` to an end effector and load. The composed transformations
+        are precomputed once, so the queries only take the joint state.
+        """
+    def set_tool(self, F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]], EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]]) -> None:
+        """
+        Atomically replaces the bound end effector and stiffness frame.
+        """
+    def set_payload(self, I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]], m_total: float, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]]) -> None:
+        """
+        Atomically replaces the bound load.
+        """
+    def pose(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> numpy.ndarray[numpy.float64, _Shape[4, 4]]:
+        """
+        Gets the 4x4 pose matrix for the given frame in base frame.
+        """
+    def body_jacobian(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Gets the 6x7 Jacobian for the given frame, relative to that frame.
+        """
+    def zero_jacobian(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Gets the 6x7 Jacobian for the given frame relative to the base frame.
+        """
+    def mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Calculates the 7x7 mass matrix with the bound load.
+        """
+    def coriolis(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Calculates the Coriolis force vector with the bound load.
+        """
+    def gravity(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Calculates the gravity vector with the bound load.
+        """
+    pass
+class CacheStatistics():
+    """
+    Hit and miss counters of a `ModelCache`.
+    """
+    @property
+    def hits(self) -> int:
+        """
+        Number of queries answered from the cache.
+        """
+    @property
+    def misses(self) -> int:
+        """
+        Number of queries that were evaluated by the model.
+        """
+    pass
+class Capsule():
+    """
+    Capsule rigidly attached to a frame: all points within the radius of the segment between two end points.
+    """
+    def __init__(self, frame: Frame, a: numpy.ndarray[numpy.float64, _Shape[3, 1]], b: numpy.ndarray[numpy.float64, _Shape[3, 1]], radius: float) -> None: ...
+    @property
+    def frame(self) -> Frame:
+        """
+        Frame the capsule is attached to.
+        """
+    @frame.setter
+    def frame(self, arg0: Frame) -> None:
+        pass
+    @property
+    def a(self) -> numpy.ndarray[numpy.float64, _Shape[3, 1]]:
+        """
+        First end point of the segment in the frame.
+        """
+    @a.setter
+    def a(self, arg0: numpy.ndarray[numpy.float64, _Shape[3, 1]]) -> None:
+        pass
+    @property
+    def b(self) -> numpy.ndarray[numpy.float64, _Shape[3, 1]]:
+        """
+        Second end point of the segment in the frame.
+        """
+    @b.setter
+    def b(self, arg0: numpy.ndarray[numpy.float64, _Shape[3, 1]]) -> None:
+        pass
+    @property
+    def radius(self) -> float:
+        """
+        Radius around the segment.
+        """
+    @radius.setter
+    def radius(self, arg0: float) -> None:
+        pass
+    pass
 class Defaults():
     """
     Default parameters for the Panda with standard gripper and no external load.
@@ -80,6 +199,70 @@ class Defaults():
     """
     M_TOTAL = 0.73
     pass
+class Difference():
+    """
+    Enumerates the finite difference schemes of `Linearization`.
+
+    Members:
+
+      kForward
+
+      kCentral
+    """
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    __members__: dict # value = {'kForward': <Difference.kForward: 0>, 'kCentral': <Difference.kCentral: 1>}
+    kCentral: panda_model._core.Difference # value = <Difference.kCentral: 1>
+    kForward: panda_model._core.Difference # value = <Difference.kForward: 0>
+    pass
+class DynamicsState():
+    """
+    Kinematic and dynamic quantities of the robot in one state. The attributes are views into buffers that are overwritten whenever the state is passed to `Model.compute_state` again.
+    """
+    def __init__(self) -> None: ...
+    @property
+    def O_T_EE(self) -> numpy.ndarray[numpy.float64, _Shape[4, 4]]:
+        """
+        End effector pose in base frame.
+        """
+    @property
+    def O_Jac_EE(self) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        End effector Jacobian relative to the base frame.
+        """
+    @property
+    def mass(self) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Mass matrix.
+        """
+    @property
+    def coriolis(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Coriolis force vector.
+        """
+    @property
+    def gravity(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Gravity vector.
+        """
+    pass
 class Frame():
     """
     Enumerates the seven joints, the flange, and the end effector of a robot.
@@ -137,119 +320,204 @@ class Frame():
     kJoint7: panda_model._core.Frame # value = <Frame.kJoint7: 6>
     kStiffness: panda_model._core.Frame # value = <Frame.kStiffness: 9>
     pass
-class Model():
+class IKOptions():
     """
-    Calculates poses of joints and dynamic properties of the robot.
+    Tuning parameters of `InverseKinematics`.
     """
-    def __init__(self, path: str) -> None: 
+    def __init__(self) -> None: ...
+    @property
+    def max_iterations(self) -> int:
         """
-        Construct a new `Model` instance given a shared library.
-
-        Args:
-          path: Path to the shared library downloaded with `download_library`.
-            The library must be compatible with the host system, i.e. in terms
-            of processor architecture and operating system.
+        Maximum number of damped least squares steps.
         """
-    def gravity(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]: 
+    @max_iterations.setter
+    def max_iterations(self, arg0: int) -> None:
+        pass
+    @property
+    def damping(self) -> float:
         """
-        Calculates the gravity vector. Unit: :math:`[Nm]`.
-
-        Args:
-          q: Joint position.
-          m_total: Weight of the attached total load including end effector.
-            Unit: :math:`[kg]`.
-          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
-            Unit: :math:`[m]`.
-          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
-            Default to {0.0, 0.0, -9.81}.
-
-        Returns:
-          Gravity vector.
+        Damping of the step :math:`J^T (J J^T + \lambda^2 I)^{-1} e`.
         """
-    def pose(self, frame:panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[4, 4]]:
+    @damping.setter
+    def damping(self, arg0: float) -> None:
+        pass
+    @property
+    def max_step(self) -> float:
         """
-        Gets the 4x4 pose matrix for the given frame in base frame.
-        The pose is represented as a 4x4 matrix in column-major format.
+        Largest norm of one step, longer steps are shortened.
+        """
+    @max_step.setter
+    def max_step(self, arg0: float) -> None:
+        pass
+    @property
+    def min_step(self) -> float:
+        """
+        Norm of a step below which the query is stalled.
+        """
+    @min_step.setter
+    def min_step(self, arg0: float) -> None:
+        pass
+    @property
+    def position_tolerance(self) -> float:
+        """
+        Accepted distance from the target position. Unit: :math:`[m]`.
+        """
+    @position_tolerance.setter
+    def position_tolerance(self, arg0: float) -> None:
+        pass
+    @property
+    def orientation_tolerance(self) -> float:
+        """
+        Accepted rotation angle from the target orientation. Unit: :math:`[rad]`.
+        """
+    @orientation_tolerance.setter
+    def orientation_tolerance(self, arg0: float) -> None:
+        pass
+    @property
+    def q_min(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Lower joint position limits the solution is clamped to.
+        """
+    @q_min.setter
+    def q_min(self, arg0: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> None:
+        pass
+    @property
+    def q_max(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Upper joint position limits the solution is clamped to.
+        """
+    @q_max.setter
+    def q_max(self, arg0: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> None:
+        pass
+    pass
+class IKSeedIndex():
+    """
+    Nearest neighbour index of precomputed poses of a frame, used to look up seeds of `InverseKinematics`. The index is memory-mapped from disk by `load`.
+    """
+    def __len__(self) -> int: ...
+    @staticmethod
+    def build(model: Model, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], frame: Frame = Frame.kEndEffector, orientation_scale: float = 0.1, F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> IKSeedIndex:
+        """
+        Builds an index from the poses of the given joint positions, e.g. a
+        dense sample of the joint space within the joint limits. The
+        distance of two poses is
+        :math:`\sqrt{\|\Delta p\|^2 + s^2 (\|\Delta x\|^2 + \|\Delta y\|^2)}`
+        for their positions and x and y axes.
 
         Args:
-          frame: The desired frame.
-          q: Joint position.
+          model: The model to calculate the poses with.
+          q: Joint positions of shape (N,7).
+          frame: The frame whose poses are indexed.
+          orientation_scale: Weight :math:`s` of the orientation in the
+            distance. Unit: :math:`[m]`.
           F_T_EE: End effector in flange frame.
           EE_T_K: Stiffness frame K in the end effector frame.
 
         Returns:
-          Vectorized 4x4 pose matrix, column-major.
+          Index of the poses.
         """
-    def body_jacobian(self, frame:panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+    @staticmethod
+    def load(path: str) -> IKSeedIndex:
         """
-        Gets the 6x7 Jacobian for the given frame, relative to that frame.
-        The Jacobian is represented as a 6x7 matrix in column-major format.
+        Memory-maps an index written by `save`.
 
         Args:
-          frame: The desired frame.
-          q: Joint position.
-          F_T_EE: End effector in flange frame.
-          EE_T_K: Stiffness frame K in the end effector frame.
+          path: Path of the index file.
 
         Returns:
+          Index stored in the file.
         """
-    def zero_jacobian(self, frame:panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+    def save(self, path: str) -> None:
         """
-        Gets the 6x7 Jacobian for the given joint relative to the base frame.
-        The Jacobian is represented as a 6x7 matrix in column-major format.
+        Writes the index to a file that can be memory-mapped by `load`.
 
         Args:
-          frame: The desired frame.
-          q: Joint position.
-          F_T_EE: End effector in flange frame.
-          EE_T_K: Stiffness frame K in the end effector frame.
+          path: Path of the index file, overwritten if it exists.
+        """
+    @property
+    def frame(self) -> Frame:
+        """
+        The frame whose poses are indexed.
 
-        Returns:
-          Vectorized 6x7 Jacobian, column-major.
+        :type: Frame
         """
-    def mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+    @property
+    def orientation_scale(self) -> float:
         """
-        Calculates the 7x7 mass matrix. Unit: :math:`[kg \times m^2]`.
+        Weight of the orientation in the distance.
+
+        :type: float
+        """
+    def nearest(self, target: numpy.ndarray[numpy.float64, _Shape[4, 4]], k: int = 1) -> typing.Tuple[numpy.ndarray[numpy.float64, _Shape[K, 7]], numpy.ndarray[numpy.float64, _Shape[K]]]:
+        """
+        Finds the joint positions whose poses are nearest to the given
+        target.
 
         Args:
-          q: Joint position.
-          I_total: Inertia of the attached total load including end effector, relative to
-            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
-          m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
-          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
-            Unit: :math:`[m]`.
+          target: Target pose of the frame relative to the base frame.
+          k: Maximum number of seeds.
 
         Returns:
-          Vectorized 7x7 mass matrix, column-major.
+          Tuple of seeds of shape (K,7) by ascending distance and their
+          distances of shape (K,), with K the smaller of k and the size of
+          the index.
         """
-    def coriolis(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+    def nearest_batch(self, targets: numpy.ndarray[numpy.float64, _Shape[N, 4, 4]], k: int = 1) -> typing.Tuple[numpy.ndarray[numpy.float64, _Shape[N, K, 7]], numpy.ndarray[numpy.float64, _Shape[N, K]]]:
         """
-        Calculates the Coriolis force vector (state-space equation): :math:` c= C \times
-        dq`, in :math:`[Nm]`.
+        Finds the nearest joint positions for a batch of targets, see
+        `nearest`.
 
         Args:
-          q: Joint position.
-          dq: Joint velocity.
-          I_total: Inertia of the attached total load including end effector, relative to
-            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
-          m_total: Weight of the attached total load including end effector.
-            Unit: :math:`[kg]`.
-          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
-            Unit: :math:`[m]`.
+          targets: Target poses of the frame relative to the base frame of
+            shape (N,4,4).
+          k: Maximum number of seeds per target.
 
         Returns:
-          Coriolis force vector.
+          Tuple of seeds of shape (N,K,7) and their distances of shape
+          (N,K), with K the smaller of k and the size of the index.
         """
     pass
-class OperatingSystem():
+class IKSolution():
     """
-    Used to describe the operating System of the shared library.
+    Result of one `InverseKinematics` query.
+    """
+    @property
+    def q(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Joint position of the last iterate, within the joint limits.
+        """
+    @property
+    def status(self) -> IKStatus:
+        """
+        Outcome of the query.
+        """
+    @property
+    def iterations(self) -> int:
+        """
+        Number of steps taken.
+        """
+    @property
+    def position_error(self) -> float:
+        """
+        Distance from the target position at q. Unit: :math:`[m]`.
+        """
+    @property
+    def orientation_error(self) -> float:
+        """
+        Rotation angle from the target orientation at q. Unit: :math:`[rad]`.
+        """
+    pass
+class IKStatus():
+    """
+    Enumerates the outcomes of an `InverseKinematics` query.
 
     Members:
 
-      linux
+      kConverged
 
-      windows
+      kMaxIterations
+
+      kStalled
     """
     def __eq__(self, other: object) -> bool: ...
     def __getstate__(self) -> int: ...
@@ -270,23 +538,1515 @@ class OperatingSystem():
         """
         :type: int
         """
-    __members__: dict # value = {'linux': <OperatingSystem.linux: 0>, 'windows': <OperatingSystem.windows: 1>}
-    linux: panda_model._core.OperatingSystem # value = <OperatingSystem.linux: 0>
-    windows: panda_model._core.OperatingSystem # value = <OperatingSystem.windows: 1>
+    __members__: dict # value = {'kConverged': <IKStatus.kConverged: 0>, 'kMaxIterations': <IKStatus.kMaxIterations: 1>, 'kStalled': <IKStatus.kStalled: 2>}
+    kConverged: panda_model._core.IKStatus # value = <IKStatus.kConverged: 0>
+    kMaxIterations: panda_model._core.IKStatus # value = <IKStatus.kMaxIterations: 1>
+    kStalled: panda_model._core.IKStatus # value = <IKStatus.kStalled: 2>
     pass
-def download_library(hostname: str, path: str = '', architecture: Architecture = Architecture.x64, operating_system: OperatingSystem = OperatingSystem.linux, version: int = 5) -> str:
+class InstructionSet():
     """
-    Download model library from a connected control unit.
+    Enumerates the instruction sets the vectorized pose kernel is implemented for.
 
-    Args:
-      hostname: Hostname or IP address of the master control unit.
-      path: The path the shared library is downloaded to.
-      architecture: Download the shared library built for the given
-        processor architecture.
-      operating_system: Download the shared library built for the given
-        operating system.
-      version: FCI version running on the targeted master control unit.
+    Members:
 
-    Returns:
-      Path pointing to the downloaded library.
+      kScalar
+
+      kAVX2
+
+      kAVX512
+    """
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    __members__: dict # value = {'kScalar': <InstructionSet.kScalar: 0>, 'kAVX2': <InstructionSet.kAVX2: 1>, 'kAVX512': <InstructionSet.kAVX512: 2>}
+    kAVX2: panda_model._core.InstructionSet # value = <InstructionSet.kAVX2: 1>
+    kAVX512: panda_model._core.InstructionSet # value = <InstructionSet.kAVX512: 2>
+    kScalar: panda_model._core.InstructionSet # value = <InstructionSet.kScalar: 0>
+    pass
+class Integrator():
+    """
+    Enumerates the integration schemes of `Rollout`.
+
+    Members:
+
+      kSemiImplicitEuler
+
+      kRungeKutta4
+    """
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    __members__: dict # value = {'kSemiImplicitEuler': <Integrator.kSemiImplicitEuler: 0>, 'kRungeKutta4': <Integrator.kRungeKutta4: 1>}
+    kRungeKutta4: panda_model._core.Integrator # value = <Integrator.kRungeKutta4: 1>
+    kSemiImplicitEuler: panda_model._core.Integrator # value = <Integrator.kSemiImplicitEuler: 0>
+    pass
+class InverseKinematics():
+    """
+    Solves inverse kinematics of a `Model` for batches of target poses with damped least squares in parallel.
+    """
+    def __init__(self, model: Model, num_threads: int = 0, grain_size: int = 4) -> None:
+        """
+        Create an inverse kinematics engine and start its worker threads.
+
+        Args:
+          model: The model to invert.
+          num_threads: Number of threads, zero selects the number of hardware threads.
+          grain_size: Number of queries solved per scheduled chunk.
+        """
+    @property
+    def num_threads(self) -> int:
+        """
+        Number of threads used for solving.
+
+        :type: int
+        """
+    def solve(self, frame: Frame, target: numpy.ndarray[numpy.float64, _Shape[4, 4]], seed: numpy.ndarray[numpy.float64, _Shape[7, 1]], options: IKOptions = ..., F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> IKSolution:
+        """
+        Solves one query on the calling thread.
+
+        Args:
+          frame: The desired frame.
+          target: Desired pose of the frame relative to the base frame.
+          seed: Initial joint position, clamped to the joint limits.
+          options: Tuning parameters.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Solution of the query.
+        """
+    def solve_batch(self, frame: Frame, targets: numpy.ndarray[numpy.float64, _Shape[N, 4, 4]], seeds: numpy.ndarray[numpy.float64, _Shape[N, 7]], options: IKOptions = ..., F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> typing.Tuple[numpy.ndarray[numpy.float64, _Shape[N, 7]], numpy.ndarray[numpy.uint8, _Shape[N]], numpy.ndarray[numpy.uint64, _Shape[N]]]:
+        """
+        Solves a batch of queries in parallel, each warm started from its
+        own seed.
+
+        Args:
+          frame: The desired frame.
+          targets: Desired poses of the frame relative to the base frame of
+            shape (N,4,4).
+          seeds: Initial joint positions of shape (N,7), clamped to the
+            joint limits.
+          options: Tuning parameters shared by all queries.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Tuple of joint positions of shape (N,7), the values of
+          `IKStatus` of shape (N,) and the iteration counts of shape (N,).
+        """
+    pass
+class Linearization():
+    """
+    Linearizes the equations of motion of a `Model` around batches of knots in parallel.
+    """
+    def __init__(self, model: Model, num_threads: int = 0, grain_size: int = 4) -> None:
+        """
+        Create a linearization engine and start its worker threads.
+
+        Args:
+          model: The model to linearize.
+          num_threads: Number of threads, zero selects the number of hardware threads.
+          grain_size: Number of perturbations evaluated per scheduled chunk.
+        """
+    @property
+    def num_threads(self) -> int:
+        """
+        Number of threads used for linearization.
+
+        :type: int
+        """
+    def linearize(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], tau: numpy.ndarray[numpy.float64, _Shape[N, 7]], difference: Difference = Difference.kCentral, step: float = 1e-06, I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ..., gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> typing.Tuple[numpy.ndarray[numpy.float64, _Shape[N, 14, 14]], numpy.ndarray[numpy.float64, _Shape[N, 14, 7]]]:
+        """
+        Calculates the continuous-time state space matrices of the
+        equations of motion for the state :math:`x = (q, \dot{q})`, i.e.
+        :math:`\dot{x} \approx A x + B \tau` around each knot. The
+        derivatives of the joint acceleration are approximated with finite
+        differences, the input matrix holds the exact inverse mass matrix.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          tau: Joint torques of shape (N,7). Unit: :math:`[Nm]`.
+          difference: Finite difference scheme.
+          step: Perturbation of each state coordinate.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Tuple of state matrices of shape (N,14,14) and input matrices of
+          shape (N,14,7).
+        """
+    pass
+class MassFactorization():
+    """
+    Factorization :math:`M = L D L^T` of a 7x7 mass matrix, which is reused to solve for several right-hand sides.
+    """
+    def __init__(self, mass: numpy.ndarray[numpy.float64, _Shape[7, 7]]) -> None:
+        """
+        Factorize the given mass matrix.
+
+        Args:
+          mass: Positive definite 7x7 mass matrix.
+        """
+    @property
+    def L(self) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Unit lower triangular factor.
+        """
+    @property
+    def D(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Diagonal of the diagonal factor.
+        """
+    def mass(self) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Reconstructs the factorized mass matrix.
+        """
+    def solve(self, rhs: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Solves :math:`M x = b`.
+
+        Args:
+          rhs: Right-hand side :math:`b`.
+
+        Returns:
+          Solution :math:`x`.
+        """
+    def inverse(self) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Calculates the inverse mass matrix.
+        """
+    pass
+class Model():
+    """
+    Calculates poses of joints and dynamic properties of the robot.
+    """
+    def __init__(self, path: str) -> None: 
+        """
+        Construct a new `Model` instance given a shared library.
+
+        Args:
+          path: Path to the shared library downloaded with `download_library`.
+            The library must be compatible with the host system, i.e. in terms
+            of processor architecture and operating system.
+        """
+    @staticmethod
+    def native() -> Model: 
+        """
+        Create a `Model` that calculates poses, Jacobians and dynamics natively
+        from the published kinematic and identified inertial parameters of the
+        robot, without a shared library.
+        """
+    def inverse_dynamics(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], ddq: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Calculates the joint torques for the given joint acceleration, i.e.
+        :math:`M(q) \ddot{q} + C(q, \dot{q}) \dot{q} + g(q)`.
+        Unit: :math:`[Nm]`. A native model calculates the torques from
+        identified inertial parameters. A model backed by the shared library
+        assembles them from its `mass`, `coriolis` and `gravity` instead.
+
+        Args:
+          q: Joint position.
+          dq: Joint velocity.
+          ddq: Joint acceleration.
+          I_total: Inertia of the attached total load including end effector, relative to center of mass. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Joint torques.
+        """
+    def forward_dynamics(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], tau: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Calculates the joint acceleration for the given joint torques, i.e.
+        :math:`M(q)^{-1} (\tau - C(q, \dot{q}) \dot{q} - g(q))`.
+        Unit: :math:`[\frac{rad}{s^2}]`. A native model calculates the
+        acceleration from identified inertial parameters without building or
+        inverting the mass matrix. A model backed by the shared library solves
+        its `mass` against its `coriolis` and `gravity` instead, like `Rollout`.
+
+        Args:
+          q: Joint position.
+          dq: Joint velocity.
+          tau: Joint torques. Unit: :math:`[Nm]`.
+          I_total: Inertia of the attached total load including end effector, relative to center of mass. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Joint acceleration.
+        """
+    def gravity(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]: 
+        """
+        Calculates the gravity vector. Unit: :math:`[Nm]`.
+
+        Args:
+          q: Joint position.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+            Default to {0.0, 0.0, -9.81}.
+
+        Returns:
+          Gravity vector.
+        """
+    def pose(self, frame:panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[4, 4]]:
+        """
+        Gets the 4x4 pose matrix for the given frame in base frame.
+        The pose is represented as a 4x4 matrix in column-major format.
+
+        Args:
+          frame: The desired frame.
+          q: Joint position.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Vectorized 4x4 pose matrix, column-major.
+        """
+    def body_jacobian(self, frame:panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Gets the 6x7 Jacobian for the given frame, relative to that frame.
+        The Jacobian is represented as a 6x7 matrix in column-major format.
+
+        Args:
+          frame: The desired frame.
+          q: Joint position.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+        """
+    def zero_jacobian(self, frame:panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Gets the 6x7 Jacobian for the given joint relative to the base frame.
+        The Jacobian is represented as a 6x7 matrix in column-major format.
+
+        Args:
+          frame: The desired frame.
+          q: Joint position.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Vectorized 6x7 Jacobian, column-major.
+        """
+    def body_jacobian_dot(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Gets the time derivative of the 6x7 Jacobian for the given frame,
+        relative to that frame.
+        The derivative is calculated natively from the kinematic parameters,
+        independent of the shared library.
+
+        Args:
+          frame: The desired frame.
+          q: Joint position.
+          dq: Joint velocity.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Vectorized 6x7 Jacobian derivative, column-major.
+        """
+    def zero_jacobian_dot(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Gets the time derivative of the 6x7 Jacobian for the given frame
+        relative to the base frame.
+        The derivative is calculated natively from the kinematic parameters,
+        independent of the shared library.
+
+        Args:
+          frame: The desired frame.
+          q: Joint position.
+          dq: Joint velocity.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Vectorized 6x7 Jacobian derivative, column-major.
+        """
+    def mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Calculates the 7x7 mass matrix. Unit: :math:`[kg \times m^2]`.
+
+        Args:
+          q: Joint position.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Vectorized 7x7 mass matrix, column-major.
+        """
+    def coriolis(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Calculates the Coriolis force vector (state-space equation): :math:` c= C \times
+        dq`, in :math:`[Nm]`.
+
+        Args:
+          q: Joint position.
+          dq: Joint velocity.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Coriolis force vector.
+        """
+    def coriolis_matrix(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03])) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Calculates the 7x7 Coriolis matrix :math:`C(q, \dot{q})`, such that
+        :math:`C(q, \dot{q}) \dot{q}` is the Coriolis force vector of `coriolis`
+        and :math:`\dot{M}(q) - 2 C(q, \dot{q})` is skew-symmetric for the mass
+        matrix of `mass`.
+        A native model calculates the matrix from identified inertial
+        parameters. A model backed by the shared library sums the Christoffel
+        symbols of its `mass` instead, whose partial derivatives are taken by
+        central differences, so both properties hold up to the differencing
+        accuracy.
+
+        Args:
+          q: Joint position.
+          dq: Joint velocity.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Coriolis matrix.
+        """
+    def mass_factorization(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03])) -> MassFactorization:
+        """
+        Factorizes the 7x7 mass matrix to solve for several right-hand sides.
+
+        Args:
+          q: Joint position.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          `MassFactorization` of the mass matrix.
+        """
+    def inverse_mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03])) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Calculates the inverse of the 7x7 mass matrix from its factorization.
+
+        Args:
+          q: Joint position.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Inverse mass matrix.
+        """
+    def solve_mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], rhs: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03])) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Solves :math:`M(q) x = b` from the factorization of the mass matrix.
+
+        Args:
+          q: Joint position.
+          rhs: Right-hand side :math:`b`.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Solution :math:`x`.
+        """
+    def poses(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[10, 4, 4]]:
+        """
+        Gets the 4x4 pose matrices of all frames in base frame.
+
+        Args:
+          q: Joint position.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Pose matrices of shape (10,4,4), indexed by `Frame`.
+        """
+    def body_jacobians(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[10, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians of all frames, each relative to its own frame.
+
+        Args:
+          q: Joint position.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (10,6,7), indexed by `Frame`.
+        """
+    def zero_jacobians(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[10, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians of all frames relative to the base frame.
+
+        Args:
+          q: Joint position.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (10,6,7), indexed by `Frame`.
+        """
+    def compute_state(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], state: typing.Optional[DynamicsState] = None, F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> DynamicsState:
+        """
+        Calculates end effector pose, end effector zero Jacobian, mass
+        matrix, Coriolis and gravity vector for one state in a single call.
+
+        Args:
+          q: Joint position.
+          dq: Joint velocity.
+          state: `DynamicsState` whose buffers are reused for the result.
+            A new one is created if omitted.
+          F_T_EE: End effector in flange frame.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          The `DynamicsState` holding the results.
+        """
+    def operational_space(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], state: typing.Optional[OperationalSpaceState] = None, F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4), I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> OperationalSpaceState:
+        """
+        Calculates the operational space inertia matrix, the dynamically
+        consistent generalized inverse, the task space Coriolis and gravity
+        forces and the null-space projector of the given frame for one
+        state in a single call. The Jacobian of the frame must have full
+        row rank.
+
+        Args:
+          frame: The desired frame.
+          q: Joint position.
+          dq: Joint velocity.
+          state: `OperationalSpaceState` whose buffers are reused for the
+            result. A new one is created if omitted.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          The `OperationalSpaceState` holding the results.
+        """
+    def pose_batch(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4), instruction_set: panda_model._core.InstructionSet = ...) -> numpy.ndarray[numpy.float64, _Shape[N, 4, 4]]:
+        """
+        Gets the 4x4 pose matrices for the given frame in base frame for a
+        batch of joint positions.
+
+        For a native `Model` the poses are calculated by a vectorized
+        kernel, see `best_instruction_set`.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+          instruction_set: Instruction set of the kernel. Falls back to
+            `best_instruction_set` if not supported, see `is_supported`.
+            Ignored by a `Model` backed by the model library.
+
+        Returns:
+          Pose matrices of shape (N,4,4).
+        """
+    def poses_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 10, 4, 4]]:
+        """
+        Gets the 4x4 pose matrices of all frames in base frame for a batch
+        of joint positions.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Pose matrices of shape (N,10,4,4), indexed by sample and `Frame`.
+        """
+    def body_jacobian_batch(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians for the given frame, relative to that frame,
+        for a batch of joint positions.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (N,6,7).
+        """
+    def zero_jacobian_batch(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians for the given frame relative to the base frame
+        for a batch of joint positions.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (N,6,7).
+        """
+    def body_jacobian_dot_batch(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 6, 7]]:
+        """
+        Gets the time derivatives of the 6x7 Jacobians for the given frame,
+        relative to that frame, for a batch of joint states.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobian derivatives of shape (N,6,7).
+        """
+    def zero_jacobian_dot_batch(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 6, 7]]:
+        """
+        Gets the time derivatives of the 6x7 Jacobians for the given frame
+        relative to the base frame for a batch of joint states.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobian derivatives of shape (N,6,7).
+        """
+    def body_jacobians_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 10, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians of all frames, each relative to its own
+        frame, for a batch of joint positions.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (N,10,6,7), indexed by sample and `Frame`.
+        """
+    def zero_jacobians_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 10, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians of all frames relative to the base frame for
+        a batch of joint positions.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (N,10,6,7), indexed by sample and `Frame`.
+        """
+    def mass_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[N, 7, 7]]:
+        """
+        Calculates the 7x7 mass matrices for a batch of joint positions.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Mass matrices of shape (N,7,7).
+        """
+    def inverse_mass_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[N, 7, 7]]:
+        """
+        Calculates the inverse 7x7 mass matrices for a batch of joint positions.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Inverse mass matrices of shape (N,7,7).
+        """
+    def solve_mass_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], rhs: numpy.ndarray[numpy.float64, _Shape[N, 7]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[N, 7]]:
+        """
+        Solves :math:`M(q) x = b` for a batch of joint positions and
+        right-hand sides.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          rhs: Right-hand sides of shape (N,7).
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector. Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Solutions of shape (N,7).
+        """
+    def coriolis_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[N, 7]]:
+        """
+        Calculates the Coriolis force vectors for a batch of joint states.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Coriolis force vectors of shape (N,7).
+        """
+    def gravity_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[N, 7]]:
+        """
+        Calculates the gravity vectors for a batch of joint positions.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Gravity vectors of shape (N,7).
+        """
+    def forward_dynamics_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], tau: numpy.ndarray[numpy.float64, _Shape[N, 7]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[N, 7]]:
+        """
+        Calculates the joint accelerations for a batch of joint states and
+        torques, see `forward_dynamics`.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          tau: Joint torques of shape (N,7). Unit: :math:`[Nm]`.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Joint accelerations of shape (N,7).
+        """
+    def inverse_dynamics_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], ddq: numpy.ndarray[numpy.float64, _Shape[N, 7]], out: typing.Optional[numpy.ndarray[numpy.float64, _Shape[N, 7]]] = None, I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[N, 7]]:
+        """
+        Calculates the joint torques
+        :math:`M(q) \ddot{q} + C(q, \dot{q}) \dot{q} + g(q)` for a batch of joint
+        states and accelerations.
+
+        The torques are calculated like `inverse_dynamics`.
+
+        The samples are processed in a single pass, so memory-mapped
+        trajectories are streamed from and to disk. Float64 C-contiguous
+        inputs, e.g. a numpy.memmap, are read without a copy.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          ddq: Joint accelerations of shape (N,7).
+          out: Writable C-contiguous float64 array of shape (N,7) the
+            torques are written into, e.g. a numpy.memmap. Allocated if None.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Joint torques of shape (N,7), out if given. Unit: :math:`[Nm]`.
+        """
+    def inverse_dynamics_trajectory(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], ddq: numpy.ndarray[numpy.float64, _Shape[N, 7]], sink: typing.Callable[[int, numpy.ndarray[numpy.float64, _Shape[N, 7]]], None], chunk_size: int = 1024, I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([[0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> None:
+        """
+        Streams the joint torques along a trajectory to the given sink in
+        chunks, calculated like `inverse_dynamics_batch`.
+
+        Only one chunk of torques is held in memory at a time, so
+        memory-mapped trajectories of any length are evaluated with a
+        constant working set, e.g. to check logged torques against their
+        limits. The GIL is released while the chunks are computed.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          ddq: Joint accelerations of shape (N,7).
+          sink: Called as sink(offset, tau) in order with the index of the
+            first sample of each chunk and its joint torques of shape
+            (count,7). Exceptions abort the evaluation.
+          chunk_size: Maximum number of samples per chunk, at least one.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+        """
+    pass
+class ModelBatch():
+    """
+    Evaluates a `Model` for large batches of joint states in parallel.
+    """
+    def __init__(self, model: Model, num_threads: int = 0, grain_size: int = 256) -> None:
+        """
+        Create a batch evaluator and start its worker threads.
+
+        Args:
+          model: The model to evaluate.
+          num_threads: Number of threads, zero selects the number of hardware threads.
+          grain_size: Number of joint states evaluated per scheduled chunk.
+        """
+    @property
+    def num_threads(self) -> int:
+        """
+        Number of threads used for evaluation.
+
+        :type: int
+        """
+    def pose(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 4, 4]]:
+        """
+        Gets the 4x4 pose matrices for the given frame in base frame, see
+        `Model.pose_batch`.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Pose matrices of shape (N,4,4).
+        """
+    def body_jacobian(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians for the given frame, relative to that frame,
+        see `Model.body_jacobian_batch`.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (N,6,7).
+        """
+    def zero_jacobian(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = array([[0.7071, 0.7071, 0, 0], [-0.7071, 0.7071, 0, 0], [0, 0, 1, 0.1034], [0, 0, 0, 1]]), EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = numpy.eye(4)) -> numpy.ndarray[numpy.float64, _Shape[N, 6, 7]]:
+        """
+        Gets the 6x7 Jacobians for the given frame, relative to the base
+        frame, see `Model.zero_jacobian_batch`.
+
+        Args:
+          frame: The desired frame.
+          q: Joint positions of shape (N,7).
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Jacobians of shape (N,6,7).
+        """
+    def mass(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[N, 7, 7]]:
+        """
+        Calculates the 7x7 mass matrices, see `Model.mass_batch`.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Mass matrices of shape (N,7,7).
+        """
+    def coriolis(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq: numpy.ndarray[numpy.float64, _Shape[N, 7]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = array([0.001, 0, 0], [0, 0.0025, 0], [0, 0, 0.0017]), m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01, 0, 0.03])) -> numpy.ndarray[numpy.float64, _Shape[N, 7]]:
+        """
+        Calculates the Coriolis force vectors, see `Model.coriolis_batch`.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          dq: Joint velocities of shape (N,7).
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+
+        Returns:
+          Coriolis force vectors of shape (N,7).
+        """
+    def gravity(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([-0.01,  0.  ,  0.03]), gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = array([ 0.  ,  0.  , -9.81])) -> numpy.ndarray[numpy.float64, _Shape[N, 7]]:
+        """
+        Calculates the gravity vectors, see `Model.gravity_batch`.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Gravity vectors of shape (N,7).
+        """
+    pass
+class ModelCache():
+    """
+    Remembers the last few results of each `Model` query. A query is answered from the cache if all of its arguments are bitwise identical to those of a remembered query.
+    """
+    class Query():
+        """
+        Enumerates the cached query types.
+
+        Members:
+
+          kPose
+
+          kBodyJacobian
+
+          kZeroJacobian
+
+          kMass
+
+          kCoriolis
+
+          kGravity
+
+          kMassFactorization
+        """
+        kPose: panda_model._core.ModelCache.Query
+        kBodyJacobian: panda_model._core.ModelCache.Query
+        kZeroJacobian: panda_model._core.ModelCache.Query
+        kMass: panda_model._core.ModelCache.Query
+        kCoriolis: panda_model._core.ModelCache.Query
+        kGravity: panda_model._core.ModelCache.Query
+        kMassFactorization: panda_model._core.ModelCache.Query
+        pass
+    def __init__(self, model: Model, capacity: int = 4) -> None:
+        """
+        Create an empty cache in front of the given `Model`.
+
+        Args:
+          model: The model to evaluate on a miss.
+          capacity: Number of results remembered per query type.
+        """
+    def pose(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> numpy.ndarray[numpy.float64, _Shape[4, 4]]:
+        """
+        Cached `Model.pose`.
+        """
+    def body_jacobian(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Cached `Model.body_jacobian`.
+        """
+    def zero_jacobian(self, frame: panda_model._core.Frame, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> numpy.ndarray[numpy.float64, _Shape[6, 7]]:
+        """
+        Cached `Model.zero_jacobian`.
+        """
+    def mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Cached `Model.mass`.
+        """
+    def coriolis(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], dq: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Cached `Model.coriolis`.
+        """
+    def gravity(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ..., gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Cached `Model.gravity`.
+        """
+    def mass_factorization(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> MassFactorization:
+        """
+        Cached `Model.mass_factorization`.
+        """
+    def inverse_mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        `Model.inverse_mass` from the cached factorization.
+        """
+    def solve_mass(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], rhs: numpy.ndarray[numpy.float64, _Shape[7, 1]], I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        `Model.solve_mass` from the cached factorization.
+        """
+    @typing.overload
+    def statistics(self, query: ModelCache.Query) -> CacheStatistics:
+        """
+        Gets the hit and miss counters of the given query type.
+        """
+    @typing.overload
+    def statistics(self) -> CacheStatistics:
+        """
+        Gets the hit and miss counters summed over all query types.
+        """
+    def clear(self) -> None:
+        """
+        Forgets all remembered results and resets the counters.
+        """
+    pass
+class OperatingSystem():
+    """
+    Used to describe the operating System of the shared library.
+
+    Members:
+
+      linux
+
+      windows
+    """
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    __members__: dict # value = {'linux': <OperatingSystem.linux: 0>, 'windows': <OperatingSystem.windows: 1>}
+    linux: panda_model._core.OperatingSystem # value = <OperatingSystem.linux: 0>
+    windows: panda_model._core.OperatingSystem # value = <OperatingSystem.windows: 1>
+    pass
+class OperationalSpaceState():
+    """
+    Operational space dynamics of one frame in one state. The attributes are views into buffers that are overwritten whenever the state is passed to `Model.operational_space` again.
+    """
+    def __init__(self) -> None: ...
+    @property
+    def Lambda(self) -> numpy.ndarray[numpy.float64, _Shape[6, 6]]:
+        """
+        Operational space inertia matrix :math:`(J M^{-1} J^T)^{-1}`.
+        """
+    @property
+    def J_bar(self) -> numpy.ndarray[numpy.float64, _Shape[7, 6]]:
+        """
+        Dynamically consistent generalized inverse :math:`M^{-1} J^T \Lambda`.
+        """
+    @property
+    def mu(self) -> numpy.ndarray[numpy.float64, _Shape[6, 1]]:
+        """
+        Task space Coriolis force :math:`\bar{J}^T c - \Lambda \dot{J} \dot{q}`.
+        """
+    @property
+    def p(self) -> numpy.ndarray[numpy.float64, _Shape[6, 1]]:
+        """
+        Task space gravity force :math:`\bar{J}^T g`.
+        """
+    @property
+    def N(self) -> numpy.ndarray[numpy.float64, _Shape[7, 7]]:
+        """
+        Dynamically consistent null-space projector for joint torques :math:`I - J^T \bar{J}^T`.
+        """
+    pass
+class ReachabilityMap():
+    """
+    Voxel grid over the workspace that records how often uniformly sampled joint positions reach each voxel and their manipulability.
+    """
+    def __len__(self) -> int: ...
+    @staticmethod
+    def generate(model: Model, options: ReachabilityOptions = ..., num_threads: int = 0, grain_size: int = 1024, F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> ReachabilityMap:
+        """
+        Samples joint positions uniformly within the joint limits in
+        parallel and accumulates the statistics of the voxels their frame
+        positions fall into. The manipulability of a joint position is
+        :math:`\sqrt{\det(J J^T)}` and its condition number is the ratio of
+        the largest to the smallest singular value of the zero Jacobian
+        :math:`J`. The samples only depend on the options and the grain
+        size, not on the number of threads.
+
+        Args:
+          model: The model to calculate the poses and Jacobians with.
+          options: Sampling parameters.
+          num_threads: Number of threads, zero selects the number of
+            hardware threads.
+          grain_size: Number of joint positions sampled per scheduled chunk.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Map of the sampled joint positions.
+        """
+    @staticmethod
+    def load(path: str) -> ReachabilityMap:
+        """
+        Reads a map written by `save`.
+
+        Args:
+          path: Path of the map file.
+
+        Returns:
+          Map stored in the file.
+        """
+    def save(self, path: str) -> None:
+        """
+        Writes the map to a compact binary file that can be read by `load`.
+
+        Args:
+          path: Path of the map file, overwritten if it exists.
+        """
+    def index(self, position: numpy.ndarray[numpy.float64, _Shape[3, 1]]) -> typing.Optional[int]:
+        """
+        Gets the voxel containing the given position.
+
+        Args:
+          position: Position in the base frame.
+
+        Returns:
+          Flat index of the voxel in C order, or None if the position is
+          outside the grid.
+        """
+    def center(self, index: int) -> numpy.ndarray[numpy.float64, _Shape[3, 1]]:
+        """
+        Gets the center of the given voxel.
+
+        Args:
+          index: Flat index of the voxel in C order.
+
+        Returns:
+          Center in the base frame.
+        """
+    @property
+    def frame(self) -> Frame:
+        """
+        The frame whose positions are binned.
+
+        :type: Frame
+        """
+    @property
+    def lower(self) -> numpy.ndarray[numpy.float64, _Shape[3, 1]]:
+        """
+        Lower corner of the voxel grid in the base frame.
+
+        :type: numpy.ndarray[numpy.float64, _Shape[3, 1]]
+        """
+    @property
+    def resolution(self) -> float:
+        """
+        Edge length of the voxels.
+
+        :type: float
+        """
+    @property
+    def shape(self) -> typing.Tuple[int, int, int]:
+        """
+        Number of voxels along the x, y and z axes.
+
+        :type: typing.Tuple[int, int, int]
+        """
+    @property
+    def samples(self) -> int:
+        """
+        Number of joint positions the map was generated from, including those outside the grid.
+
+        :type: int
+        """
+    @property
+    def counts(self) -> numpy.ndarray[numpy.uint32, _Shape[X, Y, Z]]:
+        """
+        Number of samples per voxel of the grid's shape, zero for unreachable voxels.
+
+        :type: numpy.ndarray[numpy.uint32, _Shape[X, Y, Z]]
+        """
+    @property
+    def mean_manipulability(self) -> numpy.ndarray[numpy.float32, _Shape[X, Y, Z]]:
+        """
+        Mean manipulability of the samples per voxel, zero for unreachable voxels.
+
+        :type: numpy.ndarray[numpy.float32, _Shape[X, Y, Z]]
+        """
+    @property
+    def max_manipulability(self) -> numpy.ndarray[numpy.float32, _Shape[X, Y, Z]]:
+        """
+        Largest manipulability of the samples per voxel, zero for unreachable voxels.
+
+        :type: numpy.ndarray[numpy.float32, _Shape[X, Y, Z]]
+        """
+    @property
+    def min_condition(self) -> numpy.ndarray[numpy.float32, _Shape[X, Y, Z]]:
+        """
+        Smallest condition number of the samples per voxel, infinite for unreachable voxels.
+
+        :type: numpy.ndarray[numpy.float32, _Shape[X, Y, Z]]
+        """
+    pass
+class ReachabilityOptions():
+    """
+    Sampling parameters of `ReachabilityMap.generate`.
+    """
+    def __init__(self) -> None: ...
+    @property
+    def frame(self) -> Frame:
+        """
+        Frame whose positions are binned into voxels.
+        """
+    @frame.setter
+    def frame(self, arg0: Frame) -> None:
+        pass
+    @property
+    def lower(self) -> numpy.ndarray[numpy.float64, _Shape[3, 1]]:
+        """
+        Lower corner of the voxel grid in the base frame. Unit: :math:`[m]`.
+        """
+    @lower.setter
+    def lower(self, arg0: numpy.ndarray[numpy.float64, _Shape[3, 1]]) -> None:
+        pass
+    @property
+    def upper(self) -> numpy.ndarray[numpy.float64, _Shape[3, 1]]:
+        """
+        Upper corner of the voxel grid in the base frame, rounded up to whole voxels. Unit: :math:`[m]`.
+        """
+    @upper.setter
+    def upper(self, arg0: numpy.ndarray[numpy.float64, _Shape[3, 1]]) -> None:
+        pass
+    @property
+    def resolution(self) -> float:
+        """
+        Edge length of the cubic voxels. Unit: :math:`[m]`.
+        """
+    @resolution.setter
+    def resolution(self, arg0: float) -> None:
+        pass
+    @property
+    def samples(self) -> int:
+        """
+        Number of sampled joint positions.
+        """
+    @samples.setter
+    def samples(self, arg0: int) -> None:
+        pass
+    @property
+    def seed(self) -> int:
+        """
+        Seed of the random number generator.
+        """
+    @seed.setter
+    def seed(self, arg0: int) -> None:
+        pass
+    @property
+    def q_min(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Lower joint position limits the samples are drawn within.
+        """
+    @q_min.setter
+    def q_min(self, arg0: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> None:
+        pass
+    @property
+    def q_max(self) -> numpy.ndarray[numpy.float64, _Shape[7, 1]]:
+        """
+        Upper joint position limits the samples are drawn within.
+        """
+    @q_max.setter
+    def q_max(self, arg0: numpy.ndarray[numpy.float64, _Shape[7, 1]]) -> None:
+        pass
+    pass
+class Rollout():
+    """
+    Integrates the equations of motion of a `Model` for batches of initial states in parallel.
+    """
+    def __init__(self, model: Model, num_threads: int = 0, grain_size: int = 1) -> None:
+        """
+        Create a rollout engine and start its worker threads.
+
+        Args:
+          model: The model to simulate.
+          num_threads: Number of threads, zero selects the number of hardware threads.
+          grain_size: Number of rollouts integrated per scheduled chunk.
+        """
+    @property
+    def num_threads(self) -> int:
+        """
+        Number of threads used for integration.
+
+        :type: int
+        """
+    def run(self, q0: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq0: numpy.ndarray[numpy.float64, _Shape[N, 7]], tau: numpy.ndarray[numpy.float64, _Shape[N, steps, 7]], dt: float, integrator: Integrator = Integrator.kRungeKutta4, I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ..., gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> typing.Tuple[numpy.ndarray[numpy.float64, _Shape[N, steps + 1, 7]], numpy.ndarray[numpy.float64, _Shape[N, steps + 1, 7]]]:
+        """
+        Integrates rollouts driven by the given torque sequences. The torques
+        are held constant during each step.
+
+        Args:
+          q0: Initial joint positions of shape (N,7).
+          dq0: Initial joint velocities of shape (N,7).
+          tau: Joint torques of shape (N,steps,7). Unit: :math:`[Nm]`.
+          dt: Step size. Unit: :math:`[s]`.
+          integrator: Integration scheme.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Tuple of joint position and velocity trajectories, each of shape
+          (N,steps+1,7) and starting with the initial state.
+        """
+    def run_policy(self, q0: numpy.ndarray[numpy.float64, _Shape[N, 7]], dq0: numpy.ndarray[numpy.float64, _Shape[N, 7]], policy: typing.Callable[[int, int, numpy.ndarray, numpy.ndarray], numpy.ndarray], steps: int, dt: float, integrator: Integrator = Integrator.kRungeKutta4, I_total: numpy.ndarray[numpy.float64, _Shape[3, 3]] = ..., m_total: float = 0.73, F_x_Ctotal: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ..., gravity_earth: numpy.ndarray[numpy.float64, _Shape[3, 1]] = ...) -> typing.Tuple[numpy.ndarray[numpy.float64, _Shape[N, steps + 1, 7]], numpy.ndarray[numpy.float64, _Shape[N, steps + 1, 7]], numpy.ndarray[numpy.float64, _Shape[N, steps, 7]]]:
+        """
+        Integrates rollouts driven by the given policy, which is called once
+        at the beginning of every step. The GIL is released for the rollout
+        and only acquired while the policy runs.
+
+        Args:
+          q0: Initial joint positions of shape (N,7).
+          dq0: Initial joint velocities of shape (N,7).
+          policy: Called as `policy(rollout, step, q, dq)` and returns the
+            7 joint torques of the step. Unit: :math:`[Nm]`.
+          steps: Number of integration steps per rollout.
+          dt: Step size. Unit: :math:`[s]`.
+          integrator: Integration scheme.
+          I_total: Inertia of the attached total load including end effector, relative to
+            center of mass, given as vectorized 3x3 column-major matrix. Unit: :math:`[kg \times m^2]`.
+          m_total: Weight of the attached total load including end effector.
+            Unit: :math:`[kg]`.
+          F_x_Ctotal: Translation from flange to center of mass of the attached total load.
+            Unit: :math:`[m]`.
+          gravity_earth: Earth's gravity vector. Unit: :math:`\frac{m}{s^2}`.
+
+        Returns:
+          Tuple of joint position and velocity trajectories, each of shape
+          (N,steps+1,7) and starting with the initial state, and the applied
+          joint torques of shape (N,steps,7).
+        """
+    pass
+class SelfCollision():
+    """
+    Calculates the minimum distance between pairs of link capsules for batches of joint positions in parallel.
+    """
+    def __init__(self, model: Model, capsules: typing.List[Capsule] = ..., pairs: typing.List[typing.Tuple[int, int]] = ..., num_threads: int = 0, grain_size: int = 16) -> None:
+        """
+        Create a self-collision checker and start its worker threads.
+
+        Args:
+          model: The model to calculate the frame poses with.
+          capsules: Capsules attached to the frames.
+          pairs: Pairs of indices into capsules whose distances are checked.
+          num_threads: Number of threads, zero selects the number of hardware threads.
+          grain_size: Number of joint positions evaluated per scheduled chunk.
+        """
+    @staticmethod
+    def default_capsules() -> typing.List[Capsule]:
+        """
+        Capsules that cover the links of the robot and the default hand.
+        """
+    @staticmethod
+    def default_pairs() -> typing.List[typing.Tuple[int, int]]:
+        """
+        Pairs of the default capsules whose frames are at least three joints apart.
+        """
+    @property
+    def num_threads(self) -> int:
+        """
+        Number of threads used for distance queries.
+
+        :type: int
+        """
+    @property
+    def capsules(self) -> typing.List[Capsule]:
+        """
+        Capsules attached to the frames.
+
+        :type: typing.List[Capsule]
+        """
+    @property
+    def pairs(self) -> typing.List[typing.Tuple[int, int]]:
+        """
+        Pairs of capsules whose distances are checked.
+
+        :type: typing.List[typing.Tuple[int, int]]
+        """
+    def distance(self, q: numpy.ndarray[numpy.float64, _Shape[7, 1]], F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> typing.Tuple[float, int, numpy.ndarray[numpy.float64, _Shape[7, 1]]]:
+        """
+        Calculates the minimum distance over all pairs, negative if capsules
+        penetrate.
+
+        Args:
+          q: Joint position.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Tuple of the minimum distance, the index of the closest pair and
+          the gradient of the distance with respect to the joint position.
+        """
+    def distance_batch(self, q: numpy.ndarray[numpy.float64, _Shape[N, 7]], gradients: bool = False, F_T_EE: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ..., EE_T_K: numpy.ndarray[numpy.float64, _Shape[4, 4]] = ...) -> typing.Tuple[numpy.ndarray[numpy.float64, _Shape[N]], numpy.ndarray[numpy.uint64, _Shape[N]], typing.Optional[numpy.ndarray[numpy.float64, _Shape[N, 7]]]]:
+        """
+        Calculates the minimum distance over all pairs for a batch of joint
+        positions, see `distance`.
+
+        Args:
+          q: Joint positions of shape (N,7).
+          gradients: Whether to calculate the gradients of the distances.
+          F_T_EE: End effector in flange frame.
+          EE_T_K: Stiffness frame K in the end effector frame.
+
+        Returns:
+          Tuple of the minimum distances of shape (N,), the indices of the
+          closest pairs of shape (N,) and the gradients of shape (N,7), or
+          None if not requested.
+        """
+    pass
+class ThreadPool():
+    """
+    Fixed set of worker threads that cooperatively process index ranges, stealing chunks from each other when they run out of work.
+    """
+    def __init__(self, num_threads: int = 0) -> None:
+        """
+        Start the worker threads.
+
+        Args:
+          num_threads: Number of threads including the calling thread, zero selects
+            the number of hardware threads.
+        """
+    def parallel_for(self, n: int, grain_size: int, function: typing.Callable[[int, int], None]) -> None:
+        """
+        Calls the given function for consecutive chunks covering the range
+        [0, n) and blocks until all chunks have been processed. The GIL is
+        released while waiting and only acquired while the function runs.
+        Must not be called from within the given function.
+
+        Args:
+          n: Size of the range.
+          grain_size: Maximum number of elements per chunk.
+          function: Called as `function(begin, end)` for each chunk.
+
+        Raises:
+          The first exception raised by the given function.
+        """
+    @property
+    def size(self) -> int:
+        """
+        Number of threads processing work, including the calling thread.
+
+        :type: int
+        """
+    pass
+def best_instruction_set() -> InstructionSet:
+    """
+    Gets the widest instruction set the vectorized pose kernel uses on this
+    processor. The kernel evaluates `Model.pose_batch` of a native `Model`.
+    """
+def download_library(hostname: str, path: str = '', architecture: Architecture = Architecture.x64, operating_system: OperatingSystem = OperatingSystem.linux, version: int = 5) -> str:
+    """
+    Download model library from a connected control unit.
+
+    Args:
+      hostname: Hostname or IP address of the master control unit.
+      path: The path the shared library is downloaded to.
+      architecture: Download the shared library built for the given
+        processor architecture.
+      operating_system: Download the shared library built for the given
+        operating system.
+      version: FCI version running on the targeted master control unit.
+
+    Returns:
+      Path pointing to the downloaded library.
+    """
+def is_supported(instruction_set: InstructionSet) -> bool:
+    """
+    Checks whether the vectorized pose kernel can use the given instruction
+    set on this processor.
     """
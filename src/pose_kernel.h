@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+
+#include "pandamodel/kinematic_parameters.h"
+
+// Forward kinematics kernel shared by the instruction set specific translation units.
+//
+// Pack is either double or a GCC/Clang vector extension type of doubles. The kernel only uses
+// arithmetic operators, so each translation unit compiles it for the instruction set it is
+// built with. It deliberately calls no standard library templates: their instantiations would
+// be merged across translation units built with different instruction sets. For the same reason
+// Eigen must not be included here.
+
+namespace panda_model {
+namespace kinematics {
+namespace detail {
+
+// Evaluates the poses of one frame for n joint positions. The first `links` link transforms
+// are chained. If F_T_X is not null, the result is additionally multiplied by it.
+using PoseKernel = void (*)(std::size_t links,
+                            const double* q,
+                            std::size_t n,
+                            const double* F_T_X,
+                            double* output);
+
+// Kernels for the vector instruction sets, null if not built for the target architecture.
+PoseKernel avx2PoseKernel() noexcept;
+PoseKernel avx512PoseKernel() noexcept;
+
+template <typename Pack>
+constexpr std::size_t kPackWidth = sizeof(Pack) / sizeof(double);
+
+template <typename Pack>
+inline double getLane(const Pack& pack, std::size_t index) noexcept {
+  return pack[index];
+}
+
+template <>
+inline double getLane(const double& pack, std::size_t /* index */) noexcept {
+  return pack;
+}
+
+template <typename Pack>
+inline void setLane(Pack& pack, std::size_t index, double value) noexcept {
+  pack[index] = value;
+}
+
+template <>
+inline void setLane(double& pack, std::size_t /* index */, double value) noexcept {
+  pack = value;
+}
+
+// Rounds to the nearest integer, valid for magnitudes below 2^51.
+template <typename Pack>
+inline Pack round(Pack x) noexcept {
+  constexpr double kShift = 6755399441055744.0;  // 1.5 * 2^52
+  return (x + kShift) - kShift;
+}
+
+// Branch-free sine and cosine. Reduces the argument to [-pi/4, pi/4] and evaluates the fdlibm
+// kernel polynomials, then selects and negates the results by quadrant arithmetically.
+template <typename Pack>
+inline void sincos(Pack x, Pack& sine, Pack& cosine) noexcept {
+  constexpr double k2OverPi = 6.36619772367581382433e-01;
+  constexpr double kPiOver2High = 1.57079632673412561417e+00;
+  constexpr double kPiOver2Low = 6.07710050650619224932e-11;
+  const Pack k = round<Pack>(x * k2OverPi);
+  const Pack r = (x - k * kPiOver2High) - k * kPiOver2Low;
+  const Pack z = r * r;
+
+  const Pack s =
+      r + r * z *
+              (-1.66666666666666324348e-01 +
+               z * (8.33333333332248946124e-03 +
+                    z * (-1.98412698298579493134e-04 +
+                         z * (2.75573137070700676789e-06 +
+                              z * (-2.50507602534068634195e-08 +
+                                   z * 1.58969099521155010221e-10)))));
+  const Pack c =
+      1.0 - 0.5 * z +
+      z * z *
+          (4.16666666666666019037e-02 +
+           z * (-1.38888888888741095749e-03 +
+                z * (2.48015872894767294178e-05 +
+                     z * (-2.75573143513906633035e-07 +
+                          z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+
+  // quadrant in {0, 1, 2, 3}, odd and half are 0 or 1.
+  const Pack quadrant = k - 4.0 * round<Pack>(k * 0.25 - 0.375);
+  const Pack half = round<Pack>(quadrant * 0.5 - 0.25);
+  const Pack odd = quadrant - 2.0 * half;
+  const Pack negative_cosine = odd + half - 2.0 * odd * half;
+  sine = (s + odd * (c - s)) * (1.0 - 2.0 * half);
+  cosine = (c + odd * (s - c)) * (1.0 - 2.0 * negative_cosine);
+}
+
+template <typename Pack>
+struct PackPose {
+  // Rotation, column-major.
+  Pack R[9];
+  Pack p[3];
+};
+
+template <typename Pack>
+inline void chainLinks(std::size_t links, const Pack* q, PackPose<Pack>& pose) noexcept {
+  Pack* R = pose.R;
+  Pack* p = pose.p;
+  for (std::size_t i = 0; i < 9; i++) {
+    R[i] = Pack{} + (i % 4 == 0 ? 1.0 : 0.0);
+  }
+  p[0] = p[1] = p[2] = Pack{};
+
+  for (std::size_t link = 0; link < links; link++) {
+    const LinkParameters& parameters = kLinks[link];
+    if (parameters.a != 0.) {
+      for (std::size_t row = 0; row < 3; row++) {
+        p[row] = p[row] + parameters.a * R[row];
+      }
+    }
+    // The twist is a multiple of pi/2, so it only swaps and negates columns 1 and 2.
+    if (parameters.sin_alpha != 0.) {
+      for (std::size_t row = 0; row < 3; row++) {
+        const Pack y = R[3 + row];
+        const Pack z = R[6 + row];
+        R[3 + row] = parameters.sin_alpha * z;
+        R[6 + row] = -parameters.sin_alpha * y;
+      }
+    }
+    if (link < 7) {
+      Pack sine, cosine;
+      sincos<Pack>(q[link], sine, cosine);
+      for (std::size_t row = 0; row < 3; row++) {
+        const Pack x = R[row];
+        const Pack y = R[3 + row];
+        R[row] = cosine * x + sine * y;
+        R[3 + row] = cosine * y - sine * x;
+      }
+    }
+    if (parameters.d != 0.) {
+      for (std::size_t row = 0; row < 3; row++) {
+        p[row] = p[row] + parameters.d * R[6 + row];
+      }
+    }
+  }
+}
+
+template <typename Pack>
+inline void transform(PackPose<Pack>& pose, const double* F_T_X) noexcept {
+  Pack R[9];
+  for (std::size_t column = 0; column < 3; column++) {
+    for (std::size_t row = 0; row < 3; row++) {
+      R[3 * column + row] = pose.R[row] * F_T_X[4 * column] +
+                            pose.R[3 + row] * F_T_X[4 * column + 1] +
+                            pose.R[6 + row] * F_T_X[4 * column + 2];
+    }
+  }
+  for (std::size_t row = 0; row < 3; row++) {
+    pose.p[row] = pose.p[row] + pose.R[row] * F_T_X[12] + pose.R[3 + row] * F_T_X[13] +
+                  pose.R[6 + row] * F_T_X[14];
+  }
+  for (std::size_t i = 0; i < 9; i++) {
+    pose.R[i] = R[i];
+  }
+}
+
+template <typename Pack>
+void poseKernel(std::size_t links,
+                const double* q,
+                std::size_t n,
+                const double* F_T_X,
+                double* output) {
+  constexpr std::size_t kWidth = kPackWidth<Pack>;
+  for (std::size_t begin = 0; begin < n; begin += kWidth) {
+    const std::size_t count = n - begin < kWidth ? n - begin : kWidth;
+
+    // Transpose into structure of arrays, repeating the last position in unused lanes.
+    Pack q_block[7] = {};
+    for (std::size_t index = 0; index < kWidth; index++) {
+      const double* q_row = q + 7 * (begin + (index < count ? index : count - 1));
+      for (std::size_t joint = 0; joint < 7; joint++) {
+        setLane(q_block[joint], index, q_row[joint]);
+      }
+    }
+
+    PackPose<Pack> pose;
+    chainLinks<Pack>(links, q_block, pose);
+    if (F_T_X != nullptr) {
+      transform<Pack>(pose, F_T_X);
+    }
+
+    for (std::size_t index = 0; index < count; index++) {
+      double* O_T_F = output + 16 * (begin + index);
+      for (std::size_t column = 0; column < 3; column++) {
+        for (std::size_t row = 0; row < 3; row++) {
+          O_T_F[4 * column + row] = getLane(pose.R[3 * column + row], index);
+        }
+        O_T_F[4 * column + 3] = 0.;
+      }
+      for (std::size_t row = 0; row < 3; row++) {
+        O_T_F[12 + row] = getLane(pose.p[row], index);
+      }
+      O_T_F[15] = 1.;
+    }
+  }
+}
+
+}  // namespace detail
+}  // namespace kinematics
+}  // namespace panda_model
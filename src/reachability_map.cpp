@@ -0,0 +1,312 @@
+#include "pandamodel/reachability_map.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <Eigen/Eigenvalues>
+
+#include "pandamodel/thread_pool.h"
+
+using namespace std::string_literals;  // NOLINT(google-build-using-namespace)
+
+namespace panda_model {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'M', 'R', 'E', 'A', 'C', 'H', '\0'};
+constexpr std::uint32_t kVersion = 1;
+
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t frame;
+  std::uint64_t samples;
+  std::uint64_t shape[3];
+  double lower[3];
+  double resolution;
+};
+
+/**
+ * Statistics of one voxel while sampling.
+ */
+struct Accumulator {
+  std::atomic<std::uint32_t> count{0};
+  std::atomic<double> manipulability_sum{0.};
+  std::atomic<double> manipulability_max{0.};
+  std::atomic<double> condition_min{std::numeric_limits<double>::infinity()};
+};
+
+void atomicAdd(std::atomic<double>& target, double value) {
+  double current = target.load(std::memory_order_relaxed);
+  while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+  }
+}
+
+/**
+ * Replaces the target with the given value as long as the value compares before it.
+ */
+template <typename Compare>
+void atomicReplace(std::atomic<double>& target, double value, Compare compare) {
+  double current = target.load(std::memory_order_relaxed);
+  while (compare(value, current) &&
+         !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+std::size_t voxelCount(const std::array<std::size_t, 3>& shape) {
+  return shape[0] * shape[1] * shape[2];
+}
+
+}  // anonymous namespace
+
+ReachabilityMap::ReachabilityMap(Frame frame,
+                                 const Eigen::Vector3d& lower,
+                                 double resolution,
+                                 const std::array<std::size_t, 3>& shape,
+                                 std::uint64_t samples)
+    : frame_(frame),
+      lower_(lower),
+      resolution_(resolution),
+      shape_(shape),
+      samples_(samples),
+      counts_(voxelCount(shape)),
+      mean_manipulability_(voxelCount(shape)),
+      max_manipulability_(voxelCount(shape)),
+      min_condition_(voxelCount(shape)) {}
+
+ReachabilityMap ReachabilityMap::generate(const Model& model,
+                                          const ReachabilityOptions& options,
+                                          std::size_t num_threads,
+                                          std::size_t grain_size,
+                                          const Eigen::Matrix4d& F_T_EE,
+                                          const Eigen::Matrix4d& EE_T_K) {
+  if (static_cast<std::size_t>(options.frame) >= kFrameCount) {
+    throw std::invalid_argument("Invalid frame given.");
+  }
+  // Limits the grid to 2^32 voxels, which also keeps the shape from overflowing.
+  constexpr double kMaxVoxels = 4294967296.;
+  std::array<std::size_t, 3> shape;
+  double voxels = 1.;
+  for (Eigen::Index axis = 0; axis < 3; axis++) {
+    const double extent = std::ceil((options.upper[axis] - options.lower[axis]) /
+                                    options.resolution);
+    if (!(options.resolution > 0.) || !(extent >= 1.) || !(extent <= kMaxVoxels)) {
+      throw std::invalid_argument("Invalid grid given.");
+    }
+    shape[axis] = static_cast<std::size_t>(extent);
+    voxels *= extent;
+  }
+  if (voxels > kMaxVoxels) {
+    throw std::invalid_argument("Invalid grid given.");
+  }
+  // No voxel can be hit more often than there are samples.
+  if (options.samples > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument("Invalid number of samples given.");
+  }
+
+  ReachabilityMap map(options.frame, options.lower, options.resolution, shape, options.samples);
+  std::vector<Accumulator> accumulators(map.size());
+  ThreadPool pool(num_threads);
+  pool.parallelFor(
+      static_cast<std::size_t>(options.samples), grain_size,
+      [&](std::size_t begin, std::size_t end) {
+        std::seed_seq seed{static_cast<std::uint32_t>(options.seed),
+                           static_cast<std::uint32_t>(options.seed >> 32),
+                           static_cast<std::uint32_t>(begin),
+                           static_cast<std::uint32_t>(static_cast<std::uint64_t>(begin) >> 32)};
+        std::mt19937_64 generator(seed);
+        std::uniform_real_distribution<double> distribution(0., 1.);
+        Eigen::Matrix<double, 7, 1> q;
+        Eigen::Matrix4d pose;
+        Eigen::Matrix<double, 6, 7> jacobian;
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, 6, 6>> solver;
+        for (std::size_t i = begin; i < end; i++) {
+          for (Eigen::Index joint = 0; joint < 7; joint++) {
+            q[joint] = options.q_min[joint] +
+                       distribution(generator) * (options.q_max[joint] - options.q_min[joint]);
+          }
+          model.pose(options.frame, q.data(), F_T_EE.data(), EE_T_K.data(), pose.data());
+          const std::size_t index = map.index(pose.topRightCorner<3, 1>());
+          if (index == map.size()) {
+            continue;
+          }
+          model.zeroJacobian(options.frame, q.data(), F_T_EE.data(), EE_T_K.data(),
+                             jacobian.data());
+          // The eigenvalues of J J^T are the squared singular values of J, in ascending order.
+          solver.compute(jacobian * jacobian.transpose(), Eigen::EigenvaluesOnly);
+          const Eigen::Matrix<double, 6, 1> eigenvalues = solver.eigenvalues().cwiseMax(0.);
+          const double manipulability = std::sqrt(eigenvalues.prod());
+          const double condition = eigenvalues[0] > 0.
+                                       ? std::sqrt(eigenvalues[5] / eigenvalues[0])
+                                       : std::numeric_limits<double>::infinity();
+
+          Accumulator& accumulator = accumulators[index];
+          accumulator.count.fetch_add(1, std::memory_order_relaxed);
+          atomicAdd(accumulator.manipulability_sum, manipulability);
+          atomicReplace(accumulator.manipulability_max, manipulability, std::greater<double>());
+          atomicReplace(accumulator.condition_min, condition, std::less<double>());
+        }
+      });
+
+  for (std::size_t index = 0; index < map.size(); index++) {
+    const Accumulator& accumulator = accumulators[index];
+    const std::uint32_t count = accumulator.count.load(std::memory_order_relaxed);
+    map.counts_[index] = count;
+    map.mean_manipulability_[index] =
+        count > 0 ? static_cast<float>(accumulator.manipulability_sum / count) : 0.f;
+    map.max_manipulability_[index] = static_cast<float>(accumulator.manipulability_max);
+    map.min_condition_[index] = static_cast<float>(accumulator.condition_min);
+  }
+  return map;
+}
+
+ReachabilityMap ReachabilityMap::load(const std::string& path) {
+  std::ifstream stream(path, std::ios_base::in | std::ios_base::binary);
+  if (!stream) {
+    throw std::runtime_error("Cannot read reachability map: "s + path);
+  }
+  Header header;
+  if (!stream.read(reinterpret_cast<char*>(&header), sizeof(Header))) {
+    throw std::runtime_error("Invalid reachability map: file is truncated.");
+  }
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+    throw std::runtime_error("Invalid reachability map: unknown format.");
+  }
+  if (header.frame >= kFrameCount) {
+    throw std::runtime_error("Invalid reachability map: invalid frame.");
+  }
+  if (!(header.resolution > 0.)) {
+    throw std::runtime_error("Invalid reachability map: invalid resolution.");
+  }
+  // Bounds the shape by the file size before allocating, every voxel takes 16 bytes.
+  stream.seekg(0, std::ios_base::end);
+  const std::uint64_t available = static_cast<std::uint64_t>(stream.tellg()) - sizeof(Header);
+  stream.seekg(sizeof(Header));
+  std::uint64_t voxels = 1;
+  for (std::uint64_t extent : header.shape) {
+    if (extent == 0 || extent > available / 16 / voxels) {
+      throw std::runtime_error("Invalid reachability map: file is truncated.");
+    }
+    voxels *= extent;
+  }
+
+  ReachabilityMap map(
+      static_cast<Frame>(header.frame),
+      Eigen::Vector3d(header.lower[0], header.lower[1], header.lower[2]), header.resolution,
+      {static_cast<std::size_t>(header.shape[0]), static_cast<std::size_t>(header.shape[1]),
+       static_cast<std::size_t>(header.shape[2])},
+      header.samples);
+  stream.read(reinterpret_cast<char*>(map.counts_.data()),
+              static_cast<std::streamsize>(sizeof(std::uint32_t) * map.size()));
+  for (std::vector<float>* values :
+       {&map.mean_manipulability_, &map.max_manipulability_, &map.min_condition_}) {
+    stream.read(reinterpret_cast<char*>(values->data()),
+                static_cast<std::streamsize>(sizeof(float) * map.size()));
+  }
+  if (!stream) {
+    throw std::runtime_error("Invalid reachability map: file is truncated.");
+  }
+  return map;
+}
+
+void ReachabilityMap::save(const std::string& path) const {
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.frame = static_cast<std::uint32_t>(frame_);
+  header.samples = samples_;
+  for (std::size_t axis = 0; axis < 3; axis++) {
+    header.shape[axis] = shape_[axis];
+    header.lower[axis] = lower_[static_cast<Eigen::Index>(axis)];
+  }
+  header.resolution = resolution_;
+
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  stream.write(reinterpret_cast<const char*>(counts_.data()),
+               static_cast<std::streamsize>(sizeof(std::uint32_t) * size()));
+  for (const std::vector<float>* values :
+       {&mean_manipulability_, &max_manipulability_, &min_condition_}) {
+    stream.write(reinterpret_cast<const char*>(values->data()),
+                 static_cast<std::streamsize>(sizeof(float) * size()));
+  }
+  if (!stream) {
+    throw std::runtime_error("Cannot write reachability map: "s + path);
+  }
+}
+
+Frame ReachabilityMap::frame() const noexcept {
+  return frame_;
+}
+
+const Eigen::Vector3d& ReachabilityMap::lower() const noexcept {
+  return lower_;
+}
+
+double ReachabilityMap::resolution() const noexcept {
+  return resolution_;
+}
+
+const std::array<std::size_t, 3>& ReachabilityMap::shape() const noexcept {
+  return shape_;
+}
+
+std::size_t ReachabilityMap::size() const noexcept {
+  return counts_.size();
+}
+
+std::uint64_t ReachabilityMap::samples() const noexcept {
+  return samples_;
+}
+
+std::size_t ReachabilityMap::index(const Eigen::Vector3d& position) const noexcept {
+  std::size_t index = 0;
+  for (std::size_t axis = 0; axis < 3; axis++) {
+    const double cell =
+        std::floor((position[static_cast<Eigen::Index>(axis)] -
+                    lower_[static_cast<Eigen::Index>(axis)]) /
+                   resolution_);
+    // Also rejects NaN positions.
+    if (!(cell >= 0.) || !(cell < static_cast<double>(shape_[axis]))) {
+      return size();
+    }
+    index = index * shape_[axis] + static_cast<std::size_t>(cell);
+  }
+  return index;
+}
+
+Eigen::Vector3d ReachabilityMap::center(std::size_t index) const noexcept {
+  Eigen::Vector3d center;
+  for (std::size_t axis = 3; axis-- > 0;) {
+    center[static_cast<Eigen::Index>(axis)] =
+        lower_[static_cast<Eigen::Index>(axis)] +
+        (static_cast<double>(index % shape_[axis]) + 0.5) * resolution_;
+    index /= shape_[axis];
+  }
+  return center;
+}
+
+const std::vector<std::uint32_t>& ReachabilityMap::counts() const noexcept {
+  return counts_;
+}
+
+const std::vector<float>& ReachabilityMap::meanManipulability() const noexcept {
+  return mean_manipulability_;
+}
+
+const std::vector<float>& ReachabilityMap::maxManipulability() const noexcept {
+  return max_manipulability_;
+}
+
+const std::vector<float>& ReachabilityMap::minCondition() const noexcept {
+  return min_condition_;
+}
+
+}  // namespace panda_model
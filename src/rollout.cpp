@@ -0,0 +1,113 @@
+#include "pandamodel/rollout.h"
+
+#include <algorithm>
+
+#include "equations_of_motion.h"
+
+namespace panda_model {
+
+namespace {
+
+using Vector7d = Eigen::Matrix<double, 7, 1>;
+
+using detail::Dynamics;
+
+/**
+ * Advances the joint position and velocity by one step of the given integration scheme.
+ */
+void integrate(const Dynamics& dynamics,
+               Integrator integrator,
+               double dt,
+               const Vector7d& tau,
+               Vector7d& q,
+               Vector7d& dq) {
+  if (integrator == Integrator::kSemiImplicitEuler) {
+    dq += dt * dynamics.acceleration(q, dq, tau);
+    q += dt * dq;
+    return;
+  }
+  const Vector7d k1_q = dq;
+  const Vector7d k1_dq = dynamics.acceleration(q, dq, tau);
+  const Vector7d k2_q = dq + 0.5 * dt * k1_dq;
+  const Vector7d k2_dq = dynamics.acceleration(q + 0.5 * dt * k1_q, k2_q, tau);
+  const Vector7d k3_q = dq + 0.5 * dt * k2_dq;
+  const Vector7d k3_dq = dynamics.acceleration(q + 0.5 * dt * k2_q, k3_q, tau);
+  const Vector7d k4_q = dq + dt * k3_dq;
+  const Vector7d k4_dq = dynamics.acceleration(q + dt * k3_q, k4_q, tau);
+  q += dt / 6. * (k1_q + 2. * k2_q + 2. * k3_q + k4_q);
+  dq += dt / 6. * (k1_dq + 2. * k2_dq + 2. * k3_dq + k4_dq);
+}
+
+}  // anonymous namespace
+
+Rollout::Rollout(const Model& model, std::size_t num_threads, std::size_t grain_size)
+    : model_(model), pool_(num_threads), grain_size_(grain_size) {}
+
+std::size_t Rollout::numThreads() const noexcept {
+  return pool_.size();
+}
+
+void Rollout::run(const double* q0,
+                  const double* dq0,
+                  const double* tau,
+                  std::size_t n,
+                  std::size_t steps,
+                  double dt,
+                  double* q,
+                  double* dq,
+                  Integrator integrator,
+                  const Eigen::Matrix3d& I_total,
+                  double m_total,
+                  const Eigen::Vector3d& F_x_Ctotal,
+                  const Eigen::Vector3d& gravity_earth) {
+  run(
+      q0, dq0,
+      [tau, steps](std::size_t rollout, std::size_t step, const double*, const double*,
+                   double* output) {
+        const double* input = tau + 7 * (steps * rollout + step);
+        std::copy(input, input + 7, output);
+      },
+      n, steps, dt, q, dq, nullptr, integrator, I_total, m_total, F_x_Ctotal, gravity_earth);
+}
+
+void Rollout::run(const double* q0,
+                  const double* dq0,
+                  const Policy& policy,
+                  std::size_t n,
+                  std::size_t steps,
+                  double dt,
+                  double* q,
+                  double* dq,
+                  double* tau,
+                  Integrator integrator,
+                  const Eigen::Matrix3d& I_total,
+                  double m_total,
+                  const Eigen::Vector3d& F_x_Ctotal,
+                  const Eigen::Vector3d& gravity_earth) {
+  const Dynamics dynamics{model_, I_total, m_total, F_x_Ctotal, gravity_earth};
+  const std::size_t length = 7 * (steps + 1);
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t rollout = begin; rollout < end; rollout++) {
+      Eigen::Map<Eigen::Matrix<double, 7, Eigen::Dynamic>> q_trajectory(q + length * rollout, 7,
+                                                                         steps + 1);
+      Eigen::Map<Eigen::Matrix<double, 7, Eigen::Dynamic>> dq_trajectory(
+          dq + length * rollout, 7, steps + 1);
+      Vector7d position = Eigen::Map<const Vector7d>(q0 + 7 * rollout);
+      Vector7d velocity = Eigen::Map<const Vector7d>(dq0 + 7 * rollout);
+      q_trajectory.col(0) = position;
+      dq_trajectory.col(0) = velocity;
+      Vector7d torque;
+      for (std::size_t step = 0; step < steps; step++) {
+        policy(rollout, step, position.data(), velocity.data(), torque.data());
+        if (tau != nullptr) {
+          Eigen::Map<Vector7d>(tau + 7 * (steps * rollout + step)) = torque;
+        }
+        integrate(dynamics, integrator, dt, torque, position, velocity);
+        q_trajectory.col(step + 1) = position;
+        dq_trajectory.col(step + 1) = velocity;
+      }
+    }
+  });
+}
+
+}  // namespace panda_model
@@ -0,0 +1,213 @@
+#include "pandamodel/self_collision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <Eigen/Geometry>
+
+namespace panda_model {
+
+namespace {
+
+using Vector7d = Eigen::Matrix<double, 7, 1>;
+
+/**
+ * Finds the closest points of the segments [p1, q1] and [p2, q2].
+ */
+void closestPoints(const Eigen::Vector3d& p1,
+                   const Eigen::Vector3d& q1,
+                   const Eigen::Vector3d& p2,
+                   const Eigen::Vector3d& q2,
+                   Eigen::Vector3d& c1,
+                   Eigen::Vector3d& c2) {
+  constexpr double kEpsilon = 1e-12;
+  const Eigen::Vector3d d1 = q1 - p1;
+  const Eigen::Vector3d d2 = q2 - p2;
+  const Eigen::Vector3d r = p1 - p2;
+  const double a = d1.squaredNorm();
+  const double e = d2.squaredNorm();
+  const double f = d2.dot(r);
+  double s = 0.;
+  double t = 0.;
+  if (a <= kEpsilon && e > kEpsilon) {
+    t = std::clamp(f / e, 0., 1.);
+  } else if (a > kEpsilon) {
+    const double c = d1.dot(r);
+    if (e <= kEpsilon) {
+      s = std::clamp(-c / a, 0., 1.);
+    } else {
+      // Closest points of the infinite lines, clamped to the first segment, then to the second.
+      const double b = d1.dot(d2);
+      const double denominator = a * e - b * b;
+      s = denominator > kEpsilon ? std::clamp((b * f - c * e) / denominator, 0., 1.) : 0.;
+      t = (b * s + f) / e;
+      if (t < 0.) {
+        t = 0.;
+        s = std::clamp(-c / a, 0., 1.);
+      } else if (t > 1.) {
+        t = 1.;
+        s = std::clamp((b - c) / a, 0., 1.);
+      }
+    }
+  }
+  c1 = p1 + s * d1;
+  c2 = p2 + t * d2;
+}
+
+/**
+ * Number of joints that move the given frame.
+ */
+Eigen::Index movingJoints(Frame frame) {
+  return std::min<Eigen::Index>(static_cast<Eigen::Index>(frame) + 1, 7);
+}
+
+/**
+ * Adds the direction times the translational zero Jacobian of a point attached to the given
+ * frame to the gradient.
+ */
+void addPointGradient(const double* poses,
+                      Frame frame,
+                      const Eigen::Vector3d& point,
+                      const Eigen::Vector3d& direction,
+                      Vector7d& gradient) {
+  for (Eigen::Index joint = 0; joint < movingJoints(frame); joint++) {
+    const Eigen::Map<const Eigen::Matrix4d> O_T_J(poses + 16 * joint);
+    const Eigen::Vector3d axis = O_T_J.block<3, 1>(0, 2);
+    const Eigen::Vector3d lever = point - O_T_J.block<3, 1>(0, 3);
+    gradient[joint] += direction.dot(axis.cross(lever));
+  }
+}
+
+}  // anonymous namespace
+
+std::vector<Capsule> SelfCollision::defaultCapsules() {
+  // The hand is rotated about the flange's z axis like Defaults::F_T_EE, its fingers open along
+  // the diagonal.
+  const Eigen::Vector3d hand_axis = 0.05 * Eigen::Vector3d(1., 1., 0.).normalized();
+  const Eigen::Vector3d hand_center(0., 0., 0.04);
+  return {
+      {Frame::kJoint1, {0., 0., -0.333}, {0., 0., -0.05}, 0.06},
+      {Frame::kJoint2, {0., 0., -0.06}, {0., 0., 0.06}, 0.06},
+      {Frame::kJoint3, {0., 0., -0.22}, {0., 0., -0.07}, 0.06},
+      {Frame::kJoint4, {0., 0., -0.06}, {0., 0., 0.06}, 0.06},
+      {Frame::kJoint5, {0., 0., -0.31}, {0., 0., -0.21}, 0.06},
+      {Frame::kJoint5, {0., 0.08, -0.2}, {0., 0.08, -0.06}, 0.025},
+      {Frame::kJoint6, {0., 0., -0.07}, {0., 0., 0.01}, 0.05},
+      {Frame::kJoint7, {0., 0., -0.06}, {0., 0., 0.08}, 0.04},
+      {Frame::kFlange, hand_center - hand_axis, hand_center + hand_axis, 0.04},
+  };
+}
+
+std::vector<CapsulePair> SelfCollision::defaultPairs() {
+  std::vector<CapsulePair> pairs;
+  const std::vector<Capsule> capsules = defaultCapsules();
+  for (std::size_t first = 0; first < capsules.size(); first++) {
+    for (std::size_t second = first + 1; second < capsules.size(); second++) {
+      if (static_cast<int>(capsules[second].frame) - static_cast<int>(capsules[first].frame) >=
+          3) {
+        pairs.emplace_back(first, second);
+      }
+    }
+  }
+  return pairs;
+}
+
+SelfCollision::SelfCollision(const Model& model,
+                             std::vector<Capsule> capsules,
+                             std::vector<CapsulePair> pairs,
+                             std::size_t num_threads,
+                             std::size_t grain_size)
+    : model_(model),
+      capsules_(std::move(capsules)),
+      pairs_(std::move(pairs)),
+      pool_(num_threads),
+      grain_size_(grain_size) {
+  for (const Capsule& capsule : capsules_) {
+    if (static_cast<std::size_t>(capsule.frame) >= kFrameCount) {
+      throw std::invalid_argument("Invalid frame given.");
+    }
+  }
+  for (const CapsulePair& pair : pairs_) {
+    if (pair.first >= capsules_.size() || pair.second >= capsules_.size()) {
+      throw std::invalid_argument("Invalid capsule index given.");
+    }
+  }
+}
+
+std::size_t SelfCollision::numThreads() const noexcept {
+  return pool_.size();
+}
+
+const std::vector<Capsule>& SelfCollision::capsules() const noexcept {
+  return capsules_;
+}
+
+const std::vector<CapsulePair>& SelfCollision::pairs() const noexcept {
+  return pairs_;
+}
+
+void SelfCollision::distance(const double* q,
+                             std::size_t n,
+                             double* distances,
+                             double* gradients,
+                             std::size_t* closest,
+                             const Eigen::Matrix4d& F_T_EE,
+                             const Eigen::Matrix4d& EE_T_K) {
+  pool_.parallelFor(n, grain_size_, [&](std::size_t begin, std::size_t end) {
+    double poses[16 * kFrameCount];
+    std::vector<Eigen::Vector3d> a(capsules_.size()), b(capsules_.size());
+    for (std::size_t i = begin; i < end; i++) {
+      model_.poses(q + 7 * i, F_T_EE.data(), EE_T_K.data(), poses);
+      for (std::size_t index = 0; index < capsules_.size(); index++) {
+        const Capsule& capsule = capsules_[index];
+        const Eigen::Map<const Eigen::Matrix4d> O_T_F(
+            poses + 16 * static_cast<std::size_t>(capsule.frame));
+        a[index] = O_T_F.topLeftCorner<3, 3>() * capsule.a + O_T_F.topRightCorner<3, 1>();
+        b[index] = O_T_F.topLeftCorner<3, 3>() * capsule.b + O_T_F.topRightCorner<3, 1>();
+      }
+
+      double minimum = std::numeric_limits<double>::infinity();
+      std::size_t minimum_pair = pairs_.size();
+      Eigen::Vector3d minimum_first, minimum_second;
+      for (std::size_t pair = 0; pair < pairs_.size(); pair++) {
+        const std::size_t first = pairs_[pair].first;
+        const std::size_t second = pairs_[pair].second;
+        Eigen::Vector3d c1, c2;
+        closestPoints(a[first], b[first], a[second], b[second], c1, c2);
+        const double distance =
+            (c1 - c2).norm() - capsules_[first].radius - capsules_[second].radius;
+        if (distance < minimum) {
+          minimum = distance;
+          minimum_pair = pair;
+          minimum_first = c1;
+          minimum_second = c2;
+        }
+      }
+      distances[i] = minimum;
+      if (closest != nullptr) {
+        closest[i] = minimum_pair;
+      }
+      if (gradients != nullptr) {
+        Eigen::Map<Vector7d> gradient(gradients + 7 * i);
+        gradient.setZero();
+        const Eigen::Vector3d difference = minimum_first - minimum_second;
+        const double norm = difference.norm();
+        // The direction is undefined for intersecting segments and there is no pair without
+        // pairs, so the gradient stays zero.
+        if (minimum_pair < pairs_.size() && norm > 0.) {
+          const Eigen::Vector3d direction = difference / norm;
+          Vector7d point_gradient = Vector7d::Zero();
+          addPointGradient(poses, capsules_[pairs_[minimum_pair].first].frame, minimum_first,
+                           direction, point_gradient);
+          addPointGradient(poses, capsules_[pairs_[minimum_pair].second].frame, minimum_second,
+                           -direction, point_gradient);
+          gradient = point_gradient;
+        }
+      }
+    }
+  });
+}
+
+}  // namespace panda_model
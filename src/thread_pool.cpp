@@ -0,0 +1,214 @@
+#include "pandamodel/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace panda_model {
+
+namespace {
+
+/**
+ * Range of chunk indices [begin, end) owned by one thread.
+ *
+ * Both bounds are packed into a single word so the owner (taking chunks from the front)
+ * and thieves (taking chunks from the back) can update the range with one compare-and-swap.
+ */
+struct alignas(64) ChunkQueue {
+  std::atomic<uint64_t> range{0};
+};
+
+constexpr uint64_t kMaxChunks = std::numeric_limits<uint32_t>::max();
+
+uint64_t pack(uint64_t begin, uint64_t end) {
+  return (begin << 32) | end;
+}
+
+bool pop(ChunkQueue& queue, uint64_t* chunk) {
+  uint64_t range = queue.range.load(std::memory_order_acquire);
+  while (true) {
+    uint64_t begin = range >> 32;
+    uint64_t end = range & kMaxChunks;
+    if (begin >= end) {
+      return false;
+    }
+    if (queue.range.compare_exchange_weak(range, pack(begin + 1, end),
+                                          std::memory_order_acq_rel)) {
+      *chunk = begin;
+      return true;
+    }
+  }
+}
+
+bool steal(ChunkQueue& queue, uint64_t* stolen_begin, uint64_t* stolen_end) {
+  uint64_t range = queue.range.load(std::memory_order_acquire);
+  while (true) {
+    uint64_t begin = range >> 32;
+    uint64_t end = range & kMaxChunks;
+    if (begin >= end) {
+      return false;
+    }
+    uint64_t half = (end - begin + 1) / 2;
+    if (queue.range.compare_exchange_weak(range, pack(begin, end - half),
+                                          std::memory_order_acq_rel)) {
+      *stolen_begin = end - half;
+      *stolen_end = end;
+      return true;
+    }
+  }
+}
+
+}  // anonymous namespace
+
+struct ThreadPool::Impl {
+  std::vector<std::thread> workers;
+  std::unique_ptr<ChunkQueue[]> queues;
+  std::size_t size;
+
+  std::mutex submit_mutex;
+  std::mutex mutex;
+  std::condition_variable start;
+  std::condition_variable done;
+  uint64_t generation = 0;
+  std::size_t running = 0;
+  bool stop = false;
+
+  const std::function<void(std::size_t, std::size_t)>* function = nullptr;
+  std::size_t n = 0;
+  std::size_t grain_size = 1;
+  std::atomic<bool> failed{false};
+  std::exception_ptr exception;
+
+  void work(std::size_t index) noexcept;
+  void run(std::size_t index) noexcept;
+};
+
+void ThreadPool::Impl::work(std::size_t index) noexcept {
+  try {
+    while (!failed.load(std::memory_order_relaxed)) {
+      uint64_t chunk;
+      if (pop(queues[index], &chunk)) {
+        std::size_t begin = chunk * grain_size;
+        (*function)(begin, std::min(n, begin + grain_size));
+        continue;
+      }
+      bool stolen = false;
+      for (std::size_t offset = 1; offset < size && !stolen; offset++) {
+        uint64_t begin, end;
+        if (steal(queues[(index + offset) % size], &begin, &end)) {
+          queues[index].range.store(pack(begin, end), std::memory_order_release);
+          stolen = true;
+        }
+      }
+      if (!stolen) {
+        return;
+      }
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!exception) {
+      exception = std::current_exception();
+    }
+    failed = true;
+  }
+}
+
+void ThreadPool::Impl::run(std::size_t index) noexcept {
+  uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      start.wait(lock, [&] { return stop || generation != seen; });
+      if (stop) {
+        return;
+      }
+      seen = generation;
+    }
+    work(index);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--running == 0) {
+        done.notify_one();
+      }
+    }
+  }
+}
+
+ThreadPool::ThreadPool(std::size_t num_threads) : impl_{new Impl} {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  impl_->size = num_threads;
+  impl_->queues.reset(new ChunkQueue[num_threads]);
+  impl_->workers.reserve(num_threads - 1);
+  for (std::size_t i = 1; i < num_threads; i++) {
+    impl_->workers.emplace_back(&Impl::run, impl_.get(), i);
+  }
+}
+
+ThreadPool::~ThreadPool() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->stop = true;
+  }
+  impl_->start.notify_all();
+  for (auto& worker : impl_->workers) {
+    worker.join();
+  }
+}
+
+std::size_t ThreadPool::size() const noexcept {
+  return impl_->size;
+}
+
+void ThreadPool::parallelFor(std::size_t n,
+                             std::size_t grain_size,
+                             const std::function<void(std::size_t, std::size_t)>& function) {
+  if (n == 0) {
+    return;
+  }
+  grain_size = std::max<std::size_t>(grain_size, 1);
+  if ((n - 1) / grain_size + 1 > kMaxChunks) {
+    grain_size = (n - 1) / kMaxChunks + 1;
+  }
+  std::size_t num_chunks = (n - 1) / grain_size + 1;
+  if (impl_->size == 1 || num_chunks == 1) {
+    for (std::size_t begin = 0; begin < n; begin += grain_size) {
+      function(begin, std::min(n, begin + grain_size));
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit_lock(impl_->submit_mutex);
+  for (std::size_t i = 0; i < impl_->size; i++) {
+    impl_->queues[i].range.store(pack(num_chunks * i / impl_->size,
+                                      num_chunks * (i + 1) / impl_->size),
+                                 std::memory_order_relaxed);
+  }
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->function = &function;
+    impl_->n = n;
+    impl_->grain_size = grain_size;
+    impl_->failed = false;
+    impl_->exception = nullptr;
+    impl_->running = impl_->workers.size();
+    impl_->generation++;
+  }
+  impl_->start.notify_all();
+  impl_->work(0);
+
+  std::unique_lock<std::mutex> lock(impl_->mutex);
+  impl_->done.wait(lock, [&] { return impl_->running == 0; });
+  if (impl_->exception) {
+    std::rethrow_exception(impl_->exception);
+  }
+}
+
+}  // namespace panda_model
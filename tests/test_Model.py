@@ -1,10 +1,18 @@
 import os
+import tempfile
+import threading
+import time
 import unittest
 
 import numpy as np
 import numpy.testing as nt
 
-from panda_model import Frame, Model
+from panda_model import (BoundModel, Capsule, Defaults, Difference, Frame,
+                         IKOptions, IKSeedIndex, IKStatus, InstructionSet,
+                         Integrator, InverseKinematics, Linearization,
+                         MassFactorization, Model, ModelBatch, ModelCache,
+                         ReachabilityMap, ReachabilityOptions, Rollout,
+                         SelfCollision, ThreadPool, is_supported)
 
 from .data import (BODY_JACOBIAN, CORIOLIS, DQ, GRAVITY, MASS, POSE,
                    ZERO_JACOBIAN, Q)
@@ -39,3 +47,645 @@ class TestModel(unittest.TestCase):
   def test_zero_jacobian(self):
     computed_zero_jacobian = self.model.zero_jacobian(Frame.kEndEffector, Q)
     nt.assert_allclose(ZERO_JACOBIAN, computed_zero_jacobian, atol=self.atol)
+
+  def test_pose_batch(self):
+    computed_poses = self.model.pose_batch(Frame.kEndEffector, [Q, Q, Q])
+    self.assertEqual(computed_poses.shape, (3, 4, 4))
+    nt.assert_allclose(np.stack([POSE] * 3), computed_poses, atol=self.atol)
+
+  def test_body_jacobian_batch(self):
+    computed_body_jacobians = self.model.body_jacobian_batch(
+        Frame.kEndEffector, [Q, Q])
+    self.assertEqual(computed_body_jacobians.shape, (2, 6, 7))
+    nt.assert_allclose(np.stack([BODY_JACOBIAN] * 2),
+                       computed_body_jacobians,
+                       atol=self.atol)
+
+  def test_zero_jacobian_batch(self):
+    computed_zero_jacobians = self.model.zero_jacobian_batch(
+        Frame.kEndEffector, [Q, Q])
+    self.assertEqual(computed_zero_jacobians.shape, (2, 6, 7))
+    nt.assert_allclose(np.stack([ZERO_JACOBIAN] * 2),
+                       computed_zero_jacobians,
+                       atol=self.atol)
+
+  def test_mass_batch(self):
+    computed_mass = self.model.mass_batch([Q, Q])
+    self.assertEqual(computed_mass.shape, (2, 7, 7))
+    nt.assert_allclose(np.stack([MASS] * 2), computed_mass, atol=self.atol)
+
+  def test_coriolis_batch(self):
+    computed_coriolis = self.model.coriolis_batch([Q, Q], np.zeros((2, 7)))
+    self.assertEqual(computed_coriolis.shape, (2, 7))
+    nt.assert_allclose(np.stack([CORIOLIS] * 2),
+                       computed_coriolis,
+                       atol=self.atol)
+
+  def test_gravity_batch(self):
+    computed_gravity = self.model.gravity_batch([Q, Q])
+    self.assertEqual(computed_gravity.shape, (2, 7))
+    nt.assert_allclose(np.stack([GRAVITY] * 2),
+                       computed_gravity,
+                       atol=self.atol)
+
+  def test_batch_shape(self):
+    self.assertRaises(ValueError, self.model.gravity_batch, Q)
+
+  def test_compute_state(self):
+    state = self.model.compute_state(Q, np.zeros(7))
+    nt.assert_allclose(POSE, state.O_T_EE, atol=self.atol)
+    nt.assert_allclose(ZERO_JACOBIAN, state.O_Jac_EE, atol=self.atol)
+    nt.assert_allclose(MASS, state.mass, atol=self.atol)
+    nt.assert_allclose(CORIOLIS, state.coriolis, atol=self.atol)
+    nt.assert_allclose(GRAVITY, state.gravity, atol=self.atol)
+    self.assertIs(state, self.model.compute_state(Q, DQ, state))
+
+  def test_poses(self):
+    computed_poses = self.model.poses(Q)
+    self.assertEqual(computed_poses.shape, (10, 4, 4))
+    nt.assert_allclose(POSE,
+                       computed_poses[Frame.kEndEffector.value],
+                       atol=self.atol)
+    for frame in Frame.__members__.values():
+      nt.assert_allclose(self.model.pose(frame, Q),
+                         computed_poses[frame.value],
+                         atol=1e-9)
+    computed_poses_batch = self.model.poses_batch([Q, Q])
+    self.assertEqual(computed_poses_batch.shape, (2, 10, 4, 4))
+    nt.assert_allclose(np.stack([computed_poses] * 2), computed_poses_batch)
+
+  def test_jacobians(self):
+    computed_body_jacobians = self.model.body_jacobians(Q)
+    computed_zero_jacobians = self.model.zero_jacobians(Q)
+    self.assertEqual(computed_body_jacobians.shape, (10, 6, 7))
+    self.assertEqual(computed_zero_jacobians.shape, (10, 6, 7))
+    for frame in Frame.__members__.values():
+      nt.assert_allclose(self.model.body_jacobian(frame, Q),
+                         computed_body_jacobians[frame.value])
+      nt.assert_allclose(self.model.zero_jacobian(frame, Q),
+                         computed_zero_jacobians[frame.value])
+    nt.assert_allclose(np.stack([computed_body_jacobians] * 2),
+                       self.model.body_jacobians_batch([Q, Q]))
+    nt.assert_allclose(np.stack([computed_zero_jacobians] * 2),
+                       self.model.zero_jacobians_batch([Q, Q]))
+
+  def test_bound_model(self):
+    bound = BoundModel(self.model)
+    nt.assert_allclose(POSE, bound.pose(Frame.kEndEffector, Q), atol=self.atol)
+    nt.assert_allclose(self.model.pose(Frame.kStiffness, Q),
+                       bound.pose(Frame.kStiffness, Q))
+    nt.assert_allclose(ZERO_JACOBIAN,
+                       bound.zero_jacobian(Frame.kEndEffector, Q),
+                       atol=self.atol)
+    nt.assert_allclose(MASS, bound.mass(Q), atol=self.atol)
+    nt.assert_allclose(GRAVITY, bound.gravity(Q), atol=self.atol)
+    bound.set_payload(Defaults.I_TOTAL, 2.0, Defaults.F_X_CTOTAL)
+    nt.assert_allclose(
+        self.model.gravity(Q, 2.0, Defaults.F_X_CTOTAL), bound.gravity(Q))
+
+  def test_model_cache(self):
+    cache = ModelCache(self.model)
+    nt.assert_allclose(MASS, cache.mass(Q), atol=self.atol)
+    nt.assert_allclose(MASS, cache.mass(Q), atol=self.atol)
+    nt.assert_allclose(GRAVITY, cache.gravity(Q), atol=self.atol)
+    statistics = cache.statistics(ModelCache.Query.kMass)
+    self.assertEqual((statistics.hits, statistics.misses), (1, 1))
+    statistics = cache.statistics()
+    self.assertEqual((statistics.hits, statistics.misses), (1, 2))
+    cache.clear()
+    self.assertEqual(cache.statistics().misses, 0)
+
+  def test_inverse_dynamics(self):
+    ddq = np.linspace(-1, 1, 7)
+    expected = self.model.mass(Q) @ ddq + self.model.coriolis(
+        Q, DQ) + self.model.gravity(Q)
+    tau = self.model.inverse_dynamics(Q, DQ, ddq)
+    nt.assert_allclose(expected, tau, atol=1e-9)
+    nt.assert_allclose(tau,
+                       self.model.inverse_dynamics_batch([Q], [DQ], [ddq])[0],
+                       atol=1e-12)
+
+  def test_forward_dynamics(self):
+    tau = np.linspace(5, -5, 7)
+    expected = np.linalg.solve(
+        self.model.mass(Q),
+        tau - self.model.coriolis(Q, DQ) - self.model.gravity(Q))
+    ddq = self.model.forward_dynamics(Q, DQ, tau)
+    nt.assert_allclose(expected, ddq, atol=1e-8)
+    nt.assert_allclose(tau, self.model.inverse_dynamics(Q, DQ, ddq), atol=1e-9)
+    nt.assert_allclose(ddq,
+                       self.model.forward_dynamics_batch([Q], [DQ], [tau])[0],
+                       atol=1e-12)
+
+  def test_jacobian_dot(self):
+    # Validates the native derivative against the library's Jacobians, which
+    # match the native kinematics up to the library's precision.
+    rng = np.random.default_rng(0)
+    q, dq = rng.uniform(-2, 2, (2, 7))
+    step = 1e-6
+    for frame in (Frame.kJoint3, Frame.kFlange, Frame.kEndEffector,
+                  Frame.kStiffness):
+      for jacobian, jacobian_dot in (
+          (self.model.zero_jacobian, self.model.zero_jacobian_dot),
+          (self.model.body_jacobian, self.model.body_jacobian_dot)):
+        expected = (jacobian(frame, q + step * dq) -
+                    jacobian(frame, q - step * dq)) / (2 * step)
+        nt.assert_allclose(expected,
+                           jacobian_dot(frame, q, dq),
+                           atol=self.atol)
+
+  def test_inverse_dynamics_batch(self):
+    ddq = np.linspace(-1, 1, 7)
+    expected = self.model.mass(Q) @ ddq + self.model.coriolis(
+        Q, DQ) + self.model.gravity(Q)
+    tau = self.model.inverse_dynamics_batch([Q, Q], [DQ, DQ], [ddq, ddq])
+    nt.assert_allclose(np.stack([expected] * 2), tau, atol=1e-9)
+    chunks = []
+    self.model.inverse_dynamics_trajectory(
+        [Q, Q, Q], [DQ, DQ, DQ], [ddq, ddq, ddq],
+        lambda offset, chunk: chunks.append(chunk), chunk_size=2)
+    nt.assert_allclose(np.stack([expected] * 3), np.concatenate(chunks),
+                       atol=1e-9)
+
+  def test_coriolis_matrix(self):
+    # Validates the Christoffel symbols against the library's own terms.
+    rng = np.random.default_rng(0)
+    q, dq = rng.uniform(-2, 2, (2, 7))
+    coriolis_matrix = self.model.coriolis_matrix(q, dq)
+    nt.assert_allclose(self.model.coriolis(q, dq),
+                       coriolis_matrix @ dq,
+                       atol=1e-6)
+    step = 1e-6
+    mass_dot = (self.model.mass(q + step * dq) -
+                self.model.mass(q - step * dq)) / (2 * step)
+    skew = mass_dot - 2 * coriolis_matrix
+    nt.assert_allclose(skew, -skew.T, atol=1e-7)
+
+
+class TestNativeModel(unittest.TestCase):
+
+  def setUp(self):
+    self.model = Model.native()
+    self.atol = 3.7e-5
+
+  def test_pose(self):
+    nt.assert_allclose(POSE,
+                       self.model.pose(Frame.kEndEffector, Q),
+                       atol=self.atol)
+
+  def test_body_jacobian(self):
+    nt.assert_allclose(BODY_JACOBIAN,
+                       self.model.body_jacobian(Frame.kEndEffector, Q),
+                       atol=self.atol)
+
+  def test_zero_jacobian(self):
+    nt.assert_allclose(ZERO_JACOBIAN,
+                       self.model.zero_jacobian(Frame.kEndEffector, Q),
+                       atol=self.atol)
+
+  def test_frames(self):
+    poses = self.model.poses(Q)
+    for frame in range(len(poses)):
+      jacobian = self.model.zero_jacobian(Frame(frame), Q)
+      nt.assert_allclose(poses[frame][:3, :3].T @ jacobian[3:],
+                         self.model.body_jacobian(Frame(frame), Q)[3:],
+                         atol=1e-12)
+
+  def test_pose_batch(self):
+    q = np.random.default_rng(0).uniform(-3, 3, (37, 7))
+    self.assertTrue(is_supported(InstructionSet.kScalar))
+    instruction_sets = [
+        instruction_set
+        for instruction_set in InstructionSet.__members__.values()
+        if is_supported(instruction_set)
+    ]
+    for instruction_set in instruction_sets:
+      for frame in Frame.__members__.values():
+        computed_poses = self.model.pose_batch(frame, q,
+                                               instruction_set=instruction_set)
+        for i in range(len(q)):
+          nt.assert_allclose(computed_poses[i],
+                             self.model.pose(frame, q[i]),
+                             atol=1e-12)
+
+  def test_model_batch(self):
+    rng = np.random.default_rng(0)
+    q, dq = rng.uniform(-2, 2, (2, 37, 7))
+    batch = ModelBatch(self.model, num_threads=4, grain_size=3)
+    self.assertEqual(4, batch.num_threads)
+    for frame in (Frame.kJoint4, Frame.kFlange, Frame.kStiffness):
+      poses = batch.pose(frame, q)
+      body_jacobians = batch.body_jacobian(frame, q)
+      zero_jacobians = batch.zero_jacobian(frame, q)
+      for i in range(len(q)):
+        nt.assert_allclose(poses[i], self.model.pose(frame, q[i]), atol=1e-12)
+        nt.assert_allclose(body_jacobians[i],
+                           self.model.body_jacobian(frame, q[i]),
+                           atol=1e-12)
+        nt.assert_allclose(zero_jacobians[i],
+                           self.model.zero_jacobian(frame, q[i]),
+                           atol=1e-12)
+    masses = batch.mass(q)
+    coriolis = batch.coriolis(q, dq)
+    gravity = batch.gravity(q)
+    for i in range(len(q)):
+      nt.assert_allclose(masses[i], self.model.mass(q[i]), atol=1e-12)
+      nt.assert_allclose(coriolis[i],
+                         self.model.coriolis(q[i], dq[i]),
+                         atol=1e-12)
+      nt.assert_allclose(gravity[i], self.model.gravity(q[i]), atol=1e-12)
+
+  def test_thread_pool(self):
+    pool = ThreadPool(4)
+    self.assertEqual(4, pool.size)
+    # The calling thread owns the first chunks. They are slow, so the other
+    # threads run out of work and steal them.
+    counts = np.zeros(1000, dtype=int)
+    first_chunk_threads = set()
+
+    def count(begin, end):
+      if begin < 200:
+        first_chunk_threads.add(threading.get_ident())
+        time.sleep(1e-3)
+      counts[begin:end] += 1
+
+    pool.parallel_for(len(counts), 3, count)
+    nt.assert_array_equal(counts, 1)
+    self.assertGreater(len(first_chunk_threads), 1)
+
+    def fail(begin, end):
+      if begin == 500:
+        raise ValueError('chunk')
+
+    with self.assertRaisesRegex(ValueError, 'chunk'):
+      pool.parallel_for(len(counts), 10, fail)
+    counts[:] = 0
+    pool.parallel_for(len(counts), 7, count)
+    nt.assert_array_equal(counts, 1)
+
+  def test_inverse_dynamics(self):
+    dq = np.linspace(-1, 1, 7)
+    ddq = np.linspace(2, -2, 7)
+    expected = self.model.mass(Q) @ ddq + self.model.coriolis(
+        Q, dq) + self.model.gravity(Q)
+    nt.assert_allclose(expected,
+                       self.model.inverse_dynamics(Q, dq, ddq),
+                       atol=1e-10)
+    nt.assert_allclose(GRAVITY,
+                       self.model.inverse_dynamics(Q, np.zeros(7), np.zeros(7)),
+                       atol=0.2)
+
+  def test_forward_dynamics(self):
+    dq = np.linspace(-1, 1, 7)
+    tau = np.linspace(5, -5, 7)
+    expected = np.linalg.solve(
+        self.model.mass(Q), tau - self.model.coriolis(Q, dq) - self.model.gravity(Q))
+    ddq = self.model.forward_dynamics(Q, dq, tau)
+    nt.assert_allclose(expected, ddq, atol=1e-8)
+    nt.assert_allclose(tau, self.model.inverse_dynamics(Q, dq, ddq), atol=1e-10)
+
+  def test_forward_dynamics_batch(self):
+    rng = np.random.default_rng(0)
+    q, dq, tau = (rng.uniform(-2, 2, (11, 7)) for _ in range(3))
+    computed_ddq = self.model.forward_dynamics_batch(q, dq, tau)
+    for i in range(len(q)):
+      nt.assert_allclose(computed_ddq[i],
+                         self.model.forward_dynamics(q[i], dq[i], tau[i]),
+                         atol=1e-12)
+
+  def test_inverse_dynamics_trajectory(self):
+    rng = np.random.default_rng(0)
+    q, dq, ddq = (rng.uniform(-2, 2, (11, 7)) for _ in range(3))
+    expected_tau = np.array([
+        self.model.inverse_dynamics(q[i], dq[i], ddq[i]) for i in range(len(q))
+    ])
+    nt.assert_allclose(self.model.inverse_dynamics_batch(q, dq, ddq),
+                       expected_tau, atol=1e-12)
+    out = np.empty((11, 7))
+    self.assertIs(self.model.inverse_dynamics_batch(q, dq, ddq, out=out), out)
+    nt.assert_allclose(out, expected_tau, atol=1e-12)
+    with self.assertRaises(ValueError):
+      self.model.inverse_dynamics_batch(q, dq, ddq, out=np.empty((7, 11)).T)
+
+    chunks = []
+    self.model.inverse_dynamics_trajectory(
+        q, dq, ddq, lambda offset, tau: chunks.append((offset, tau)), 4)
+    self.assertEqual([offset for offset, _ in chunks], [0, 4, 8])
+    self.assertEqual(chunks[-1][1].shape, (3, 7))
+    nt.assert_allclose(np.concatenate([tau for _, tau in chunks]),
+                       expected_tau, atol=1e-12)
+
+  def test_rollout(self):
+    rollout = Rollout(self.model, num_threads=2)
+    q0 = np.tile(Q, (3, 1))
+    dq0 = np.zeros((3, 7))
+    tau = np.tile(self.model.gravity(Q), (3, 20, 1))
+    for integrator in (Integrator.kSemiImplicitEuler, Integrator.kRungeKutta4):
+      q, dq = rollout.run(q0, dq0, tau, 1e-3, integrator)
+      self.assertEqual(q.shape, (3, 21, 7))
+      nt.assert_allclose(q, np.broadcast_to(Q, q.shape), atol=1e-10)
+      nt.assert_allclose(dq, 0, atol=1e-10)
+
+    def policy(rollout, step, q, dq):
+      return self.model.gravity(q) - 10 * dq
+
+    q, dq, tau = rollout.run_policy(q0 + 0.1, dq0, policy, 20, 1e-3)
+    expected_q, expected_dq = rollout.run(q0 + 0.1, dq0, tau, 1e-3)
+    nt.assert_allclose(expected_q, q, atol=1e-12)
+    nt.assert_allclose(expected_dq, dq, atol=1e-12)
+
+  def test_jacobian_dot(self):
+    rng = np.random.default_rng(0)
+    q, dq = rng.uniform(-2, 2, (2, 7))
+    step = 1e-6
+    for frame in (Frame.kJoint3, Frame.kFlange, Frame.kStiffness):
+      for jacobian, jacobian_dot in (
+          (self.model.zero_jacobian, self.model.zero_jacobian_dot),
+          (self.model.body_jacobian, self.model.body_jacobian_dot)):
+        expected = (jacobian(frame, q + step * dq) -
+                    jacobian(frame, q - step * dq)) / (2 * step)
+        nt.assert_allclose(expected, jacobian_dot(frame, q, dq), atol=1e-7)
+
+  def test_jacobian_dot_batch(self):
+    rng = np.random.default_rng(0)
+    q, dq = (rng.uniform(-2, 2, (13, 7)) for _ in range(2))
+    for frame in (Frame.kJoint5, Frame.kEndEffector):
+      zero_jacobian_dots = self.model.zero_jacobian_dot_batch(frame, q, dq)
+      body_jacobian_dots = self.model.body_jacobian_dot_batch(frame, q, dq)
+      for i in range(len(q)):
+        nt.assert_allclose(zero_jacobian_dots[i],
+                           self.model.zero_jacobian_dot(frame, q[i], dq[i]),
+                           atol=1e-12)
+        nt.assert_allclose(body_jacobian_dots[i],
+                           self.model.body_jacobian_dot(frame, q[i], dq[i]),
+                           atol=1e-12)
+
+  def test_coriolis_matrix(self):
+    rng = np.random.default_rng(0)
+    q, dq = rng.uniform(-2, 2, (2, 7))
+    coriolis_matrix = self.model.coriolis_matrix(q, dq)
+    nt.assert_allclose(self.model.coriolis(q, dq),
+                       coriolis_matrix @ dq,
+                       atol=1e-12)
+    step = 1e-6
+    mass_dot = (self.model.mass(q + step * dq) -
+                self.model.mass(q - step * dq)) / (2 * step)
+    skew = mass_dot - 2 * coriolis_matrix
+    nt.assert_allclose(skew, -skew.T, atol=1e-7)
+
+  def test_mass_factorization(self):
+    mass = self.model.mass(Q)
+    factorization = self.model.mass_factorization(Q)
+    nt.assert_allclose(mass, factorization.mass(), atol=1e-12)
+    nt.assert_allclose(mass,
+                       factorization.L @ np.diag(factorization.D) @ factorization.L.T,
+                       atol=1e-12)
+    nt.assert_allclose(np.linalg.inv(mass), self.model.inverse_mass(Q), atol=1e-9)
+    rhs = np.linspace(-3, 3, 7)
+    nt.assert_allclose(np.linalg.solve(mass, rhs),
+                       self.model.solve_mass(Q, rhs),
+                       atol=1e-9)
+    nt.assert_allclose(self.model.solve_mass(Q, rhs),
+                       MassFactorization(mass).solve(rhs),
+                       atol=1e-12)
+
+  def test_mass_factorization_batch(self):
+    rng = np.random.default_rng(0)
+    q, rhs = (rng.uniform(-2, 2, (9, 7)) for _ in range(2))
+    inverse_masses = self.model.inverse_mass_batch(q)
+    solutions = self.model.solve_mass_batch(q, rhs)
+    for i in range(len(q)):
+      nt.assert_allclose(inverse_masses[i],
+                         self.model.inverse_mass(q[i]),
+                         atol=1e-12)
+      nt.assert_allclose(solutions[i],
+                         self.model.solve_mass(q[i], rhs[i]),
+                         atol=1e-12)
+
+  def test_mass_factorization_cache(self):
+    cache = ModelCache(self.model)
+    rhs = np.linspace(-3, 3, 7)
+    nt.assert_allclose(self.model.solve_mass(Q, rhs),
+                       cache.solve_mass(Q, rhs),
+                       atol=1e-12)
+    nt.assert_allclose(self.model.solve_mass(Q, 2 * rhs),
+                       cache.solve_mass(Q, 2 * rhs),
+                       atol=1e-12)
+    nt.assert_allclose(self.model.inverse_mass(Q),
+                       cache.inverse_mass(Q),
+                       atol=1e-12)
+    statistics = cache.statistics(ModelCache.Query.kMassFactorization)
+    self.assertEqual((statistics.hits, statistics.misses), (2, 1))
+
+  def test_operational_space(self):
+    dq = np.linspace(-1, 1, 7)
+    for frame in (Frame.kFlange, Frame.kEndEffector):
+      state = self.model.operational_space(frame, Q, dq)
+      inverse_mass = np.linalg.inv(self.model.mass(Q))
+      jacobian = self.model.zero_jacobian(frame, Q)
+      jacobian_dot = self.model.zero_jacobian_dot(frame, Q, dq)
+      Lambda = np.linalg.inv(jacobian @ inverse_mass @ jacobian.T)
+      J_bar = inverse_mass @ jacobian.T @ Lambda
+      nt.assert_allclose(Lambda, state.Lambda, rtol=1e-8, atol=1e-8)
+      nt.assert_allclose(J_bar, state.J_bar, atol=1e-8)
+      nt.assert_allclose(
+          J_bar.T @ self.model.coriolis(Q, dq) - Lambda @ jacobian_dot @ dq,
+          state.mu,
+          atol=1e-8)
+      nt.assert_allclose(J_bar.T @ self.model.gravity(Q), state.p, atol=1e-8)
+      nt.assert_allclose(np.eye(7) - jacobian.T @ J_bar.T, state.N, atol=1e-8)
+      # Null-space torques do not accelerate the frame.
+      nt.assert_allclose(jacobian @ inverse_mass @ state.N, 0, atol=1e-10)
+    self.assertIs(state, self.model.operational_space(frame, Q, dq, state))
+
+  def test_linearization(self):
+    rng = np.random.default_rng(0)
+    q, dq, tau = (rng.uniform(-2, 2, (5, 7)) for _ in range(3))
+    linearization = Linearization(self.model, num_threads=2)
+    A, B = linearization.linearize(q, dq, tau)
+    self.assertEqual((A.shape, B.shape), ((5, 14, 14), (5, 14, 7)))
+    step = 1e-6
+    for i in range(len(q)):
+      nt.assert_allclose(A[i, :7], np.hstack((np.zeros((7, 7)), np.eye(7))))
+      nt.assert_allclose(B[i, :7], 0)
+      nt.assert_allclose(B[i, 7:], self.model.inverse_mass(q[i]), atol=1e-12)
+      for j in range(7):
+        e = np.eye(7)[j] * step
+        expected = (self.model.forward_dynamics(q[i] + e, dq[i], tau[i]) -
+                    self.model.forward_dynamics(q[i] - e, dq[i], tau[i])) / (2 * step)
+        nt.assert_allclose(expected, A[i, 7:, j], atol=1e-4)
+        expected = (self.model.forward_dynamics(q[i], dq[i] + e, tau[i]) -
+                    self.model.forward_dynamics(q[i], dq[i] - e, tau[i])) / (2 * step)
+        nt.assert_allclose(expected, A[i, 7:, 7 + j], atol=1e-4)
+    A_forward, _ = linearization.linearize(q, dq, tau, Difference.kForward)
+    nt.assert_allclose(A, A_forward, atol=1e-2)
+
+  def test_inverse_kinematics(self):
+    rng = np.random.default_rng(0)
+    options = IKOptions()
+    q = rng.uniform(options.q_min + 0.2, options.q_max - 0.2, (6, 7))
+    seeds = q + rng.normal(0, 0.1, q.shape)
+    targets = self.model.pose_batch(Frame.kEndEffector, q)
+    inverse_kinematics = InverseKinematics(self.model, num_threads=2)
+
+    solution = inverse_kinematics.solve(Frame.kEndEffector, targets[0], seeds[0])
+    self.assertEqual(solution.status, IKStatus.kConverged)
+    self.assertGreater(solution.iterations, 0)
+    self.assertLess(solution.position_error, options.position_tolerance)
+    nt.assert_allclose(self.model.pose(Frame.kEndEffector, solution.q),
+                       targets[0],
+                       atol=1e-5)
+
+    computed_q, status, iterations = inverse_kinematics.solve_batch(
+        Frame.kEndEffector, targets, seeds)
+    self.assertEqual(computed_q.shape, (6, 7))
+    nt.assert_array_equal(status, IKStatus.kConverged.value)
+    self.assertTrue(np.all(iterations <= options.max_iterations))
+    nt.assert_allclose(self.model.pose_batch(Frame.kEndEffector, computed_q),
+                       targets,
+                       atol=1e-5)
+
+    # A seed at the solution converges without a step.
+    _, _, iterations = inverse_kinematics.solve_batch(Frame.kEndEffector,
+                                                      targets, q)
+    nt.assert_array_equal(iterations, 0)
+
+    options.max_iterations = 0
+    solution = inverse_kinematics.solve(Frame.kEndEffector, targets[0],
+                                        seeds[0], options)
+    self.assertEqual(solution.status, IKStatus.kMaxIterations)
+    self.assertTrue(np.all(solution.q >= options.q_min))
+
+  def test_ik_seed_index(self):
+    rng = np.random.default_rng(0)
+    options = IKOptions()
+    q = rng.uniform(options.q_min, options.q_max, (500, 7))
+    index = IKSeedIndex.build(self.model, q)
+    self.assertEqual(len(index), 500)
+    self.assertEqual(index.frame, Frame.kEndEffector)
+
+    # Every indexed pose finds its own configuration.
+    targets = self.model.pose_batch(Frame.kEndEffector, q[:10])
+    seeds, distances = index.nearest(targets[0], 3)
+    self.assertEqual((seeds.shape, distances.shape), ((3, 7), (3,)))
+    nt.assert_allclose(seeds[0], q[0], atol=1e-6)
+    self.assertTrue(np.all(np.diff(distances) >= 0))
+    seeds, distances = index.nearest_batch(targets, 2)
+    self.assertEqual(seeds.shape, (10, 2, 7))
+    nt.assert_allclose(seeds[:, 0], q[:10], atol=1e-6)
+    nt.assert_allclose(distances[:, 0], 0, atol=1e-6)
+
+    # No seeds are requested or none are indexed.
+    seeds, distances = index.nearest(targets[0], 0)
+    self.assertEqual((seeds.shape, distances.shape), ((0, 7), (0,)))
+    seeds, distances = index.nearest_batch(targets, 0)
+    self.assertEqual((seeds.shape, distances.shape), ((10, 0, 7), (10, 0)))
+    empty = IKSeedIndex.build(self.model, np.zeros((0, 7)))
+    self.assertEqual(len(empty), 0)
+    self.assertEqual(empty.nearest(targets[0], 3)[0].shape, (0, 7))
+    self.assertEqual(empty.nearest_batch(targets, 3)[0].shape, (10, 0, 7))
+
+    with tempfile.TemporaryDirectory() as directory:
+      path = os.path.join(directory, 'seeds.bin')
+      index.save(path)
+      loaded = IKSeedIndex.load(path)
+      self.assertEqual(len(loaded), len(index))
+      target = self.model.pose(Frame.kEndEffector, q[0] + 0.05)
+      nt.assert_array_equal(loaded.nearest(target, 5)[0],
+                            index.nearest(target, 5)[0])
+      del loaded
+      # The split dimensions are the last section of the file.
+      with open(path, 'r+b') as file:
+        file.seek(-1, os.SEEK_END)
+        file.write(bytes([255]))
+      self.assertRaises(RuntimeError, IKSeedIndex.load, path)
+    self.assertRaises(RuntimeError, IKSeedIndex.load, path)
+
+  def test_self_collision(self):
+    self_collision = SelfCollision(self.model, num_threads=2)
+    self.assertEqual(len(self_collision.capsules), 9)
+    self.assertEqual(self_collision.pairs, SelfCollision.default_pairs())
+    home = np.array([0, -np.pi / 4, 0, -3 * np.pi / 4, 0, np.pi / 2, np.pi / 4])
+    distance, closest, gradient = self_collision.distance(home)
+    self.assertGreater(distance, 0)
+    self.assertLess(closest, len(self_collision.pairs))
+
+    step = 1e-7
+    for j in range(7):
+      e = np.eye(7)[j] * step
+      expected = (self_collision.distance(home + e)[0] -
+                  self_collision.distance(home - e)[0]) / (2 * step)
+      self.assertAlmostEqual(expected, gradient[j], delta=1e-6)
+
+    rng = np.random.default_rng(0)
+    options = IKOptions()
+    q = rng.uniform(options.q_min, options.q_max, (20, 7))
+    distances, closest, gradients = self_collision.distance_batch(
+        q, gradients=True)
+    self.assertEqual(gradients.shape, (20, 7))
+    self.assertIsNone(self_collision.distance_batch(q)[2])
+    for i in range(len(q)):
+      distance, pair, gradient = self_collision.distance(q[i])
+      self.assertAlmostEqual(distance, distances[i])
+      self.assertEqual(pair, closest[i])
+      nt.assert_allclose(gradient, gradients[i])
+
+    # Two spheres at the origins of the base and the flange.
+    spheres = SelfCollision(self.model, [
+        Capsule(Frame.kJoint1, [0, 0, -0.333], [0, 0, -0.333], 0.1),
+        Capsule(Frame.kFlange, np.zeros(3), np.zeros(3), 0.05)
+    ], [(0, 1)])
+    flange = self.model.pose(Frame.kFlange, home)[:3, 3]
+    self.assertAlmostEqual(spheres.distance(home)[0],
+                           np.linalg.norm(flange) - 0.15)
+    with self.assertRaises(ValueError):
+      SelfCollision(self.model, pairs=[(0, 9)])
+
+  def test_reachability_map(self):
+    options = ReachabilityOptions()
+    options.samples = 20000
+    options.resolution = 0.1
+    reachability = ReachabilityMap.generate(self.model, options, num_threads=2)
+    self.assertEqual(reachability.shape, (22, 22, 22))
+    self.assertEqual(len(reachability), 22**3)
+    counts = reachability.counts
+    self.assertEqual(counts.shape, reachability.shape)
+    self.assertEqual(counts.sum(), options.samples)
+    nt.assert_array_equal(
+        ReachabilityMap.generate(self.model, options, num_threads=1).counts,
+        counts)
+    unreachable = counts == 0
+    self.assertTrue(np.all(reachability.mean_manipulability[unreachable] == 0))
+    self.assertTrue(np.all(np.isinf(reachability.min_condition[unreachable])))
+    self.assertIsNone(reachability.index([5, 0, 0]))
+    self.assertEqual(reachability.index(reachability.center(1234)), 1234)
+
+    # Sampling a single joint position fills a single voxel with its statistics.
+    home = np.array([0, -np.pi / 4, 0, -3 * np.pi / 4, 0, np.pi / 2, np.pi / 4])
+    options.q_min = home
+    options.q_max = home
+    options.samples = 10
+    single = ReachabilityMap.generate(self.model, options)
+    index = single.index(self.model.pose(Frame.kEndEffector, home)[:3, 3])
+    self.assertEqual(single.counts.flat[index], 10)
+    singular_values = np.linalg.svd(
+        self.model.zero_jacobian(Frame.kEndEffector, home), compute_uv=False)
+    self.assertAlmostEqual(single.max_manipulability.flat[index],
+                           np.prod(singular_values), places=5)
+    self.assertAlmostEqual(single.mean_manipulability.flat[index],
+                           np.prod(singular_values), places=5)
+    self.assertAlmostEqual(single.min_condition.flat[index],
+                           singular_values[0] / singular_values[-1], places=3)
+
+    with tempfile.TemporaryDirectory() as directory:
+      path = os.path.join(directory, 'reachability.bin')
+      reachability.save(path)
+      loaded = ReachabilityMap.load(path)
+      self.assertEqual(loaded.shape, reachability.shape)
+      self.assertEqual(loaded.samples, reachability.samples)
+      nt.assert_array_equal(loaded.lower, reachability.lower)
+      nt.assert_array_equal(loaded.counts, counts)
+      nt.assert_array_equal(loaded.min_condition, reachability.min_condition)
+    with self.assertRaises(ValueError):
+      options.resolution = 0
+      ReachabilityMap.generate(self.model, options)